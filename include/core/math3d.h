@@ -30,6 +30,11 @@ Matrix4x4 matrix4x4_rotate_z(float angle);
 Vect3 matrix4x4_transform_point(Matrix4x4 m, Vect3 point);
 Vect3 matrix4x4_transform_vector(Matrix4x4 m, Vect3 vector);
 
+// Same matrices as gluPerspective / gluLookAt, en el layout de OpenGL (m[3][0..2] = traslación),
+// así se pueden comparar con glGetFloatv. Vector fila: clip = p * view * projection
+Matrix4x4 matrix4x4_perspective(float fovYDegrees, float aspect, float nearPlane, float farPlane);
+Matrix4x4 matrix4x4_look_at(Vect3 eye, Vect3 target, Vect3 up);
+
 // Camera operations
 typedef struct {
     Vect3 position;
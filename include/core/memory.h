@@ -8,12 +8,19 @@ void* safe_malloc(size_t size);
 void* safe_calloc(size_t count, size_t size);
 void safe_free(void* ptr);
 
-// Memory pool for chunks
+// Fixed-block memory pool (chunks) with an intrusive free list
+// Los bloques libres guardan el puntero al siguiente bloque libre en sus primeros bytes.
 typedef struct {
     void* memory;
-    size_t size;
-    size_t used;
-    size_t block_size;
+    size_t size;           // Bytes reservados (block_count * block_size)
+    size_t used;           // Bytes en bloques vivos
+    size_t block_size;     // Tamaño de bloque alineado a puntero
+    size_t block_count;    // Capacidad en bloques
+    size_t blocks_in_use;  // Ocupación actual
+    size_t high_water;     // Máximo de bloques vivos a la vez
+    size_t carved;         // Bloques entregados alguna vez (el resto nunca se tocó)
+    void* free_list;       // Bloques liberados, O(1) alloc/free
+    BOOL zero_on_free;     // Rellenar con ceros al liberar (debug / datos sensibles)
 } MemoryPool;
 
 MemoryPool* create_memory_pool(size_t total_size, size_t block_size);
@@ -21,6 +28,8 @@ void destroy_memory_pool(MemoryPool* pool);
 void* pool_alloc(MemoryPool* pool);
 void pool_free(MemoryPool* pool, void* ptr);
 void pool_reset(MemoryPool* pool);
+void pool_set_zero_on_free(MemoryPool* pool, BOOL enabled);
+void print_pool_stats(MemoryPool* pool);
 
 // Memory statistics
 typedef struct {
@@ -11,6 +11,8 @@ typedef unsigned int uint32;
 typedef signed char int8;
 typedef signed short int16;
 typedef signed int int32;
+typedef unsigned long long uint64;
+typedef signed long long int64;
 
 // Boolean type
 #ifndef BOOL
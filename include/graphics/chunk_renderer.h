@@ -0,0 +1,80 @@
+#ifndef CHUNK_RENDERER_H
+#define CHUNK_RENDERER_H
+
+#include "world/chunk_system.h"
+#include "world/chunk_mesh.h"
+#include "world/chunk_culling.h"
+#include "world/chunk_occlusion.h"
+#include "graphics/shaders/shaders.h"
+
+// Retained chunk geometry: todos los chunks comparten un VBO y un IBO repartidos con
+// world/chunk_arena.h, reconstruidos solo con needsRemesh. Los chunks se agrupan en regiones
+// de CHUNK_REGION_SIZE^3 y sus vértices se suben ya desplazados dentro de la región, así cada
+// región y capa es una sola llamada (glMultiDrawElementsIndirect, o glMultiDrawElementsBaseVertex
+// sin GL 4.3) y el coste por frame depende de las regiones visibles, no de los chunks.
+// Los vértices van empaquetados (8 bytes) y los desempaqueta el shader de
+// create_lit_chunk_shader_program, que no usa nada del pipeline fijo: matrices, luz y niebla
+// llegan como uniforms (set_chunk_render_view, set_chunk_render_lighting). El meshing corre en world/chunk_mesh_worker.c; aquí solo se
+// suben los resultados.
+
+#define CHUNK_SNAPSHOT_BUDGET_US 500            // Snapshots para los workers por frame
+#define CHUNK_UPLOAD_BUDGET_BYTES (256 * 1024)  // Geometría subida por frame
+
+#define CHUNK_REGION_SHIFT 3                    // Regiones de 8x8x8 chunks (posiciones 0..128 por eje)
+#define CHUNK_REGION_SIZE (1 << CHUNK_REGION_SHIFT)
+#define CHUNK_ARENA_INITIAL_VERTICES (1024 * 1024)  // 8 MB; se dobla al compactar si no cabe
+#define CHUNK_ARENA_INITIAL_INDICES (2 * 1024 * 1024)
+#define CHUNK_ARENA_RETRY_FRAMES 120  // Espera tras una compactación fallida por falta de memoria de GPU
+
+// Counters for the last render_chunk_meshes call
+typedef struct {
+    int drawCalls;         // Llamadas de dibujo a OpenGL (una por región y capa con multi-draw)
+    int chunksRemeshed;
+    int trianglesDrawn;
+    int editsApplied;      // Ediciones de bloques acumuladas desde el frame anterior
+    int chunksEdited;      // Chunks con esas ediciones (antes de sumar vecinos)
+    int meshJobsSubmitted; // Snapshots enviados a los workers este frame
+    int meshJobsInFlight;  // Enviados y aún sin subir
+    int translucentChunks; // Chunks dibujados en la pasada translúcida
+    int translucentResorts;// Capas translúcidas reordenadas (la cámara cambió de celda)
+    int lodChanges;        // Chunks que cambiaron de nivel de detalle este frame
+    int lodChunks[CHUNK_LOD_COUNT]; // Chunks dibujados con cada nivel
+    int chunksTested;      // Chunks generados probados contra el frustum
+    int chunksCulled;      // Fuera del frustum: ni una llamada de dibujo
+    int chunksCaveCulled;  // Dentro del frustum pero tapados (cave culling)
+    int chunksOccluded;    // Detrás de los oclusores cercanos (Z jerárquico)
+    int occluderFaces;     // Caras oclusoras rasterizadas este frame
+    int chunkDraws;        // Dibujos de chunk y capa dentro de esas llamadas
+    int arenaCompactions;  // Desde el inicio: meshes vivos movidos a buffers nuevos
+    size_t uploadedBytes;  // Bytes subidos este frame
+    size_t gpuBytes;       // Total de geometría de chunks en GPU
+    size_t arenaBytes;     // Tamaño del VBO + IBO compartidos
+} ChunkRenderStats;
+
+// Lifetime (requiere contexto OpenGL; render_chunk_meshes inicializa bajo demanda)
+BOOL init_chunk_renderer(ChunkManager* manager);
+void shutdown_chunk_renderer(ChunkManager* manager);
+
+// Rebuild and upload the chunk mesh if it is missing or needsRemesh is set, en el hilo
+// principal (camino sin workers)
+BOOL update_chunk_mesh(VoxelChunk* chunk);
+void release_chunk_mesh(VoxelChunk* chunk);
+
+// Projection used to turn a level's error into pixels (begin_frame la fija cada frame)
+void set_chunk_lod_projection(float fovYDegrees, int viewportHeight);
+
+// Camera matrices (create_view_matrix / create_projection_matrix) and the lighting and fog of
+// the chunk shader; se guardan y se suben en cada render_chunk_meshes
+void set_chunk_render_view(const float view[16], const float projection[16]);
+void set_chunk_render_lighting(ShaderLighting lighting);
+
+// Send pending chunks to the workers, upload finished meshes within the byte budget
+// and draw every chunk with geometry at its level of detail: opaco, recortado (sin culling de caras) y por último
+// translúcido, de atrás hacia delante respecto a cameraPosition. Solo se dibujan los chunks que
+// tocan el frustum (NULL: todos), a los que llega el cave culling y que no quedan detrás de los
+// oclusores; los demás se siguen mallando
+void render_chunk_meshes(ChunkManager* manager, Vect3 cameraPosition, const Frustum* frustum);
+
+const ChunkRenderStats* get_chunk_render_stats(void);
+
+#endif // CHUNK_RENDERER_H
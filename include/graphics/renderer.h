@@ -193,6 +193,7 @@ Player* get_player();
 RenderLight* get_render_lights();
 int get_render_light_count();
 RenderFog* get_render_fog();
+const struct Frustum* get_view_frustum();  // Set by begin_frame
 VolumetricSystem* get_volumetric_system();
 AdvancedShadowSystem* get_shadow_system();
 
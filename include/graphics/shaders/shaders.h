@@ -73,6 +73,7 @@ BOOL link_shader_program(ShaderProgram* program);
 
 // Shader creation functions
 ShaderProgram create_lit_shader_program();
+ShaderProgram create_lit_chunk_shader_program();  // Vértices empaquetados de chunk (ChunkVertex)
 ShaderProgram create_fog_shader_program();
 
 // Shader uniform functions
@@ -0,0 +1,44 @@
+#ifndef CHUNK_ARENA_H
+#define CHUNK_ARENA_H
+
+#include "core/types.h"
+
+// ============================================================================
+// CHUNK ARENA - reparto de un buffer grande entre los meshes de los chunks
+// ============================================================================
+// Solo lleva la cuenta de los huecos (sin OpenGL): graphics/chunk_renderer.c tiene un
+// VBO y un IBO para todos los chunks y pide aquí rangos de vértices e índices. Los huecos
+// libres van ordenados por offset y se fusionan con los vecinos al liberar; cuando ningún
+// hueco basta el renderer compacta los meshes vivos al principio de un buffer nuevo
+// (del mismo tamaño o del doble) y llama a chunk_arena_reset.
+
+typedef struct {
+    uint32 offset;
+    uint32 size;
+} ChunkArenaRange;
+
+typedef struct {
+    uint32 capacity;              // Unidades (vértices o índices) del buffer
+    uint32 used;                  // En rangos entregados, más huecos perdidos sin memoria hasta el reset
+    ChunkArenaRange* freeRanges;  // Por offset, nunca dos seguidos sin hueco entre ellos
+    int freeCount;
+    int freeCapacity;
+} ChunkArena;
+
+BOOL chunk_arena_init(ChunkArena* arena, uint32 capacity);
+void chunk_arena_free(ChunkArena* arena);
+
+// Best fit: el hueco más pequeño en el que cabe size. FALSE si ninguno basta (size > 0).
+BOOL chunk_arena_alloc(ChunkArena* arena, uint32 size, uint32* offset);
+void chunk_arena_release(ChunkArena* arena, uint32 offset, uint32 size);
+
+uint32 chunk_arena_largest_free(const ChunkArena* arena);
+
+// After compacting: [0, used) ocupado y el resto libre, con la capacidad del buffer nuevo
+BOOL chunk_arena_reset(ChunkArena* arena, uint32 capacity, uint32 used);
+
+// Headless self-check: altas y bajas aleatorias frente a un mapa de ocupación, huecos
+// fusionados al vaciarla y compactación cuando un mesh ya no cabe
+BOOL verify_chunk_arena(void);
+
+#endif // CHUNK_ARENA_H
@@ -0,0 +1,93 @@
+#ifndef CHUNK_CULLING_H
+#define CHUNK_CULLING_H
+
+#include "core/types.h"
+#include "core/math3d.h"
+#include "world/chunk_system.h"
+
+// ============================================================================
+// CHUNK CULLING - frustum de la cámara contra las cajas de los chunks
+// ============================================================================
+// Los seis planos salen de la matriz vista-proyección con la normal hacia dentro. Las cajas
+// de los chunks se empaquetan en arrays separados de x, y, z mínimos: todas miden lo mismo,
+// así que la esquina más adentrada de cada plano es un desplazamiento fijo por plano y la
+// prueba de una caja queda en un producto escalar (cuatro chunks por instrucción con SSE).
+
+typedef struct {
+    float x, y, z, w;  // Dentro si x * px + y * py + z * pz + w >= 0
+} FrustumPlane;
+
+typedef struct Frustum {
+    FrustumPlane planes[6];  // Izquierda, derecha, abajo, arriba, cerca, lejos
+    Matrix4x4 viewProjection;  // Matriz de la que salen (world/chunk_occlusion.c proyecta con ella)
+} Frustum;
+
+typedef struct {
+    int tested;   // Chunks generados probados
+    int visible;  // Dentro o tocando el frustum
+} ChunkCullStats;
+
+// Planes of clip = p * viewProjection (vector fila, layout de OpenGL), normalizados
+void frustum_from_view_projection(Frustum* frustum, Matrix4x4 viewProjection);
+
+// Same frustum as gluPerspective + gluLookAt with these values
+void frustum_from_camera(Frustum* frustum, Vect3 position, Vect3 target, Vect3 up,
+                         float fovYDegrees, float aspect, float nearPlane, float farPlane);
+
+// Reference test for one box (esquina positiva por plano)
+BOOL frustum_intersects_box(const Frustum* frustum, Vect3 boxMin, Vect3 boxMax);
+
+// Culling kernel over packed cubes of side size: visible[i] = 1 si el cubo con esquina
+// mínima (minX[i], minY[i], minZ[i]) toca el frustum. Devuelve cuántos son visibles.
+int cull_boxes_in_frustum(const Frustum* frustum, const float* minX, const float* minY, const float* minZ,
+                          int count, float size, uint8* visible);
+
+// Pack every generated chunk's bounds, run the kernel and write chunk->isVisible
+// (frustum NULL: todos visibles). Los arrays se conservan entre frames.
+ChunkCullStats update_chunk_frustum_visibility(ChunkManager* manager, const Frustum* frustum);
+void free_chunk_cull_bounds(void);
+
+// ============================================================================
+// CAVE CULLING - grafo de conectividad entre caras de cada chunk
+// ============================================================================
+// Un flood fill por el aire y los bloques no opacos del chunk dice qué pares de sus seis
+// caras (orden BLOCK_FACE_*: +X, -X, +Y, -Y, +Z, -Z) se ven entre sí: 15 bits. Desde el chunk
+// de la cámara una búsqueda en anchura cruza al vecino solo si la cara de entrada y la de
+// salida están unidas, el vecino toca el frustum y la dirección no vuelve hacia la cámara.
+// Los chunks visibles a los que no llega se descartan (cuevas bajo el suelo, por ejemplo).
+
+#define CHUNK_CONNECTIVITY_ALL 0x7FFF  // Sin calcular todavía, o todo aire: cualquier par
+
+// Bit of the unordered face pair (a != b)
+static inline int chunk_face_pair_bit(int a, int b) {
+    if (a > b) { int t = a; a = b; b = t; }
+    return a * (11 - a) / 2 + b - a - 1;
+}
+
+static inline BOOL chunk_faces_connected(uint16 connectivity, int a, int b) {
+    return (connectivity >> chunk_face_pair_bit(a, b)) & 1;
+}
+
+// Flood fill over the open cells (bit z de la columna (x, y) a 0 en opaqueMask)
+uint16 compute_chunk_connectivity(const uint16 opaqueMask[CHUNK_SIZE][CHUNK_SIZE]);
+
+// Recompute chunk->faceConnectivity from its current blocks (al mallar y al editar)
+void update_chunk_connectivity(VoxelChunk* chunk);
+
+// BFS from the camera's chunk over the chunks left visible by the frustum; los que no
+// alcanza pasan a isVisible = FALSE. Devuelve cuántos se descartan (0 si la cámara no
+// está en un chunk cargado: sin punto de partida no se descarta nada).
+int update_chunk_cave_visibility(ChunkManager* manager, Vect3 cameraPosition);
+
+// Headless self-check: conectividad de túneles conocidos, cueva bajo un suelo macizo
+// descartada y visible en cuanto se abre un pozo
+BOOL verify_cave_culling(void);
+
+// Headless self-check: planos frente a la proyección, kernel frente a la prueba de referencia
+// y chunks detrás de la cámara descartados
+BOOL verify_frustum_culling(void);
+
+// Kernel cost over a grid of chunkCount chunks: por chunk, empaquetado escalar y SSE
+void benchmark_frustum_culling(int chunkCount, int iterations);
+
+#endif // CHUNK_CULLING_H
@@ -0,0 +1,182 @@
+#ifndef CHUNK_MESH_H
+#define CHUNK_MESH_H
+
+#include "core/types.h"
+#include "world/chunk_system.h"
+
+// ============================================================================
+// CHUNK MESH - geometría de un chunk construida en CPU una vez por remesh
+// ============================================================================
+// El mesher no toca OpenGL: produce vértices e índices que graphics/chunk_renderer.c
+// sube a la arena compartida. Las posiciones son esquinas locales al chunk (0..16); el bloque
+// (x, y, z) ocupa [x, x+1] y se dibuja trasladando el chunk a su origen - 0.5 (el renderer
+// suma al subirlas la posición del chunk dentro de su región).
+
+// Packed vertex, 8 bytes: dos uint32. Cada campo de 8 bits ocupa un byte (little-endian),
+// así el shader (GLSL 1.20, sin enteros) recibe cada palabra como un vec4 de bytes.
+//   position: x bits 0-7, y 8-15, z 16-23 (esquinas 0..16), cara bits 24-26, AO bits 27-28
+//   material: id de bloque bits 0-7, tono bits 8-15 (variación de gris, 127 = media), resto libre
+typedef struct {
+    uint32 position;
+    uint32 material;
+} ChunkVertex;
+
+#define CHUNK_VERTEX_FACE_SHIFT 24
+#define CHUNK_VERTEX_AO_SHIFT 27
+#define CHUNK_VERTEX_AO_NONE 3     // Esquina sin oclusión
+#define CHUNK_VERTEX_TINT_MEAN 127 // Tono de los quads fusionados
+#define CHUNK_AO_NONE 0xFF         // AO de un quad: 2 bits por esquina, las cuatro a 3
+
+static inline uint32 chunk_vertex_pack_position(int x, int y, int z, int face, int ao) {
+    return (uint32)x | ((uint32)y << 8) | ((uint32)z << 16) |
+           ((uint32)face << CHUNK_VERTEX_FACE_SHIFT) | ((uint32)ao << CHUNK_VERTEX_AO_SHIFT);
+}
+
+static inline uint32 chunk_vertex_pack_material(int blockId, int tint) {
+    return (uint32)blockId | ((uint32)tint << 8);
+}
+
+static inline int chunk_vertex_x(const ChunkVertex* v) { return (int)(v->position & 0xFF); }
+static inline int chunk_vertex_y(const ChunkVertex* v) { return (int)((v->position >> 8) & 0xFF); }
+static inline int chunk_vertex_z(const ChunkVertex* v) { return (int)((v->position >> 16) & 0xFF); }
+static inline int chunk_vertex_face(const ChunkVertex* v) { return (int)((v->position >> CHUNK_VERTEX_FACE_SHIFT) & 7); }
+static inline int chunk_vertex_ao(const ChunkVertex* v) { return (int)((v->position >> CHUNK_VERTEX_AO_SHIFT) & 3); }
+static inline int chunk_vertex_block(const ChunkVertex* v) { return (int)(v->material & 0xFF); }
+static inline int chunk_vertex_tint(const ChunkVertex* v) { return (int)((v->material >> 8) & 0xFF); }
+
+typedef struct {
+    ChunkVertex* vertices;
+    uint16* indices;       // Dos triángulos por quad (0,1,2 / 0,2,3), mismo winding que las caras antiguas
+    int vertexCount;
+    int indexCount;
+    int vertexCapacity;
+    int indexCapacity;
+    int layerIndexCount[CHUNK_LAYER_COUNT];  // Índices agrupados por capa: opaco, recortado, translúcido
+    uint8 lodLevel;                          // Nivel de detalle con el que se construyó
+} ChunkMesh;
+
+// Peor caso: tablero de ajedrez 3D, 2048 bloques con sus 6 caras
+#define CHUNK_MESH_MAX_QUADS (CHUNK_VOLUME / 2 * 6)
+
+// Level of detail: el nivel l malla una rejilla de celdas de 2^l bloques. Una celda está
+// ocupada si lo está al menos la mitad de sus bloques, y es opaca si al menos la mitad son
+// opacos (así el vecino puede calcular su borde solo con las máscaras de columna); su tipo
+// es el más frecuente de esa clase. Las esquinas siguen siendo múltiplos de bloque.
+#define CHUNK_LOD_COUNT 3                      // 1x, 2x y 4x
+#define CHUNK_LOD_BORDER_CELLS (CHUNK_SIZE / 2) // Celdas por eje del nivel 1, el más fino con borde
+#define CHUNK_LOD_MAX_ERROR_PIXELS 4.0f        // Error en pantalla tolerado al elegir nivel
+#define CHUNK_LOD_HYSTERESIS 1.25f             // Se vuelve al nivel fino solo con este margen
+#define CHUNK_LOD_CELL_OCCUPIED 1
+#define CHUNK_LOD_CELL_OPAQUE 2
+
+// Everything a mesher reads, copied once per remesh: los bloques del chunk y sus columnas
+// de ocupación con un borde de 1 voxel tomado de los vecinos enlazados (aire si no están
+// cargados), así las caras del borde se ocultan igual que las interiores y el mesher no
+// vuelve a tocar ningún chunk. El borde se guarda como bits: 18x18 columnas de 18 bits.
+#define CHUNK_PADDED_SIZE (CHUNK_SIZE + 2)
+
+typedef struct {
+    int chunkX, chunkY, chunkZ;
+    int colorSeed;
+    uint8 meshMode;
+    BOOL bakeAo;                        // AO por vértice (set_chunk_mesh_ao)
+    BOOL isEmpty;
+    int typeCount;                      // Tipos no aire de la paleta
+    uint8 types[CHUNK_PALETTE_MAX];
+    uint8 blocks[CHUNK_SIZE][CHUNK_SIZE][CHUNK_SIZE];          // [x][y][z]
+    uint32 occupiedCols[CHUNK_PADDED_SIZE][CHUNK_PADDED_SIZE];  // [x+1][y+1], bit z+1
+    uint32 opaqueCols[CHUNK_PADDED_SIZE][CHUNK_PADDED_SIZE];
+    uint8 blockLayers[CHUNK_PALETTE_MAX];                      // ChunkRenderLayer por id de bloque presente
+    BOOL hasTranslucent;
+    uint16 translucentCols[CHUNK_SIZE][CHUNK_SIZE];            // Bit z: bloque translúcido (solo si hasTranslucent)
+    uint8 lodLevel;                                            // 0: resolución completa
+    // Celdas del vecino de cada cara, [cara][u][v] en los ejes de k_face_axes (CHUNK_LOD_CELL_*).
+    // Un vecino a otro nivel cuenta como aire: cada lado cierra la costura con su pared.
+    uint8 lodBorder[6][CHUNK_LOD_BORDER_CELLS][CHUNK_LOD_BORDER_CELLS];
+} ChunkMeshSnapshot;
+
+// Translucent quad kept on the CPU so the layer can be re-sorted without remeshing
+typedef struct ChunkTranslucentQuad {
+    uint16 indices[6];   // Los dos triángulos tal cual salieron del mesher (con su quad flip)
+    int16 center[3];     // Centro en medias unidades locales (0..32)
+    uint32 sortKey;      // Distancia al cuadrado a la cámara del último orden
+} ChunkTranslucentQuad;
+
+// Lifetime (la memoria se conserva entre builds para reutilizar el mismo mesh)
+void chunk_mesh_init(ChunkMesh* mesh);
+void chunk_mesh_free(ChunkMesh* mesh);
+void chunk_mesh_clear(ChunkMesh* mesh);
+
+// Build with the chunk's mesher (chunk->meshMode). FALSE si falta memoria.
+BOOL build_chunk_mesh(VoxelChunk* chunk, ChunkMesh* mesh);
+
+// Copy the chunk's blocks and its padded occupancy columns
+BOOL take_chunk_mesh_snapshot(VoxelChunk* chunk, ChunkMeshSnapshot* snapshot);
+
+// Build with the snapshot's mesher; no lee ningún chunk
+BOOL build_chunk_mesh_from_snapshot(const ChunkMeshSnapshot* snapshot, ChunkMesh* mesh);
+
+// Naive: one quad per visible face (see calculate_block_faces), tono por bloque
+BOOL build_chunk_mesh_naive(VoxelChunk* chunk, ChunkMesh* mesh);
+
+// Greedy: caras coplanares del mismo tipo fusionadas en rectángulos máximos,
+// con el tono medio (la variación por bloque se pierde)
+BOOL build_chunk_mesh_greedy(VoxelChunk* chunk, ChunkMesh* mesh);
+
+// Binary: caras visibles por eje con desplazamientos y AND sobre las columnas de
+// ocupación, luego fusión greedy sobre las máscaras de bits (sin ramas por voxel)
+BOOL build_chunk_mesh_binary(VoxelChunk* chunk, ChunkMesh* mesh);
+
+void set_chunk_mesh_mode(VoxelChunk* chunk, ChunkMeshMode mode);
+
+// Baked ambient occlusion: AO de 3 vecinos por vértice, calculado con las columnas opacas.
+// Las caras con oclusión no se fusionan (cada una lleva su AO). Activado por defecto.
+void set_chunk_mesh_ao(BOOL enabled);
+
+// Screen-space error selection: pixelsPerUnit = alto del viewport / (2 tan(fov / 2)).
+// El nivel baja a más detalle solo cuando el error supera el umbral por CHUNK_LOD_HYSTERESIS.
+int select_chunk_lod(float distance, float pixelsPerUnit, int currentLod);
+
+// Change the chunk's level; él y sus vecinos de cara se remallan (cambia la costura)
+void set_chunk_lod(VoxelChunk* chunk, int lod);
+
+// Copy the mesh's translucent quads (quads debe tener sitio para layerIndexCount[TRANSLUCENT] / 6)
+int extract_translucent_quads(const ChunkMesh* mesh, ChunkTranslucentQuad* quads);
+
+// Back-to-front order seen from eye (medias unidades locales del chunk): escribe 6 índices
+// por quad, el más lejano primero
+void sort_translucent_quads(ChunkTranslucentQuad* quads, int count, const int eye[3], uint16* indices);
+
+static inline int chunk_mesh_quad_count(const ChunkMesh* mesh) {
+    return mesh->indexCount / 6;
+}
+
+static inline int chunk_mesh_triangle_count(const ChunkMesh* mesh) {
+    return mesh->indexCount / 3;
+}
+
+// Headless self-check: builds known chunks and compares vertex/index counts
+BOOL verify_chunk_mesh_builder(void);
+
+// Headless self-check: campo plano de varios chunks, sin caras entre chunks vecinos
+// y con remesh de los bordes al cargar o editar un vecino
+BOOL verify_cross_chunk_culling(void);
+
+// Headless self-check: caras por capa (opaco / recortado / translúcido), culling entre
+// translúcidos y orden de atrás hacia delante
+BOOL verify_chunk_mesh_layers(void);
+
+// Headless self-check: mallas 2x/4x con la misma superficie, sin huecos en la costura
+// entre niveles distintos y selección por error en pantalla con histéresis
+BOOL verify_chunk_lod(void);
+
+// Triangles of the loaded chunks at every level of detail
+void report_chunk_lod_counts(ChunkManager* manager);
+
+// Triangle counts and build time of every mesher over the loaded chunks
+void report_chunk_mesh_counts(ChunkManager* manager);
+
+// VRAM / upload bytes of the loaded chunks' meshes: vértice empaquetado frente a formatos anchos
+void report_chunk_vertex_memory(ChunkManager* manager);
+
+#endif // CHUNK_MESH_H
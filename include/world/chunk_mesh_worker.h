@@ -0,0 +1,51 @@
+#ifndef CHUNK_MESH_WORKER_H
+#define CHUNK_MESH_WORKER_H
+
+#include "core/types.h"
+#include "world/chunk_system.h"
+#include "world/chunk_mesh.h"
+
+// ============================================================================
+// CHUNK MESH WORKERS - meshing en hilos, subida a GPU en el hilo principal
+// ============================================================================
+// El hilo principal copia el chunk a un ChunkMeshSnapshot (los bloques solo cambian en
+// ese hilo) y lo deja en la cola de trabajos. Los workers construyen el mesh sin tocar
+// ningún chunk y lo pasan a la cola de terminados, que el renderer vacía con un
+// presupuesto de bytes por frame. Los trabajos y sus meshes se reutilizan.
+
+#define CHUNK_MESH_JOB_COUNT 32      // Trabajos en vuelo como máximo (snapshot + mesh cada uno)
+#define CHUNK_MESH_MAX_WORKERS 4
+
+typedef struct ChunkMeshJob {
+    int chunkX, chunkY, chunkZ;  // El chunk se busca de nuevo al terminar: puede haberse descargado
+    uint32 revision;             // chunk->meshRevision al enviarlo; si cambió, el resultado se descarta
+    BOOL built;                  // FALSE si el mesher se quedó sin memoria
+    ChunkMeshSnapshot snapshot;
+    ChunkMesh mesh;
+    struct ChunkMeshJob* next;
+} ChunkMeshJob;
+
+// Lifetime. threadCount <= 0: núcleos - 1 (al menos 1, como mucho CHUNK_MESH_MAX_WORKERS).
+// Al parar, los chunks de manager con trabajos sin recoger vuelven a needsRemesh
+BOOL init_chunk_mesh_workers(int threadCount);
+void shutdown_chunk_mesh_workers(ChunkManager* manager);
+BOOL chunk_mesh_workers_running(void);
+
+// Snapshot the chunk on the calling (main) thread and queue it. Sube chunk->meshRevision y
+// limpia needsRemesh. FALSE si no quedan trabajos libres (se reintenta el siguiente frame).
+BOOL submit_chunk_mesh_job(VoxelChunk* chunk);
+
+// Next finished job, or NULL. Devolverlo con release_chunk_mesh_job tras subirlo.
+ChunkMeshJob* poll_chunk_mesh_job(void);
+void release_chunk_mesh_job(ChunkMeshJob* job);
+
+// Finished job still current for its chunk (cargado y sin un envío más reciente)
+VoxelChunk* find_chunk_mesh_job_target(ChunkManager* manager, const ChunkMeshJob* job);
+
+int get_chunk_mesh_jobs_in_flight(void);
+
+// Headless self-check: todos los chunks cargados se mallan en los workers, con el mismo
+// resultado que el build síncrono; informa del coste por frame del hilo principal
+BOOL verify_chunk_mesh_workers(ChunkManager* manager);
+
+#endif // CHUNK_MESH_WORKER_H
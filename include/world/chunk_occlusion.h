@@ -0,0 +1,62 @@
+#ifndef CHUNK_OCCLUSION_H
+#define CHUNK_OCCLUSION_H
+
+#include "core/types.h"
+#include "core/math3d.h"
+#include "world/chunk_system.h"
+#include "world/chunk_culling.h"
+
+// ============================================================================
+// CHUNK OCCLUSION - Z jerárquico rasterizado en CPU
+// ============================================================================
+// Each frame the nearby chunks' solid interiors are rasterized into a small depth buffer
+// (sin GPU, así funciona y se prueba sin contexto OpenGL). Los oclusores son cajas de celdas
+// de 4x4x4 bloques opacos, más pequeñas que la geometría real; los píxeles solo se escriben
+// si la cara los cubre por completo y con la profundidad más lejana del píxel. La
+// pirámide guarda el máximo de cada bloque de texels, así un chunk se descarta solo si su
+// punto más cercano queda detrás de todo lo que cubre su rectángulo en pantalla.
+
+#define CHUNK_OCCLUSION_WIDTH 128
+#define CHUNK_OCCLUSION_HEIGHT 64
+#define CHUNK_OCCLUSION_LEVELS 8          // 128x64 hasta 1x1
+#define CHUNK_OCCLUDER_CELL 4             // Lado en bloques de una celda oclusora
+#define CHUNK_OCCLUDER_DISTANCE 64.0f     // Solo los chunks cercanos rasterizan oclusores
+#define CHUNK_FLYTHROUGH_MAX_FRAMES 1800  // 30 segundos a 60 FPS
+
+typedef struct {
+    int occluderBoxes;      // Cajas rasterizadas
+    int occluderFaces;      // Caras delante del plano cercano
+    int tested;             // Chunks visibles probados contra la pirámide
+    int occluded;           // Descartados
+} ChunkOcclusionStats;
+
+// Software occluder path: vaciar, rasterizar cajas y construir la pirámide antes de probar
+void begin_occlusion_buffer(Matrix4x4 viewProjection);
+int rasterize_occluder_box(Vect3 boxMin, Vect3 boxMax, Vect3 cameraPosition);  // Caras dibujadas
+void build_occlusion_pyramid(void);
+BOOL is_box_occluded(Vect3 boxMin, Vect3 boxMax);
+
+// Occluders from the nearby visible chunks, then every visible chunk tested against the
+// pirámide (isVisible = FALSE si queda tapado). Sin frustum no se hace nada.
+ChunkOcclusionStats update_chunk_occlusion(ChunkManager* manager, Vect3 cameraPosition, const Frustum* frustum);
+
+// Camera path recorder (anillo con los últimos CHUNK_FLYTHROUGH_MAX_FRAMES frames)
+typedef struct {
+    Vect3 position;
+    Vect3 target;
+    Vect3 up;
+} ChunkCameraFrame;
+
+void record_camera_frame(Vect3 position, Vect3 target, Vect3 up);
+int get_recorded_camera_frames(ChunkCameraFrame* frames, int maxFrames);  // El más antiguo primero
+
+// Replay a camera path over the manager's chunks: chunks y triángulos dibujados con frustum,
+// con cave culling y con oclusión, y lo que ahorra cada paso
+void report_occlusion_flythrough(ChunkManager* manager, const ChunkCameraFrame* frames, int frameCount,
+                                 float fovYDegrees, float aspect);
+
+// Headless self-check: muro delante de cajas, suelo que cruza el plano cercano, ninguna caja
+// descartada que un rayo pueda ver, y vuelo grabado sobre colinas con bosque
+BOOL verify_chunk_occlusion(void);
+
+#endif // CHUNK_OCCLUSION_H
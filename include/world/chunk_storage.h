@@ -0,0 +1,134 @@
+#ifndef CHUNK_STORAGE_H
+#define CHUNK_STORAGE_H
+
+#include "core/types.h"
+#include "core/memory.h"
+
+// Chunk dimensions
+#define CHUNK_SIZE 16
+#define CHUNK_VOLUME (CHUNK_SIZE * CHUNK_SIZE * CHUNK_SIZE)
+
+// Palette limits - los índices empaquetados usan 1, 2, 4 u 8 bits
+#define CHUNK_PALETTE_MAX 256
+#define CHUNK_STORAGE_MAX_BITS 8
+
+// ============================================================================
+// VOXEL LAYOUT - orden de los voxels dentro de la storage del chunk
+// ============================================================================
+// Por defecto lineal, el mismo orden que el antiguo blocks[x][y][z]. Compilando con
+// -DCHUNK_LAYOUT_MORTON se usa orden Z (Morton): bloques de 2x2x2, 4x4x4... quedan
+// contiguos, así un vecindario 3x3x3 cae en menos líneas de caché. Todo acceso pasa por
+// chunk_block_index / chunk_block_neighbor_index, nunca por aritmética propia.
+
+#define CHUNK_LAYOUT_LINEAR 0
+#define CHUNK_LAYOUT_MORTON_ORDER 1
+
+// Linear index: x -> bits 8-11, y -> bits 4-7, z -> bits 0-3
+static inline int chunk_linear_index(int x, int y, int z) {
+    return (x << 8) | (y << 4) | z;
+}
+
+// Morton index: los 4 bits de cada coordenada intercalados (x -> bits 2,5,8,11,
+// y -> 1,4,7,10, z -> 0,3,6,9)
+static const uint16 k_chunk_morton_spread[16] = {
+    0x000, 0x001, 0x008, 0x009, 0x040, 0x041, 0x048, 0x049,
+    0x200, 0x201, 0x208, 0x209, 0x240, 0x241, 0x248, 0x249
+};
+
+static inline int chunk_morton_index(int x, int y, int z) {
+    return (k_chunk_morton_spread[x] << 2) | (k_chunk_morton_spread[y] << 1) | k_chunk_morton_spread[z];
+}
+
+#ifdef CHUNK_LAYOUT_MORTON
+#define CHUNK_LAYOUT CHUNK_LAYOUT_MORTON_ORDER
+#define CHUNK_INDEX_MASK_X 0x924
+#define CHUNK_INDEX_MASK_Y 0x492
+#define CHUNK_INDEX_MASK_Z 0x249
+#else
+#define CHUNK_LAYOUT CHUNK_LAYOUT_LINEAR
+#define CHUNK_INDEX_MASK_X 0xF00
+#define CHUNK_INDEX_MASK_Y 0x0F0
+#define CHUNK_INDEX_MASK_Z 0x00F
+#endif
+
+// Voxel index inside a chunk for the compiled layout
+static inline int chunk_block_index(int x, int y, int z) {
+#ifdef CHUNK_LAYOUT_MORTON
+    return chunk_morton_index(x, y, z);
+#else
+    return chunk_linear_index(x, y, z);
+#endif
+}
+
+// Neighbour offset tables, one entry per face in BLOCK_FACE_* bit order
+// (+X, -X, +Y, -Y, +Z, -Z)
+#define CHUNK_FACE_COUNT 6
+
+static const int8 k_chunk_face_offsets[CHUNK_FACE_COUNT][3] = {
+    { 1, 0, 0}, {-1, 0, 0}, {0,  1, 0}, {0, -1, 0}, {0, 0,  1}, {0, 0, -1}
+};
+
+static const uint16 k_chunk_face_axis_mask[CHUNK_FACE_COUNT] = {
+    CHUNK_INDEX_MASK_X, CHUNK_INDEX_MASK_X, CHUNK_INDEX_MASK_Y,
+    CHUNK_INDEX_MASK_Y, CHUNK_INDEX_MASK_Z, CHUNK_INDEX_MASK_Z
+};
+
+// Index of the neighbour across a face without decoding x, y, z: suma/resta solo
+// dentro de los bits de un eje (en lineal equivale a +-256, +-16, +-1). El llamador
+// garantiza que el vecino está dentro del chunk.
+static inline int chunk_index_step(int index, int axisMask, BOOL negative) {
+    int axis = negative ? ((index & axisMask) - 1) : ((index | ~axisMask) + 1);
+    return (axis & axisMask) | (index & ~axisMask);
+}
+
+static inline int chunk_block_neighbor_index(int index, int face) {
+    return chunk_index_step(index, k_chunk_face_axis_mask[face], face & 1);
+}
+
+// Palette-compressed block storage
+// Cada voxel guarda un índice a la paleta; la paleta guarda el id de bloque real.
+// Los índices nunca cruzan palabras de 32 bits porque bitsPerIndex divide 32.
+// Un chunk uniforme (todo aire, todo piedra...) no tiene datos: bitsPerIndex = 0,
+// data = NULL y palette[0] es el bloque de todos los voxels.
+typedef struct {
+    uint8 bitsPerIndex;               // 0 (uniforme), 1, 2, 4 u 8
+    uint16 paletteCount;              // Entradas usadas de la paleta
+    uint8 palette[CHUNK_PALETTE_MAX]; // Palette index -> block id
+    uint32* data;                     // CHUNK_VOLUME índices empaquetados, NULL si es uniforme
+} ChunkBlockStorage;
+
+// Lifetime
+BOOL chunk_storage_init(ChunkBlockStorage* storage, uint8 fillBlock);
+void chunk_storage_free(ChunkBlockStorage* storage);
+
+// Single block id for every voxel, promoted to packed storage on the first differing set
+static inline BOOL chunk_storage_is_uniform(const ChunkBlockStorage* storage) {
+    return storage->data == NULL;
+}
+
+// Block access by linear index (see chunk_block_index)
+uint8 chunk_storage_get(const ChunkBlockStorage* storage, int index);
+BOOL chunk_storage_set(ChunkBlockStorage* storage, int index, uint8 block);
+
+// Every block id in index order (CHUNK_VOLUME bytes), decoded word by word
+void chunk_storage_get_all(const ChunkBlockStorage* storage, uint8* blocks);
+
+// Lazy repack: drop unused palette entries and shrink the bit width
+void chunk_storage_compact(ChunkBlockStorage* storage);
+size_t chunk_storage_memory_usage(const ChunkBlockStorage* storage);
+
+// Compact encoding for save files and network
+size_t chunk_storage_encoded_size(const ChunkBlockStorage* storage);
+size_t chunk_storage_encode(ChunkBlockStorage* storage, uint8* out, size_t capacity);
+BOOL chunk_storage_decode(ChunkBlockStorage* storage, const uint8* in, size_t size);
+
+// Self-check: ediciones, codificación y compactación frente a un array plano
+BOOL verify_chunk_storage(void);
+
+// Benchmark against a flat blocks[x][y][z] byte array
+void benchmark_chunk_storage(int iterations);
+
+// Linear vs Morton layout: cache lines touched and throughput of neighbourhood sweeps
+void benchmark_chunk_layout(int sweeps);
+
+#endif // CHUNK_STORAGE_H
@@ -3,6 +3,7 @@
 
 #include "core/types.h"
 #include "core/memory.h"
+#include "world/chunk_storage.h"
 
 // Voxel block types - SIMPLIFICADO: Solo bloques básicos
 typedef enum {
@@ -48,7 +49,7 @@ typedef struct {
     char name[32];          // Nombre del bloque
 } BlockBlueprint;
 
-// Voxel block structure
+// Voxel block structure - vista desempaquetada de un bloque (no se almacena en el chunk)
 typedef struct {
     VoxelType type;
     Color color;        // Color actual del bloque (puede variar)
@@ -62,25 +63,157 @@ typedef struct {
     int currentDurability; // Durabilidad actual (se reduce al golpear)
 } VoxelBlock;
 
-// Chunk structure (16x16x16 blocks)
+// Face mask bits (see get_block_faces)
+#define BLOCK_FACE_RIGHT  0x01  // +X
+#define BLOCK_FACE_LEFT   0x02  // -X
+#define BLOCK_FACE_FRONT  0x04  // +Y
+#define BLOCK_FACE_BACK   0x08  // -Y
+#define BLOCK_FACE_TOP    0x10  // +Z
+#define BLOCK_FACE_BOTTOM 0x20  // -Z
+#define BLOCK_FACE_ALL    0x3F
+
+// Vertical chunk stacks: the world spans chunkZ in [min, max]; only the chunks
+// within verticalDistance of the player's chunkZ are loaded (see set_chunk_vertical_range)
+#define CHUNK_DEFAULT_MIN_Z -1
+#define CHUNK_DEFAULT_MAX_Z 2
+#define CHUNK_DEFAULT_VERTICAL_DISTANCE 1
+
+// World Z of the grass layer: sections that do not contain it are uniform air
+#define TERRAIN_GROUND_LEVEL 0
+
+// Mesher used for a chunk's geometry (see world/chunk_mesh.h)
+typedef enum {
+    CHUNK_MESH_NAIVE = 0,   // Un quad por cara visible, color por bloque
+    CHUNK_MESH_GREEDY = 1,  // Caras coplanares del mismo tipo fusionadas en rectángulos
+    CHUNK_MESH_BINARY = 2   // Greedy sobre máscaras de bits de las columnas de ocupación
+} ChunkMeshMode;
+
+// Render pass of a block's faces (see graphics/chunk_renderer.c)
+typedef enum {
+    CHUNK_LAYER_OPAQUE = 0,       // Tapa lo de detrás: se dibuja primero, sin orden (early-Z)
+    CHUNK_LAYER_CUTOUT = 1,       // Hojas: con profundidad y sin back-face culling, sin orden
+    CHUNK_LAYER_TRANSLUCENT = 2,  // Agua, vidrio, lava: mezcla alfa, de atrás hacia delante
+    CHUNK_LAYER_COUNT = 3
+} ChunkRenderLayer;
+
+// Damaged blocks side table (durability only stored for blocks that were hit)
+#define CHUNK_MAX_DAMAGED_BLOCKS 8
+
 typedef struct {
+    uint16 index;       // Índice del voxel dentro del chunk
+    uint16 durability;  // Durabilidad restante
+} BlockDamage;
+
+// Neighbour links: 3x3x3 block of chunks around a chunk, index 13 is the chunk itself
+#define CHUNK_NEIGHBOR_COUNT 27
+#define CHUNK_NEIGHBOR_SELF 13
+
+static inline int chunk_neighbor_index(int dx, int dy, int dz) {
+    return (dx + 1) * 9 + (dy + 1) * 3 + (dz + 1);
+}
+
+// Chunk structure (16x16x16 blocks) - almacenamiento compacto con paleta
+typedef struct VoxelChunk {
     int chunkX, chunkY, chunkZ;  // Chunk coordinates
-    VoxelBlock blocks[16][16][16];  // 16x16x16 voxel grid
+    ChunkBlockStorage storage;   // VoxelType por voxel, índices de paleta de 1/2/4/8 bits
+    int colorSeed;               // Seed para la variación de color calculada bajo demanda
+    BlockDamage damaged[CHUNK_MAX_DAMAGED_BLOCKS];
+    int damagedCount;
+    uint16 occupiedMask[CHUNK_SIZE][CHUNK_SIZE]; // Bit z de la columna (x,y): bloque distinto de aire
+    uint16 solidMask[CHUNK_SIZE][CHUNK_SIZE];    // Bit z de la columna (x,y): bloque con colisión
+    uint16 opaqueMask[CHUNK_SIZE][CHUNK_SIZE];   // Bit z de la columna (x,y): bloque que oculta caras vecinas
     BOOL isGenerated;
     BOOL isVisible;
     BOOL needsRemesh;  // Flag to mark chunk for mesh regeneration
+    BOOL isDirty;      // Modificado por el jugador: se escribe a disco antes de expulsarlo
+    uint32 lastAccessFrame;  // Último frame en que se consultó (LRU)
     float distanceToCamera;
+    struct VoxelChunk* neighbors[CHUNK_NEIGHBOR_COUNT]; // Vecinos cargados (NULL si no), mantenidos al cargar/descargar
+    uint8 meshMode;           // ChunkMeshMode
+    BOOL hasMesh;             // Geometría construida al menos una vez (graphics/chunk_renderer.c)
+    uint32 meshVertexOffset;  // Primer vértice en la arena compartida de vértices
+    uint32 meshVertexCount;   // 0 si el mesh no ocupa GPU
+    uint32 meshIndexOffset;   // Primer índice (opaco y recortado) en la arena de índices
+    int meshIndexCount;
+    uint32 meshBytes;         // Bytes en GPU (vértices + índices)
+    uint32 meshRevision;      // Último envío a los workers de mesh (world/chunk_mesh_worker.c)
+    uint8 lodLevel;           // Nivel de detalle pedido: celdas de 2^lodLevel bloques (set_chunk_lod)
+    uint8 meshLod;            // Nivel del mesh subido (puede ir un remesh por detrás)
+    int meshLayerIndexCount[CHUNK_LAYER_COUNT];   // Opaco y recortado desde meshIndexOffset, en ese orden
+    uint32 meshTranslucentOffset;                 // Índices translúcidos, reordenados al cambiar de celda la cámara
+    struct ChunkTranslucentQuad* translucentQuads; // Copia en CPU para reordenar (NULL si no hay)
+    int translucentQuadCount;
+    int sortedCell[3];                            // Celda de la cámara del último orden
+    BOOL hasDirtyRegion;      // En la cola de remesh del manager (ediciones sin aplicar)
+    uint8 dirtyMin[3];        // Caja local (inclusive) que cubre las ediciones pendientes
+    uint8 dirtyMax[3];
+    uint16 faceConnectivity;  // Pares de caras unidas por aire o bloques no opacos (world/chunk_culling.h)
+    uint32 caveVisit;         // Última búsqueda de cave culling que llegó a este chunk
 } VoxelChunk;
 
-// Chunk manager with optimized memory management
+// O(1): chunk sin datos de bloques y lleno de aire (nada que mallar, colisionar ni rayar)
+static inline BOOL is_chunk_empty(const VoxelChunk* chunk) {
+    return chunk_storage_is_uniform(&chunk->storage) && chunk->storage.palette[0] == VOXEL_AIR;
+}
+
+// Occupancy bit tests (local coordinates, no bounds check)
+static inline BOOL is_chunk_block_occupied(const VoxelChunk* chunk, int x, int y, int z) {
+    return (chunk->occupiedMask[x][y] >> z) & 1;
+}
+
+static inline BOOL is_chunk_block_solid(const VoxelChunk* chunk, int x, int y, int z) {
+    return (chunk->solidMask[x][y] >> z) & 1;
+}
+
+static inline BOOL is_chunk_block_opaque(const VoxelChunk* chunk, int x, int y, int z) {
+    return (chunk->opaqueMask[x][y] >> z) & 1;
+}
+
+// Chunk hash table entry (open addressing, linear probing)
 typedef struct {
+    uint64 key;  // Coordenadas del chunk empaquetadas (21 bits por eje)
+    int slot;    // Índice en chunks[], -1 si la entrada está vacía
+} ChunkHashEntry;
+
+// Chunk eviction policy - la función de puntuación es intercambiable,
+// se expulsa primero el chunk con mayor puntuación
+struct ChunkManager;
+typedef float (*ChunkEvictionScoreFn)(const VoxelChunk* chunk, const struct ChunkManager* manager);
+
+typedef struct {
+    ChunkEvictionScoreFn score;  // NULL = chunk_eviction_score_default
+    float ageWeight;             // Puntos por frame sin acceso (LRU)
+    float distanceWeight;        // Puntos por chunk de distancia al jugador
+    float dirtyPenalty;          // Puntos restados a chunks modificados (cuesta escribirlos)
+    int protectRadius;           // Chunks alrededor del jugador que no se expulsan por presupuesto
+    size_t memoryBudget;         // Bytes (chunks + bloques), 0 = solo el límite de maxChunks
+    char saveDirectory[64];      // Carpeta donde se escriben los chunks modificados
+} ChunkEvictionPolicy;
+
+// Chunk manager with optimized memory management
+typedef struct ChunkManager {
     VoxelChunk** chunks;
+    ChunkHashEntry* chunkTable;  // (chunkX, chunkY, chunkZ) -> slot, O(1)
+    int chunkTableMask;          // Capacidad - 1 (potencia de 2, >= 2 * maxChunks)
     int maxChunks;
     int loadedChunks;
     int renderDistance;
+    int minChunkZ;          // Rango vertical del mundo (en chunks, inclusive)
+    int maxChunkZ;
+    int verticalDistance;   // Chunks cargados por encima/debajo del jugador
     int chunkSize;
     float blockSize;
     MemoryPool* chunkPool;  // Memory pool for chunks
+    ChunkEvictionPolicy evictionPolicy;
+    uint32 currentFrame;    // Avanza en cada update_chunk_loading
+    Vect3 focusPosition;    // Posición del jugador para la política de expulsión
+    int evictedChunks;      // Chunks expulsados por la política
+    int savedChunks;        // Chunks sucios escritos a disco
+    void (*releaseChunkMesh)(VoxelChunk* chunk); // Libera la geometría en GPU al descargar (lo registra el renderer)
+    ChunkMeshMode defaultMeshMode;                // Mesher de los chunks nuevos
+    VoxelChunk** remeshQueue;  // Chunks con ediciones pendientes, cada uno una sola vez (maxChunks)
+    int remeshQueueCount;
+    int queuedEdits;           // Ediciones acumuladas desde el último flush_remesh_queue
 } ChunkManager;
 
 // Terrain generation with procedural matrix
@@ -143,9 +276,11 @@ void initialize_block_from_blueprint(VoxelBlock* block, BlockBlueprint* blueprin
 ChunkManager* create_chunk_manager(int maxChunks, int renderDistance);
 void destroy_chunk_manager(ChunkManager* manager);
 VoxelChunk* get_or_create_chunk(ChunkManager* manager, int chunkX, int chunkY, int chunkZ);
+VoxelChunk* find_chunk(ChunkManager* manager, int chunkX, int chunkY, int chunkZ);
 void generate_chunk_terrain(VoxelChunk* chunk, TerrainGenerator* generator);
 void update_chunk_visibility(VoxelChunk* chunk, Vect3 cameraPosition);
 void render_chunk(VoxelChunk* chunk, Vect3 cameraPosition, Vect3 cameraForward);
+// Chunks within 100 units count as accessed; el culling y el dibujo van en render_chunk_meshes
 void render_chunk_manager(ChunkManager* manager, Vect3 cameraPosition, Vect3 cameraForward);
 
 // Terrain generation functions
@@ -156,18 +291,61 @@ int get_terrain_height(float x, float y, TerrainGenerator* generator);
 VoxelType get_terrain_block_type(int x, int y, int z, int height);
 
 // Block face culling
-void calculate_block_faces(VoxelChunk* chunk, int x, int y, int z);
+uint8 calculate_block_faces(VoxelChunk* chunk, int x, int y, int z);
+void calculate_column_faces(VoxelChunk* chunk, int x, int y, uint16 faces[6]);  // Bit z por cara, columna entera
 BOOL is_block_adjacent(VoxelChunk* chunk, int x, int y, int z, int dx, int dy, int dz);
+
+// Neighbour-aware access: coordinates may step one chunk outside (-16..31), O(1)
+VoxelChunk* get_chunk_neighbor(VoxelChunk* chunk, int dx, int dy, int dz);
+VoxelType get_block_type_across(VoxelChunk* chunk, int x, int y, int z);
+BOOL is_block_opaque_across(VoxelChunk* chunk, int x, int y, int z);
+void mark_block_remesh(VoxelChunk* chunk, int x, int y, int z);
+
+// Remesh queue: las ediciones de un frame se acumulan en una caja por chunk y se aplican
+// juntas; los vecinos solo se marcan si la caja toca su borde
+void queue_block_remesh(ChunkManager* manager, VoxelChunk* chunk, int x, int y, int z);
+void queue_region_remesh(ChunkManager* manager, VoxelChunk* chunk, int minX, int minY, int minZ, int maxX, int maxY, int maxZ);
+int flush_remesh_queue(ChunkManager* manager);  // Chunks marcados con needsRemesh
+int fill_block_region(ChunkManager* manager, int minX, int minY, int minZ, int maxX, int maxY, int maxZ, VoxelType type);
+BOOL verify_remesh_queue(void);
+
+// Occupancy bitmasks (occupiedMask / solidMask / opaqueMask)
+BOOL is_voxel_solid(VoxelType type);
+BOOL is_voxel_opaque(VoxelType type);
+void rebuild_chunk_occupancy(VoxelChunk* chunk);
+void benchmark_occupancy_masks(int iterations);
+
+// Compact block access
 VoxelType get_block_type(VoxelChunk* chunk, int x, int y, int z);
+void set_block_type(VoxelChunk* chunk, int x, int y, int z, VoxelType type);
+uint8 get_block_faces(VoxelChunk* chunk, int x, int y, int z);
+Color get_block_color(VoxelChunk* chunk, int x, int y, int z);
+int get_block_durability(VoxelChunk* chunk, int x, int y, int z);
+void set_block_durability(VoxelChunk* chunk, int x, int y, int z, int durability);
+VoxelBlock get_block_info(VoxelChunk* chunk, int x, int y, int z);
 
 // Utility functions
 Vect3 chunk_to_world_pos(int chunkX, int chunkY, int chunkZ, int blockX, int blockY, int blockZ);
 void world_to_chunk_pos(float worldX, float worldY, float worldZ, int* chunkX, int* chunkY, int* chunkZ, int* blockX, int* blockY, int* blockZ);
 Color get_voxel_color(VoxelType type);
+Color get_terrain_color(VoxelType type, int x, int y, int z, int seed);
+Color generate_random_color(int x, int y, int z, int seed);
 float get_voxel_opacity(VoxelType type);
+ChunkRenderLayer get_voxel_render_layer(VoxelType type);
+
+// Chunk eviction and persistence
+ChunkEvictionPolicy default_chunk_eviction_policy();
+float chunk_eviction_score_default(const VoxelChunk* chunk, const struct ChunkManager* manager);
+size_t get_chunk_manager_memory(ChunkManager* manager);
+BOOL evict_chunk(ChunkManager* manager, BOOL allowProtected);
+void enforce_chunk_memory_budget(ChunkManager* manager);
+BOOL save_chunk_to_disk(VoxelChunk* chunk, const char* directory);
+BOOL load_chunk_from_disk(VoxelChunk* chunk, const char* directory);
+void delete_saved_chunks(const char* directory);
 
 // Chunk loading system
 void update_chunk_loading(ChunkManager* manager, Vect3 playerPosition, ChunkLoadingConfig config);
+void set_chunk_vertical_range(ChunkManager* manager, int minChunkZ, int maxChunkZ, int verticalDistance);
 void load_chunks_around_player(ChunkManager* manager, Vect3 playerPosition, int distance);
 void unload_distant_chunks(ChunkManager* manager, Vect3 playerPosition, int maxDistance);
 void emergency_cleanup_chunks(ChunkManager* manager);
@@ -127,6 +127,32 @@ Vect3 matrix4x4_transform_vector(Matrix4x4 m, Vect3 vector) {
     return result;
 }
 
+Matrix4x4 matrix4x4_perspective(float fovYDegrees, float aspect, float nearPlane, float farPlane) {
+    Matrix4x4 m = {0};
+    float f = 1.0f / tanf(deg_to_rad(fovYDegrees) * 0.5f);
+    m.m[0][0] = f / aspect;
+    m.m[1][1] = f;
+    m.m[2][2] = (farPlane + nearPlane) / (nearPlane - farPlane);
+    m.m[2][3] = -1.0f;
+    m.m[3][2] = 2.0f * farPlane * nearPlane / (nearPlane - farPlane);
+    return m;
+}
+
+Matrix4x4 matrix4x4_look_at(Vect3 eye, Vect3 target, Vect3 up) {
+    Vect3 f = vect3_normalize(vect3_subtract(target, eye));
+    Vect3 s = vect3_normalize(vect3_cross(f, up));
+    Vect3 u = vect3_cross(s, f);
+
+    Matrix4x4 m = matrix4x4_identity();
+    m.m[0][0] = s.x; m.m[1][0] = s.y; m.m[2][0] = s.z;
+    m.m[0][1] = u.x; m.m[1][1] = u.y; m.m[2][1] = u.z;
+    m.m[0][2] = -f.x; m.m[1][2] = -f.y; m.m[2][2] = -f.z;
+    m.m[3][0] = -vect3_dot(s, eye);
+    m.m[3][1] = -vect3_dot(u, eye);
+    m.m[3][2] = vect3_dot(f, eye);
+    return m;
+}
+
 // Camera operations
 Camera create_camera(Vect3 position, Vect3 target, float fov) {
     Camera camera = {0};
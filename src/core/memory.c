@@ -1,10 +1,23 @@
 #include "core/memory.h"
 #include <stdio.h>
 #include <stdlib.h>
+#include <string.h>
 
 // Global memory statistics
 static MemoryStats g_memory_stats = {0};
 
+// Atomic: los workers de meshing también reservan memoria
+static void track_allocation(size_t size) {
+    size_t usage = __atomic_add_fetch(&g_memory_stats.current_usage, size, __ATOMIC_RELAXED);
+    __atomic_add_fetch(&g_memory_stats.total_allocated, size, __ATOMIC_RELAXED);
+    __atomic_add_fetch(&g_memory_stats.allocation_count, 1, __ATOMIC_RELAXED);
+
+    size_t peak = __atomic_load_n(&g_memory_stats.peak_usage, __ATOMIC_RELAXED);
+    while (usage > peak &&
+           !__atomic_compare_exchange_n(&g_memory_stats.peak_usage, &peak, usage, TRUE, __ATOMIC_RELAXED, __ATOMIC_RELAXED)) {
+    }
+}
+
 void* safe_malloc(size_t size) {
     void* ptr = malloc(size);
     if (!ptr) {
@@ -12,14 +25,7 @@ void* safe_malloc(size_t size) {
         return NULL;
     }
     
-    g_memory_stats.total_allocated += size;
-    g_memory_stats.current_usage += size;
-    g_memory_stats.allocation_count++;
-    
-    if (g_memory_stats.current_usage > g_memory_stats.peak_usage) {
-        g_memory_stats.peak_usage = g_memory_stats.current_usage;
-    }
-    
+    track_allocation(size);
     return ptr;
 }
 
@@ -30,15 +36,7 @@ void* safe_calloc(size_t count, size_t size) {
         return NULL;
     }
     
-    size_t total_size = count * size;
-    g_memory_stats.total_allocated += total_size;
-    g_memory_stats.current_usage += total_size;
-    g_memory_stats.allocation_count++;
-    
-    if (g_memory_stats.current_usage > g_memory_stats.peak_usage) {
-        g_memory_stats.peak_usage = g_memory_stats.current_usage;
-    }
-    
+    track_allocation(count * size);
     return ptr;
 }
 
@@ -54,17 +52,29 @@ MemoryPool* create_memory_pool(size_t total_size, size_t block_size) {
     MemoryPool* pool = (MemoryPool*)safe_malloc(sizeof(MemoryPool));
     if (!pool) return NULL;
     
-    pool->memory = safe_malloc(total_size);
+    // Every block must be able to hold the free-list link
+    size_t align = sizeof(void*);
+    if (block_size < sizeof(void*)) block_size = sizeof(void*);
+    block_size = (block_size + align - 1) & ~(align - 1);
+    
+    pool->block_count = total_size / block_size;
+    pool->size = pool->block_count * block_size;
+    pool->memory = safe_malloc(pool->size);
     if (!pool->memory) {
         safe_free(pool);
         return NULL;
     }
     
-    pool->size = total_size;
     pool->used = 0;
     pool->block_size = block_size;
+    pool->blocks_in_use = 0;
+    pool->high_water = 0;
+    pool->carved = 0;
+    pool->free_list = NULL;
+    pool->zero_on_free = FALSE;
     
-    printf("Memory pool creado: %zu bytes total, %zu bytes por bloque\n", total_size, block_size);
+    printf("Memory pool creado: %zu bloques de %zu bytes (%zu bytes total)\n",
+           pool->block_count, block_size, pool->size);
     
     return pool;
 }
@@ -79,34 +89,76 @@ void destroy_memory_pool(MemoryPool* pool) {
 void* pool_alloc(MemoryPool* pool) {
     if (!pool) return NULL;
     
-    // Check if we have enough space
-    if (pool->used + pool->block_size > pool->size) {
-        printf("ERROR: Pool de memoria agotado. Usado: %zu/%zu bytes\n", pool->used, pool->size);
+    void* ptr;
+    if (pool->free_list) {
+        // Reuse the most recently freed block
+        ptr = pool->free_list;
+        pool->free_list = *(void**)ptr;
+    } else if (pool->carved < pool->block_count) {
+        // Blocks never handed out are carved lazily, no upfront free-list build
+        ptr = (char*)pool->memory + pool->carved * pool->block_size;
+        pool->carved++;
+    } else {
+        printf("ERROR: Pool de memoria agotado. Bloques en uso: %zu/%zu\n",
+               pool->blocks_in_use, pool->block_count);
         return NULL;
     }
     
-    void* ptr = (char*)pool->memory + pool->used;
+    pool->blocks_in_use++;
     pool->used += pool->block_size;
-    
-    printf("Pool alloc: %zu bytes asignados, usado: %zu/%zu\n", pool->block_size, pool->used, pool->size);
+    if (pool->blocks_in_use > pool->high_water) {
+        pool->high_water = pool->blocks_in_use;
+    }
     
     return ptr;
 }
 
 void pool_free(MemoryPool* pool, void* ptr) {
-    // Simple implementation - just reset the pool
-    // In a more sophisticated system, you'd track individual allocations
-    (void)pool;
-    (void)ptr;
+    if (!pool || !ptr) return;
+    
+    size_t offset = (size_t)((char*)ptr - (char*)pool->memory);
+    if ((char*)ptr < (char*)pool->memory || offset >= pool->carved * pool->block_size ||
+        offset % pool->block_size != 0) {
+        printf("ERROR: pool_free con puntero fuera del pool (%p)\n", ptr);
+        return;
+    }
+    
+    if (pool->zero_on_free) {
+        memset(ptr, 0, pool->block_size);
+    }
+    
+    *(void**)ptr = pool->free_list;
+    pool->free_list = ptr;
+    pool->blocks_in_use--;
+    pool->used -= pool->block_size;
 }
 
+// Return every block at once - only valid when nothing references pool memory anymore
 void pool_reset(MemoryPool* pool) {
     if (pool) {
-        printf("Pool de memoria reiniciado. Usado: %zu -> 0\n", pool->used);
+        printf("Pool de memoria reiniciado. Bloques en uso: %zu -> 0\n", pool->blocks_in_use);
         pool->used = 0;
+        pool->blocks_in_use = 0;
+        pool->carved = 0;
+        pool->free_list = NULL;
+    }
+}
+
+void pool_set_zero_on_free(MemoryPool* pool, BOOL enabled) {
+    if (pool) {
+        pool->zero_on_free = enabled;
     }
 }
 
+void print_pool_stats(MemoryPool* pool) {
+    if (!pool) return;
+    
+    printf("   - Pool: %zu/%zu bloques en uso (%.1f%%), máximo histórico: %zu, bloque: %zu bytes\n",
+           pool->blocks_in_use, pool->block_count,
+           pool->block_count > 0 ? 100.0f * pool->blocks_in_use / pool->block_count : 0.0f,
+           pool->high_water, pool->block_size);
+}
+
 MemoryStats* get_memory_stats() {
     return &g_memory_stats;
 }
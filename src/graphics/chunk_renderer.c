@@ -0,0 +1,923 @@
+#include "graphics/chunk_renderer.h"
+#include "graphics/shaders/shaders.h"
+#include "world/chunk_mesh_worker.h"
+#include "world/chunk_arena.h"
+#include "core/memory.h"
+#include "core/math3d.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stddef.h>
+#include <limits.h>
+#include <math.h>
+#include <windows.h>
+#include <GL/gl.h>
+#include <GL/glext.h>
+
+// Buffer object and vertex attribute entry points (OpenGL 1.5 / 2.0, cargados con wglGetProcAddress)
+static PFNGLGENBUFFERSPROC glGenBuffers = NULL;
+static PFNGLBINDBUFFERPROC glBindBuffer = NULL;
+static PFNGLBUFFERDATAPROC glBufferData = NULL;
+static PFNGLBUFFERSUBDATAPROC glBufferSubData = NULL;
+static PFNGLDELETEBUFFERSPROC glDeleteBuffers = NULL;
+static PFNGLUSEPROGRAMPROC glUseProgram = NULL;
+static PFNGLGETATTRIBLOCATIONPROC glGetAttribLocation = NULL;
+static PFNGLGETUNIFORMLOCATIONPROC glGetUniformLocation = NULL;
+static PFNGLVERTEXATTRIBPOINTERPROC glVertexAttribPointer = NULL;
+static PFNGLENABLEVERTEXATTRIBARRAYPROC glEnableVertexAttribArray = NULL;
+static PFNGLDISABLEVERTEXATTRIBARRAYPROC glDisableVertexAttribArray = NULL;
+static PFNGLUNIFORM3FPROC glUniform3f = NULL;
+static PFNGLUNIFORM3FVPROC glUniform3fv = NULL;
+static PFNGLUNIFORM4FVPROC glUniform4fv = NULL;
+
+// Optional: compactar la arena en GPU (3.1) y multi-draw con vértice base (3.2) o indirecto (4.3)
+static PFNGLCOPYBUFFERSUBDATAPROC glCopyBufferSubData = NULL;
+static PFNGLMULTIDRAWELEMENTSBASEVERTEXPROC glMultiDrawElementsBaseVertex = NULL;
+static PFNGLMULTIDRAWELEMENTSINDIRECTPROC glMultiDrawElementsIndirect = NULL;
+
+static BOOL g_chunk_renderer_ready = FALSE;
+static ChunkMesh g_scratch_mesh;  // Reutilizado por todos los remesh, la capacidad se conserva
+static ChunkRenderStats g_chunk_render_stats = {0};
+static float g_lod_pixels_per_unit = 623.5f;  // 720 píxeles de alto con 60 grados hasta set_chunk_lod_projection
+static uint16 g_sorted_indices[CHUNK_MESH_MAX_QUADS * 6];  // Destino del orden translúcido antes de subirlo
+static ChunkVertex g_staged_vertices[CHUNK_MESH_MAX_QUADS * 4];  // Vértices desplazados a su región antes de subirlos
+static ChunkManager* g_chunk_manager = NULL;  // Para compactar la arena (recorre los meshes vivos)
+static uint32 g_arena_retry_frame = 0;        // Tras fallar una compactación no se reintenta antes de este frame
+static BOOL g_arena_compact_failed = FALSE;   // Fallo ya avisado; se limpia al compactar con éxito
+
+// Shared geometry: un VBO y un IBO para todos los chunks, repartidos por las arenas
+static struct {
+    GLuint vertexBuffer;
+    GLuint indexBuffer;
+    GLuint indirectBuffer;  // Comandos del multi-draw indirecto de cada pasada
+    ChunkArena vertices;    // En ChunkVertex
+    ChunkArena indices;     // En uint16
+} g_chunk_arena = {0};
+
+// Packed vertices are decoded by the lit chunk shader
+static ShaderProgram g_chunk_shader = {0};
+static GLint g_attrib_packed0 = -1;
+static GLint g_attrib_packed1 = -1;
+static GLint g_uniform_region_origin = -1;
+static ShaderUniforms g_chunk_uniforms;  // Matrices, luz y niebla: ubicaciones leídas una vez
+
+// Camera and lighting for the next render_chunk_meshes (begin_frame y render_test_environment)
+static float g_chunk_view[16] = {1, 0, 0, 0, 0, 1, 0, 0, 0, 0, 1, 0, 0, 0, 0, 1};
+static float g_chunk_projection[16] = {1, 0, 0, 0, 0, 1, 0, 0, 0, 0, 1, 0, 0, 0, 0, 1};
+static ShaderLighting g_chunk_lighting = {
+    {0.0f, 0.0f, -1.0f},  // Sol vertical
+    {255, 255, 255},
+    0.6f,
+    {204, 204, 204},
+    0.0f,                 // Sin niebla
+    {0, 0, 0},
+    1.0f
+};
+
+// Submission path, el mejor que ofrezca el driver
+typedef enum {
+    CHUNK_DRAW_INDIRECT,    // glMultiDrawElementsIndirect: una llamada por región y capa
+    CHUNK_DRAW_BASE_VERTEX, // glMultiDrawElementsBaseVertex: igual, con los comandos en CPU
+    CHUNK_DRAW_SINGLE       // glDrawElements por chunk, moviendo el puntero de vértices
+} ChunkDrawPath;
+static ChunkDrawPath g_draw_path = CHUNK_DRAW_SINGLE;
+
+// Per-pass draw lists (crecen bajo demanda). El comando tiene el layout de
+// DrawElementsIndirectCommand; los otros arrays son los de glMultiDrawElementsBaseVertex.
+typedef struct {
+    GLuint count;
+    GLuint instanceCount;
+    GLuint firstIndex;
+    GLint baseVertex;
+    GLuint baseInstance;
+} ChunkDrawCommand;
+
+typedef struct {
+    uint64 region;
+    VoxelChunk* chunk;
+} ChunkDrawEntry;
+
+static ChunkDrawEntry* g_draw_entries = NULL;
+static ChunkDrawCommand* g_draw_commands = NULL;
+static GLsizei* g_draw_counts = NULL;
+static const void** g_draw_offsets = NULL;
+static GLint* g_draw_base_vertices = NULL;
+static int* g_draw_sources = NULL;  // Entrada de la que sale cada comando (las capas vacías no llevan)
+static int g_draw_capacity = 0;
+
+// Translucent chunks of the current frame, ordenados por distancia (crece bajo demanda)
+typedef struct TranslucentChunkEntry TranslucentChunkEntry;
+static TranslucentChunkEntry* g_translucent_chunks = NULL;
+static int g_translucent_chunk_capacity = 0;
+
+static BOOL init_buffer_functions() {
+#pragma GCC diagnostic push
+#pragma GCC diagnostic ignored "-Wcast-function-type"
+    glGenBuffers = (PFNGLGENBUFFERSPROC)wglGetProcAddress("glGenBuffers");
+    glBindBuffer = (PFNGLBINDBUFFERPROC)wglGetProcAddress("glBindBuffer");
+    glBufferData = (PFNGLBUFFERDATAPROC)wglGetProcAddress("glBufferData");
+    glDeleteBuffers = (PFNGLDELETEBUFFERSPROC)wglGetProcAddress("glDeleteBuffers");
+    glUseProgram = (PFNGLUSEPROGRAMPROC)wglGetProcAddress("glUseProgram");
+    glGetAttribLocation = (PFNGLGETATTRIBLOCATIONPROC)wglGetProcAddress("glGetAttribLocation");
+    glGetUniformLocation = (PFNGLGETUNIFORMLOCATIONPROC)wglGetProcAddress("glGetUniformLocation");
+    glVertexAttribPointer = (PFNGLVERTEXATTRIBPOINTERPROC)wglGetProcAddress("glVertexAttribPointer");
+    glEnableVertexAttribArray = (PFNGLENABLEVERTEXATTRIBARRAYPROC)wglGetProcAddress("glEnableVertexAttribArray");
+    glDisableVertexAttribArray = (PFNGLDISABLEVERTEXATTRIBARRAYPROC)wglGetProcAddress("glDisableVertexAttribArray");
+    glUniform3f = (PFNGLUNIFORM3FPROC)wglGetProcAddress("glUniform3f");
+    glUniform3fv = (PFNGLUNIFORM3FVPROC)wglGetProcAddress("glUniform3fv");
+    glUniform4fv = (PFNGLUNIFORM4FVPROC)wglGetProcAddress("glUniform4fv");
+    glBufferSubData = (PFNGLBUFFERSUBDATAPROC)wglGetProcAddress("glBufferSubData");
+    glCopyBufferSubData = (PFNGLCOPYBUFFERSUBDATAPROC)wglGetProcAddress("glCopyBufferSubData");
+    glMultiDrawElementsBaseVertex = (PFNGLMULTIDRAWELEMENTSBASEVERTEXPROC)wglGetProcAddress("glMultiDrawElementsBaseVertex");
+    glMultiDrawElementsIndirect = (PFNGLMULTIDRAWELEMENTSINDIRECTPROC)wglGetProcAddress("glMultiDrawElementsIndirect");
+#pragma GCC diagnostic pop
+
+    return glGenBuffers && glBindBuffer && glBufferData && glBufferSubData && glDeleteBuffers &&
+           glUseProgram && glGetAttribLocation && glGetUniformLocation && glVertexAttribPointer &&
+           glEnableVertexAttribArray && glDisableVertexAttribArray && glUniform3f && glUniform3fv && glUniform4fv;
+}
+
+// Compile the packed-vertex shader and upload the block color table once
+static BOOL init_chunk_shader() {
+    g_chunk_shader = create_lit_chunk_shader_program();
+    if (!g_chunk_shader.isLinked) return FALSE;
+
+    g_attrib_packed0 = glGetAttribLocation(g_chunk_shader.program, "aPacked0");
+    g_attrib_packed1 = glGetAttribLocation(g_chunk_shader.program, "aPacked1");
+    g_uniform_region_origin = glGetUniformLocation(g_chunk_shader.program, "uRegionOrigin");
+    GLint blockColors = glGetUniformLocation(g_chunk_shader.program, "uBlockColors");
+    if (g_attrib_packed0 < 0 || g_attrib_packed1 < 0) {
+        destroy_shader_program(&g_chunk_shader);
+        return FALSE;
+    }
+
+    // Alpha = opacidad de los bloques translúcidos; las hojas se dibujan recortadas, opacas
+    float colors[16 * 4];
+    for (int type = 0; type < 16; type++) {
+        Color color = get_voxel_color((VoxelType)type);
+        colors[type * 4 + 0] = color.r / 255.0f;
+        colors[type * 4 + 1] = color.g / 255.0f;
+        colors[type * 4 + 2] = color.b / 255.0f;
+        colors[type * 4 + 3] = get_voxel_render_layer((VoxelType)type) == CHUNK_LAYER_TRANSLUCENT
+                               ? get_voxel_opacity((VoxelType)type) : 1.0f;
+    }
+    g_chunk_uniforms = get_shader_uniforms(g_chunk_shader);  // Deja el programa activo
+    if (blockColors >= 0) glUniform4fv(blockColors, 16, colors);
+    glUseProgram(0);
+    return TRUE;
+}
+
+// Allocate the shared VBO/IBO with room for the given counts (contenido sin definir)
+static BOOL create_arena_buffers(GLuint* vertexBuffer, GLuint* indexBuffer, uint32 vertexCapacity, uint32 indexCapacity) {
+    GLuint buffers[2] = {0, 0};
+    glGenBuffers(2, buffers);
+    if (!buffers[0] || !buffers[1]) return FALSE;
+
+    glBindBuffer(GL_ARRAY_BUFFER, buffers[0]);
+    glBufferData(GL_ARRAY_BUFFER, (GLsizeiptr)vertexCapacity * sizeof(ChunkVertex), NULL, GL_DYNAMIC_DRAW);
+    glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, buffers[1]);
+    glBufferData(GL_ELEMENT_ARRAY_BUFFER, (GLsizeiptr)indexCapacity * sizeof(uint16), NULL, GL_DYNAMIC_DRAW);
+    glBindBuffer(GL_ARRAY_BUFFER, 0);
+    glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, 0);
+
+    // glBufferData no devuelve nada: la falta de memoria solo se ve en glGetError
+    BOOL outOfMemory = FALSE;
+    GLenum error;
+    for (int i = 0; i < 8 && (error = glGetError()) != GL_NO_ERROR; i++) {  // Acotado: sin contexto no se vacía
+        if (error == GL_OUT_OF_MEMORY) outOfMemory = TRUE;
+    }
+    if (outOfMemory) {
+        glDeleteBuffers(2, buffers);
+        return FALSE;
+    }
+
+    *vertexBuffer = buffers[0];
+    *indexBuffer = buffers[1];
+    return TRUE;
+}
+
+static void update_arena_bytes(void) {
+    g_chunk_render_stats.arenaBytes = (size_t)g_chunk_arena.vertices.capacity * sizeof(ChunkVertex) +
+                                      (size_t)g_chunk_arena.indices.capacity * sizeof(uint16);
+}
+
+static BOOL init_chunk_arena(void) {
+    if (!chunk_arena_init(&g_chunk_arena.vertices, CHUNK_ARENA_INITIAL_VERTICES) ||
+        !chunk_arena_init(&g_chunk_arena.indices, CHUNK_ARENA_INITIAL_INDICES) ||
+        !create_arena_buffers(&g_chunk_arena.vertexBuffer, &g_chunk_arena.indexBuffer,
+                              CHUNK_ARENA_INITIAL_VERTICES, CHUNK_ARENA_INITIAL_INDICES)) {
+        chunk_arena_free(&g_chunk_arena.vertices);
+        chunk_arena_free(&g_chunk_arena.indices);
+        return FALSE;
+    }
+
+    g_draw_path = CHUNK_DRAW_SINGLE;
+    if (glMultiDrawElementsIndirect) {
+        GLuint buffer = 0;
+        glGenBuffers(1, &buffer);
+        g_chunk_arena.indirectBuffer = buffer;
+        if (buffer) g_draw_path = CHUNK_DRAW_INDIRECT;
+    }
+    if (g_draw_path == CHUNK_DRAW_SINGLE && glMultiDrawElementsBaseVertex) {
+        g_draw_path = CHUNK_DRAW_BASE_VERTEX;
+    }
+    update_arena_bytes();
+    return TRUE;
+}
+
+static void shutdown_chunk_arena(void) {
+    GLuint buffers[3] = {g_chunk_arena.vertexBuffer, g_chunk_arena.indexBuffer, g_chunk_arena.indirectBuffer};
+    glDeleteBuffers(g_chunk_arena.indirectBuffer ? 3 : 2, buffers);
+    chunk_arena_free(&g_chunk_arena.vertices);
+    chunk_arena_free(&g_chunk_arena.indices);
+    memset(&g_chunk_arena, 0, sizeof(g_chunk_arena));
+
+    safe_free(g_draw_entries);
+    safe_free(g_draw_commands);
+    safe_free(g_draw_counts);
+    safe_free((void*)g_draw_offsets);
+    safe_free(g_draw_base_vertices);
+    safe_free(g_draw_sources);
+    g_draw_entries = NULL;
+    g_draw_commands = NULL;
+    g_draw_counts = NULL;
+    g_draw_offsets = NULL;
+    g_draw_base_vertices = NULL;
+    g_draw_sources = NULL;
+    g_draw_capacity = 0;
+}
+
+BOOL init_chunk_renderer(ChunkManager* manager) {
+    if (g_chunk_renderer_ready) return TRUE;
+
+    if (!init_buffer_functions()) {
+        printf("ERROR: OpenGL buffer objects not available for chunk meshes\n");
+        return FALSE;
+    }
+    if (!init_chunk_shader()) {
+        printf("ERROR: No se pudo crear el shader de vértices empaquetados de chunk\n");
+        return FALSE;
+    }
+    if (!init_chunk_arena()) {
+        printf("ERROR: No se pudo reservar la arena de geometría de chunks\n");
+        destroy_shader_program(&g_chunk_shader);
+        return FALSE;
+    }
+
+    chunk_mesh_init(&g_scratch_mesh);
+    memset(&g_chunk_render_stats, 0, sizeof(ChunkRenderStats));
+    update_arena_bytes();
+    if (!init_chunk_mesh_workers(0)) {
+        printf("WARNING: Sin hilos de meshing, los chunks se mallan en el hilo principal\n");
+    }
+    if (manager) {
+        manager->releaseChunkMesh = release_chunk_mesh;
+    }
+    g_chunk_manager = manager;
+    g_arena_compact_failed = FALSE;
+
+    static const char* pathNames[] = {"glMultiDrawElementsIndirect", "glMultiDrawElementsBaseVertex", "glDrawElements por chunk"};
+    g_chunk_renderer_ready = TRUE;
+    printf("Chunk renderer inicializado (arena de %zu KB, %s, vértices empaquetados de %zu bytes)\n",
+           g_chunk_render_stats.arenaBytes / 1024, pathNames[g_draw_path], sizeof(ChunkVertex));
+    return TRUE;
+}
+
+void shutdown_chunk_renderer(ChunkManager* manager) {
+    if (!g_chunk_renderer_ready) return;
+
+    if (manager) {
+        for (int i = 0; i < manager->maxChunks; i++) {
+            if (manager->chunks[i]) {
+                release_chunk_mesh(manager->chunks[i]);
+            }
+        }
+        manager->releaseChunkMesh = NULL;
+    }
+
+    shutdown_chunk_mesh_workers(manager);
+    shutdown_chunk_arena();
+    destroy_shader_program(&g_chunk_shader);
+    chunk_mesh_free(&g_scratch_mesh);
+    free_chunk_cull_bounds();
+    if (g_translucent_chunks) {
+        safe_free(g_translucent_chunks);
+        g_translucent_chunks = NULL;
+        g_translucent_chunk_capacity = 0;
+    }
+    g_chunk_manager = NULL;
+    g_chunk_renderer_ready = FALSE;
+}
+
+// Give the chunk's arena ranges back (la copia en CPU de los quads translúcidos se conserva)
+static void release_chunk_arena_ranges(VoxelChunk* chunk) {
+    if (chunk->meshVertexCount) {
+        int solidIndexCount = chunk->meshLayerIndexCount[CHUNK_LAYER_OPAQUE] + chunk->meshLayerIndexCount[CHUNK_LAYER_CUTOUT];
+        chunk_arena_release(&g_chunk_arena.vertices, chunk->meshVertexOffset, chunk->meshVertexCount);
+        chunk_arena_release(&g_chunk_arena.indices, chunk->meshIndexOffset, (uint32)solidIndexCount);
+        chunk_arena_release(&g_chunk_arena.indices, chunk->meshTranslucentOffset,
+                            (uint32)chunk->meshLayerIndexCount[CHUNK_LAYER_TRANSLUCENT]);
+    }
+    if (g_chunk_render_stats.gpuBytes >= chunk->meshBytes) {
+        g_chunk_render_stats.gpuBytes -= chunk->meshBytes;
+    }
+
+    chunk->meshVertexOffset = 0;
+    chunk->meshVertexCount = 0;
+    chunk->meshIndexOffset = 0;
+    chunk->meshTranslucentOffset = 0;
+    chunk->meshIndexCount = 0;
+    memset(chunk->meshLayerIndexCount, 0, sizeof(chunk->meshLayerIndexCount));
+    chunk->meshBytes = 0;
+}
+
+void release_chunk_mesh(VoxelChunk* chunk) {
+    if (!chunk) return;
+
+    if (g_chunk_renderer_ready) {
+        release_chunk_arena_ranges(chunk);
+    }
+    if (chunk->translucentQuads) {
+        safe_free(chunk->translucentQuads);
+    }
+
+    chunk->translucentQuads = NULL;
+    chunk->translucentQuadCount = 0;
+    chunk->meshLod = 0;
+    chunk->hasMesh = FALSE;
+}
+
+static uint32 current_chunk_frame(void) {
+    return g_chunk_manager ? g_chunk_manager->currentFrame : 0;
+}
+
+// Move every live mesh to the front of new buffers, del doble de tamaño mientras no quepa lo
+// pedido. Sin glCopyBufferSubData los meshes se descartan y se vuelven a mallar. Si no hay
+// memoria de GPU se avisa una vez y no se reintenta hasta pasados CHUNK_ARENA_RETRY_FRAMES.
+static void compact_chunk_arena(uint32 vertexNeeded, uint32 indexNeeded) {
+    if (g_arena_compact_failed && g_chunk_manager && (int32)(current_chunk_frame() - g_arena_retry_frame) < 0) return;
+
+    ChunkArena* vertices = &g_chunk_arena.vertices;
+    ChunkArena* indices = &g_chunk_arena.indices;
+    uint32 vertexCapacity = vertices->capacity, indexCapacity = indices->capacity;
+    while (vertexCapacity - vertices->used < vertexNeeded) vertexCapacity *= 2;
+    while (indexCapacity - indices->used < indexNeeded) indexCapacity *= 2;
+
+    GLuint vertexBuffer = 0, indexBuffer = 0;
+    if (!create_arena_buffers(&vertexBuffer, &indexBuffer, vertexCapacity, indexCapacity)) {
+        if (!g_arena_compact_failed) {
+            printf("ERROR: Sin memoria de GPU para compactar la arena de chunks (%u vértices, %u índices); "
+                   "se reintenta cada %d frames\n", vertexCapacity, indexCapacity, CHUNK_ARENA_RETRY_FRAMES);
+        }
+        g_arena_compact_failed = TRUE;
+        g_arena_retry_frame = current_chunk_frame() + CHUNK_ARENA_RETRY_FRAMES;
+        return;
+    }
+    g_arena_compact_failed = FALSE;
+
+    uint32 vertexCursor = 0, indexCursor = 0;
+    ChunkManager* manager = g_chunk_manager;
+    if (glCopyBufferSubData) {
+        glBindBuffer(GL_COPY_READ_BUFFER, g_chunk_arena.vertexBuffer);
+        glBindBuffer(GL_COPY_WRITE_BUFFER, vertexBuffer);
+        for (int i = 0; manager && i < manager->maxChunks; i++) {
+            VoxelChunk* chunk = manager->chunks[i];
+            if (!chunk || !chunk->meshVertexCount) continue;
+            glCopyBufferSubData(GL_COPY_READ_BUFFER, GL_COPY_WRITE_BUFFER, (GLintptr)chunk->meshVertexOffset * sizeof(ChunkVertex),
+                                (GLintptr)vertexCursor * sizeof(ChunkVertex), (GLsizeiptr)chunk->meshVertexCount * sizeof(ChunkVertex));
+            chunk->meshVertexOffset = vertexCursor;
+            vertexCursor += chunk->meshVertexCount;
+        }
+
+        // Opaco + recortado y translúcido siguen siendo dos rangos por chunk
+        glBindBuffer(GL_COPY_READ_BUFFER, g_chunk_arena.indexBuffer);
+        glBindBuffer(GL_COPY_WRITE_BUFFER, indexBuffer);
+        for (int i = 0; manager && i < manager->maxChunks; i++) {
+            VoxelChunk* chunk = manager->chunks[i];
+            if (!chunk || !chunk->meshVertexCount) continue;
+            uint32 solid = (uint32)(chunk->meshLayerIndexCount[CHUNK_LAYER_OPAQUE] + chunk->meshLayerIndexCount[CHUNK_LAYER_CUTOUT]);
+            uint32 translucent = (uint32)chunk->meshLayerIndexCount[CHUNK_LAYER_TRANSLUCENT];
+            if (solid) {
+                glCopyBufferSubData(GL_COPY_READ_BUFFER, GL_COPY_WRITE_BUFFER, (GLintptr)chunk->meshIndexOffset * sizeof(uint16),
+                                    (GLintptr)indexCursor * sizeof(uint16), (GLsizeiptr)solid * sizeof(uint16));
+            }
+            chunk->meshIndexOffset = indexCursor;
+            indexCursor += solid;
+            if (translucent) {
+                glCopyBufferSubData(GL_COPY_READ_BUFFER, GL_COPY_WRITE_BUFFER, (GLintptr)chunk->meshTranslucentOffset * sizeof(uint16),
+                                    (GLintptr)indexCursor * sizeof(uint16), (GLsizeiptr)translucent * sizeof(uint16));
+            }
+            chunk->meshTranslucentOffset = indexCursor;
+            indexCursor += translucent;
+        }
+        glBindBuffer(GL_COPY_READ_BUFFER, 0);
+        glBindBuffer(GL_COPY_WRITE_BUFFER, 0);
+    } else {
+        for (int i = 0; manager && i < manager->maxChunks; i++) {
+            VoxelChunk* chunk = manager->chunks[i];
+            if (!chunk || !chunk->meshVertexCount) continue;
+            release_chunk_mesh(chunk);
+            chunk->needsRemesh = TRUE;
+        }
+    }
+
+    GLuint old[2] = {g_chunk_arena.vertexBuffer, g_chunk_arena.indexBuffer};
+    glDeleteBuffers(2, old);
+    g_chunk_arena.vertexBuffer = vertexBuffer;
+    g_chunk_arena.indexBuffer = indexBuffer;
+    chunk_arena_reset(vertices, vertexCapacity, vertexCursor);
+    chunk_arena_reset(indices, indexCapacity, indexCursor);
+    g_chunk_render_stats.arenaCompactions++;
+    update_arena_bytes();
+}
+
+// Ranges for a new mesh; si alguno no cabe se compacta (o amplía) la arena y se reintenta
+static BOOL alloc_chunk_arena_ranges(VoxelChunk* chunk, uint32 vertexCount, uint32 solidCount, uint32 translucentCount) {
+    for (int attempt = 0; attempt < 2; attempt++) {
+        uint32 vertexOffset = 0, solidOffset = 0, translucentOffset = 0;
+        BOOL vertexOk = chunk_arena_alloc(&g_chunk_arena.vertices, vertexCount, &vertexOffset);
+        BOOL solidOk = !solidCount || chunk_arena_alloc(&g_chunk_arena.indices, solidCount, &solidOffset);
+        BOOL translucentOk = !translucentCount || chunk_arena_alloc(&g_chunk_arena.indices, translucentCount, &translucentOffset);
+        if (vertexOk && solidOk && translucentOk) {
+            chunk->meshVertexOffset = vertexOffset;
+            chunk->meshIndexOffset = solidOffset;
+            chunk->meshTranslucentOffset = translucentOffset;
+            return TRUE;
+        }
+
+        if (vertexOk) chunk_arena_release(&g_chunk_arena.vertices, vertexOffset, vertexCount);
+        if (solidOk && solidCount) chunk_arena_release(&g_chunk_arena.indices, solidOffset, solidCount);
+        if (translucentOk && translucentCount) chunk_arena_release(&g_chunk_arena.indices, translucentOffset, translucentCount);
+        if (attempt == 0) compact_chunk_arena(vertexCount, solidCount + translucentCount);
+    }
+    return FALSE;
+}
+
+// Keep the translucent quads on the CPU; el orden real se escribe en su rango de índices
+// en la pasada translúcida. Devuelve los quads guardados (0 si no hay capa o falta memoria).
+static int keep_translucent_quads(VoxelChunk* chunk, const ChunkMesh* mesh) {
+    int quadCount = mesh->layerIndexCount[CHUNK_LAYER_TRANSLUCENT] / 6;
+    if (quadCount > chunk->translucentQuadCount || (quadCount == 0 && chunk->translucentQuads)) {
+        if (chunk->translucentQuads) safe_free(chunk->translucentQuads);
+        chunk->translucentQuads = quadCount ? safe_malloc(quadCount * sizeof(ChunkTranslucentQuad)) : NULL;
+    }
+    chunk->translucentQuadCount = 0;
+    if (quadCount == 0 || !chunk->translucentQuads) return 0;
+
+    chunk->translucentQuadCount = extract_translucent_quads(mesh, chunk->translucentQuads);
+
+    // Celda imposible: fuerza el primer orden
+    chunk->sortedCell[0] = chunk->sortedCell[1] = chunk->sortedCell[2] = INT_MIN;
+    return chunk->translucentQuadCount;
+}
+
+// Region of a chunk (CHUNK_REGION_SIZE chunks por eje, 21 bits por eje como la tabla hash)
+static inline uint64 chunk_region_key(const VoxelChunk* chunk) {
+    return ((uint64)((uint32)(chunk->chunkX >> CHUNK_REGION_SHIFT) & 0x1FFFFF) << 42) |
+           ((uint64)((uint32)(chunk->chunkY >> CHUNK_REGION_SHIFT) & 0x1FFFFF) << 21) |
+           (uint64)((uint32)(chunk->chunkZ >> CHUNK_REGION_SHIFT) & 0x1FFFFF);
+}
+
+// Upload a built mesh into the shared buffers (solo hilo principal: contexto OpenGL)
+static void upload_chunk_mesh(VoxelChunk* chunk, const ChunkMesh* mesh) {
+    chunk->hasMesh = TRUE;
+    update_chunk_connectivity(chunk);  // Con los bloques actuales, no los del snapshot
+    release_chunk_arena_ranges(chunk);
+
+    // Sin caras visibles (aire, o enterrado por completo): no ocupa GPU
+    if (mesh->indexCount == 0) {
+        release_chunk_mesh(chunk);
+        chunk->hasMesh = TRUE;
+        return;
+    }
+
+    // Opaco y recortado van seguidos en un rango; el translúcido en otro porque se reescribe
+    // al reordenarlo
+    int solidIndexCount = mesh->layerIndexCount[CHUNK_LAYER_OPAQUE] + mesh->layerIndexCount[CHUNK_LAYER_CUTOUT];
+    int translucentIndexCount = keep_translucent_quads(chunk, mesh) * 6;
+    if (!alloc_chunk_arena_ranges(chunk, (uint32)mesh->vertexCount, (uint32)solidIndexCount, (uint32)translucentIndexCount)) {
+        // Con la compactación en espera el fallo ya se avisó; se vuelve a intentar al remallar
+        if (!g_arena_compact_failed) {
+            printf("ERROR: Sin sitio en la arena para el chunk (%d, %d, %d)\n", chunk->chunkX, chunk->chunkY, chunk->chunkZ);
+        }
+        release_chunk_mesh(chunk);
+        chunk->needsRemesh = TRUE;
+        return;
+    }
+
+    // Posiciones locales a la región: el chunk se desplaza 16 por cada chunk dentro de ella
+    uint32 regionOffset = (uint32)((chunk->chunkX & (CHUNK_REGION_SIZE - 1)) * CHUNK_SIZE) |
+                          ((uint32)((chunk->chunkY & (CHUNK_REGION_SIZE - 1)) * CHUNK_SIZE) << 8) |
+                          ((uint32)((chunk->chunkZ & (CHUNK_REGION_SIZE - 1)) * CHUNK_SIZE) << 16);
+    for (int v = 0; v < mesh->vertexCount; v++) {
+        g_staged_vertices[v].position = mesh->vertices[v].position + regionOffset;
+        g_staged_vertices[v].material = mesh->vertices[v].material;
+    }
+
+    size_t vertexBytes = mesh->vertexCount * sizeof(ChunkVertex);
+    size_t indexBytes = solidIndexCount * sizeof(uint16);
+    size_t translucentBytes = translucentIndexCount * sizeof(uint16);
+    glBindBuffer(GL_ARRAY_BUFFER, g_chunk_arena.vertexBuffer);
+    glBufferSubData(GL_ARRAY_BUFFER, (GLintptr)chunk->meshVertexOffset * sizeof(ChunkVertex), vertexBytes, g_staged_vertices);
+    if (solidIndexCount) {
+        glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, g_chunk_arena.indexBuffer);
+        glBufferSubData(GL_ELEMENT_ARRAY_BUFFER, (GLintptr)chunk->meshIndexOffset * sizeof(uint16), indexBytes, mesh->indices);
+    }
+
+    chunk->meshVertexCount = (uint32)mesh->vertexCount;
+    chunk->meshBytes = (uint32)(vertexBytes + indexBytes + translucentBytes);
+    chunk->meshIndexCount = solidIndexCount + translucentIndexCount;
+    memcpy(chunk->meshLayerIndexCount, mesh->layerIndexCount, sizeof(chunk->meshLayerIndexCount));
+    chunk->meshLayerIndexCount[CHUNK_LAYER_TRANSLUCENT] = translucentIndexCount;
+    chunk->meshLod = mesh->lodLevel;
+    g_chunk_render_stats.gpuBytes += chunk->meshBytes;
+    g_chunk_render_stats.uploadedBytes += chunk->meshBytes;
+}
+
+BOOL update_chunk_mesh(VoxelChunk* chunk) {
+    if (!chunk || !g_chunk_renderer_ready || !chunk->isGenerated) return FALSE;
+    if (chunk->hasMesh && !chunk->needsRemesh) return TRUE;
+
+    if (!build_chunk_mesh(chunk, &g_scratch_mesh)) return FALSE;
+    chunk->needsRemesh = FALSE;
+    g_chunk_render_stats.chunksRemeshed++;
+    upload_chunk_mesh(chunk, &g_scratch_mesh);
+    return TRUE;
+}
+
+void set_chunk_lod_projection(float fovYDegrees, int viewportHeight) {
+    if (fovYDegrees <= 0.0f || viewportHeight <= 0) return;
+    g_lod_pixels_per_unit = viewportHeight / (2.0f * tanf(deg_to_rad(fovYDegrees) * 0.5f));
+}
+
+void set_chunk_render_view(const float view[16], const float projection[16]) {
+    if (!view || !projection) return;
+    memcpy(g_chunk_view, view, sizeof(g_chunk_view));
+    memcpy(g_chunk_projection, projection, sizeof(g_chunk_projection));
+}
+
+void set_chunk_render_lighting(ShaderLighting lighting) {
+    g_chunk_lighting = lighting;
+}
+
+// Pick every chunk's level of detail by screen-space error, medido en el punto de su caja
+// más cercano a la cámara. Un cambio marca el chunk y sus vecinos de cara para remesh, así
+// el nuevo nivel sale por el mismo camino (workers) que cualquier otro remesh.
+static void update_chunk_lods(ChunkManager* manager, Vect3 cameraPosition) {
+    for (int i = 0; i < manager->maxChunks; i++) {
+        VoxelChunk* chunk = manager->chunks[i];
+        if (!chunk || !chunk->isGenerated) continue;
+
+        float minX = chunk->chunkX * CHUNK_SIZE - 0.5f;
+        float minY = chunk->chunkY * CHUNK_SIZE - 0.5f;
+        float minZ = chunk->chunkZ * CHUNK_SIZE - 0.5f;
+        float dx = fmaxf(fmaxf(minX - cameraPosition.x, cameraPosition.x - (minX + CHUNK_SIZE)), 0.0f);
+        float dy = fmaxf(fmaxf(minY - cameraPosition.y, cameraPosition.y - (minY + CHUNK_SIZE)), 0.0f);
+        float dz = fmaxf(fmaxf(minZ - cameraPosition.z, cameraPosition.z - (minZ + CHUNK_SIZE)), 0.0f);
+        chunk->distanceToCamera = sqrtf(dx * dx + dy * dy + dz * dz);
+
+        int lod = select_chunk_lod(chunk->distanceToCamera, g_lod_pixels_per_unit, chunk->lodLevel);
+        if (lod != chunk->lodLevel) {
+            set_chunk_lod(chunk, lod);
+            g_chunk_render_stats.lodChanges++;
+        }
+    }
+}
+
+// Snapshot every chunk that needs a mesh and hand it to the workers, hasta gastar el
+// presupuesto de tiempo del frame; el resto espera al siguiente (needsRemesh sigue activo)
+static void submit_chunk_mesh_jobs(ChunkManager* manager) {
+    LARGE_INTEGER freq, start, now;
+    QueryPerformanceFrequency(&freq);
+    QueryPerformanceCounter(&start);
+    LONGLONG budget = freq.QuadPart * CHUNK_SNAPSHOT_BUDGET_US / 1000000;
+
+    for (int i = 0; i < manager->maxChunks; i++) {
+        VoxelChunk* chunk = manager->chunks[i];
+        if (!chunk || !chunk->isGenerated) continue;
+        if (chunk->hasMesh && !chunk->needsRemesh) continue;
+        if (!chunk->needsRemesh && chunk->meshRevision) continue;  // Primer mesh ya en camino
+
+        if (!submit_chunk_mesh_job(chunk)) break;  // Sin trabajos libres
+        g_chunk_render_stats.meshJobsSubmitted++;
+
+        QueryPerformanceCounter(&now);
+        if (now.QuadPart - start.QuadPart > budget) break;
+    }
+}
+
+// Upload finished meshes until the frame's byte budget runs out (al menos uno por frame)
+static void upload_finished_chunk_meshes(ChunkManager* manager) {
+    ChunkMeshJob* job;
+    while (g_chunk_render_stats.uploadedBytes < CHUNK_UPLOAD_BUDGET_BYTES && (job = poll_chunk_mesh_job()) != NULL) {
+        VoxelChunk* chunk = find_chunk_mesh_job_target(manager, job);
+        if (chunk && job->built) {
+            g_chunk_render_stats.chunksRemeshed++;
+            upload_chunk_mesh(chunk, &job->mesh);
+        } else if (chunk) {
+            chunk->needsRemesh = TRUE;  // Sin memoria en el worker: se reintenta
+        }
+        release_chunk_mesh_job(job);
+    }
+}
+
+// Grow the per-pass draw lists to hold count chunks
+static BOOL reserve_draw_lists(int count) {
+    if (count <= g_draw_capacity) return TRUE;
+
+    int capacity = g_draw_capacity ? g_draw_capacity : 256;
+    while (capacity < count) capacity *= 2;
+    ChunkDrawEntry* entries = safe_malloc(capacity * sizeof(ChunkDrawEntry));
+    ChunkDrawCommand* commands = safe_malloc(capacity * sizeof(ChunkDrawCommand));
+    GLsizei* counts = safe_malloc(capacity * sizeof(GLsizei));
+    const void** offsets = safe_malloc(capacity * sizeof(const void*));
+    GLint* baseVertices = safe_malloc(capacity * sizeof(GLint));
+    int* sources = safe_malloc(capacity * sizeof(int));
+    if (!entries || !commands || !counts || !offsets || !baseVertices || !sources) {
+        safe_free(entries);
+        safe_free(commands);
+        safe_free(counts);
+        safe_free((void*)offsets);
+        safe_free(baseVertices);
+        safe_free(sources);
+        return FALSE;
+    }
+
+    if (g_draw_entries) memcpy(entries, g_draw_entries, g_draw_capacity * sizeof(ChunkDrawEntry));
+    safe_free(g_draw_entries);
+    safe_free(g_draw_commands);
+    safe_free(g_draw_counts);
+    safe_free((void*)g_draw_offsets);
+    safe_free(g_draw_base_vertices);
+    safe_free(g_draw_sources);
+    g_draw_entries = entries;
+    g_draw_commands = commands;
+    g_draw_counts = counts;
+    g_draw_offsets = offsets;
+    g_draw_base_vertices = baseVertices;
+    g_draw_sources = sources;
+    g_draw_capacity = capacity;
+    return TRUE;
+}
+
+static int compare_draw_regions(const void* a, const void* b) {
+    uint64 ra = ((const ChunkDrawEntry*)a)->region;
+    uint64 rb = ((const ChunkDrawEntry*)b)->region;
+    return (ra > rb) - (ra < rb);
+}
+
+// Draw one layer of the listed chunks. Las entradas seguidas de la misma región comparten
+// origen y van en una sola llamada multi-draw; el orden de la lista se respeta.
+static void draw_chunk_layer(int count, ChunkRenderLayer layer) {
+    int commandCount = 0;
+    for (int i = 0; i < count; i++) {
+        VoxelChunk* chunk = g_draw_entries[i].chunk;
+        int indexCount = chunk->meshLayerIndexCount[layer];
+        if (indexCount <= 0) continue;
+
+        ChunkDrawCommand* command = &g_draw_commands[commandCount];
+        command->count = (GLuint)indexCount;
+        command->instanceCount = 1;
+        command->firstIndex = layer == CHUNK_LAYER_TRANSLUCENT ? chunk->meshTranslucentOffset : chunk->meshIndexOffset;
+        if (layer == CHUNK_LAYER_CUTOUT) command->firstIndex += (GLuint)chunk->meshLayerIndexCount[CHUNK_LAYER_OPAQUE];
+        command->baseVertex = (GLint)chunk->meshVertexOffset;
+        command->baseInstance = 0;
+        g_draw_counts[commandCount] = indexCount;
+        g_draw_offsets[commandCount] = (const void*)((size_t)command->firstIndex * sizeof(uint16));
+        g_draw_base_vertices[commandCount] = command->baseVertex;
+        g_draw_sources[commandCount] = i;
+        g_chunk_render_stats.trianglesDrawn += indexCount / 3;
+        commandCount++;
+    }
+    if (commandCount == 0) return;
+    g_chunk_render_stats.chunkDraws += commandCount;
+
+    if (g_draw_path == CHUNK_DRAW_INDIRECT) {
+        glBindBuffer(GL_DRAW_INDIRECT_BUFFER, g_chunk_arena.indirectBuffer);
+        glBufferData(GL_DRAW_INDIRECT_BUFFER, commandCount * sizeof(ChunkDrawCommand), g_draw_commands, GL_STREAM_DRAW);
+    }
+
+    for (int start = 0; start < commandCount;) {
+        uint64 region = g_draw_entries[g_draw_sources[start]].region;
+        int end = start + 1;
+        while (end < commandCount && g_draw_entries[g_draw_sources[end]].region == region) end++;
+
+        // Esquinas locales a la región: el bloque (x, y, z) está centrado en origen + (x, y, z)
+        const VoxelChunk* first = g_draw_entries[g_draw_sources[start]].chunk;
+        glUniform3f(g_uniform_region_origin,
+                    (float)((first->chunkX >> CHUNK_REGION_SHIFT) * CHUNK_REGION_SIZE * CHUNK_SIZE) - 0.5f,
+                    (float)((first->chunkY >> CHUNK_REGION_SHIFT) * CHUNK_REGION_SIZE * CHUNK_SIZE) - 0.5f,
+                    (float)((first->chunkZ >> CHUNK_REGION_SHIFT) * CHUNK_REGION_SIZE * CHUNK_SIZE) - 0.5f);
+
+        if (g_draw_path == CHUNK_DRAW_INDIRECT) {
+            glMultiDrawElementsIndirect(GL_TRIANGLES, GL_UNSIGNED_SHORT,
+                                        (const void*)(start * sizeof(ChunkDrawCommand)), end - start, 0);
+            g_chunk_render_stats.drawCalls++;
+        } else if (g_draw_path == CHUNK_DRAW_BASE_VERTEX) {
+            glMultiDrawElementsBaseVertex(GL_TRIANGLES, g_draw_counts + start, GL_UNSIGNED_SHORT,
+                                          g_draw_offsets + start, end - start, g_draw_base_vertices + start);
+            g_chunk_render_stats.drawCalls++;
+        } else {
+            // Sin vértice base: el puntero de vértices se mueve al primero del chunk
+            for (int i = start; i < end; i++) {
+                size_t base = (size_t)g_draw_base_vertices[i] * sizeof(ChunkVertex);
+                glVertexAttribPointer(g_attrib_packed0, 4, GL_UNSIGNED_BYTE, GL_FALSE, sizeof(ChunkVertex),
+                                      (const void*)(base + offsetof(ChunkVertex, position)));
+                glVertexAttribPointer(g_attrib_packed1, 4, GL_UNSIGNED_BYTE, GL_FALSE, sizeof(ChunkVertex),
+                                      (const void*)(base + offsetof(ChunkVertex, material)));
+                glDrawElements(GL_TRIANGLES, g_draw_counts[i], GL_UNSIGNED_SHORT, g_draw_offsets[i]);
+                g_chunk_render_stats.drawCalls++;
+            }
+        }
+        start = end;
+    }
+
+    if (g_draw_path == CHUNK_DRAW_INDIRECT) glBindBuffer(GL_DRAW_INDIRECT_BUFFER, 0);
+}
+
+// Rewrite the chunk's translucent indices back to front if the camera moved to another block
+// cell since the last sort (dentro de una celda el orden de caras de bloque no cambia)
+static void sort_chunk_translucent_layer(VoxelChunk* chunk, const int cameraCell[3]) {
+    if (chunk->sortedCell[0] == cameraCell[0] && chunk->sortedCell[1] == cameraCell[1] &&
+        chunk->sortedCell[2] == cameraCell[2]) {
+        return;
+    }
+
+    // Ojo en medias unidades locales: el bloque c tiene su centro en 2c + 1
+    int eye[3] = {
+        2 * (cameraCell[0] - chunk->chunkX * CHUNK_SIZE) + 1,
+        2 * (cameraCell[1] - chunk->chunkY * CHUNK_SIZE) + 1,
+        2 * (cameraCell[2] - chunk->chunkZ * CHUNK_SIZE) + 1
+    };
+    sort_translucent_quads(chunk->translucentQuads, chunk->translucentQuadCount, eye, g_sorted_indices);
+    glBufferSubData(GL_ELEMENT_ARRAY_BUFFER, (GLintptr)chunk->meshTranslucentOffset * sizeof(uint16),
+                    chunk->translucentQuadCount * 6 * sizeof(uint16), g_sorted_indices);
+
+    memcpy(chunk->sortedCell, cameraCell, sizeof(chunk->sortedCell));
+    g_chunk_render_stats.translucentResorts++;
+}
+
+struct TranslucentChunkEntry {
+    VoxelChunk* chunk;
+    float distanceSq;
+};
+
+static int compare_translucent_chunks(const void* a, const void* b) {
+    float da = ((const TranslucentChunkEntry*)a)->distanceSq;
+    float db = ((const TranslucentChunkEntry*)b)->distanceSq;
+    return (da < db) - (da > db);  // El más lejano primero
+}
+
+// Translucent pass: chunks y quads de atrás hacia delante, con mezcla y sin escribir profundidad
+static void render_translucent_layer(ChunkManager* manager, Vect3 cameraPosition) {
+    int count = 0;
+    for (int i = 0; i < manager->maxChunks; i++) {
+        VoxelChunk* chunk = manager->chunks[i];
+        if (!chunk || !chunk->meshLayerIndexCount[CHUNK_LAYER_TRANSLUCENT] || !chunk->isVisible) continue;
+
+        if (count == g_translucent_chunk_capacity) {
+            int capacity = g_translucent_chunk_capacity ? g_translucent_chunk_capacity * 2 : 64;
+            TranslucentChunkEntry* grown = safe_malloc(capacity * sizeof(TranslucentChunkEntry));
+            if (!grown) break;
+            if (g_translucent_chunks) {
+                memcpy(grown, g_translucent_chunks, count * sizeof(TranslucentChunkEntry));
+                safe_free(g_translucent_chunks);
+            }
+            g_translucent_chunks = grown;
+            g_translucent_chunk_capacity = capacity;
+        }
+
+        float dx = chunk->chunkX * CHUNK_SIZE + CHUNK_SIZE * 0.5f - 0.5f - cameraPosition.x;
+        float dy = chunk->chunkY * CHUNK_SIZE + CHUNK_SIZE * 0.5f - 0.5f - cameraPosition.y;
+        float dz = chunk->chunkZ * CHUNK_SIZE + CHUNK_SIZE * 0.5f - 0.5f - cameraPosition.z;
+        g_translucent_chunks[count].chunk = chunk;
+        g_translucent_chunks[count].distanceSq = dx * dx + dy * dy + dz * dz;
+        count++;
+    }
+    if (count == 0 || !reserve_draw_lists(count)) return;
+
+    qsort(g_translucent_chunks, count, sizeof(TranslucentChunkEntry), compare_translucent_chunks);
+    g_chunk_render_stats.translucentChunks = count;
+
+    int cameraCell[3] = {
+        (int)floorf(cameraPosition.x + 0.5f),
+        (int)floorf(cameraPosition.y + 0.5f),
+        (int)floorf(cameraPosition.z + 0.5f)
+    };
+
+    // Orden de atrás hacia delante; solo se juntan en una llamada los seguidos de una región
+    for (int i = 0; i < count; i++) {
+        VoxelChunk* chunk = g_translucent_chunks[i].chunk;
+        sort_chunk_translucent_layer(chunk, cameraCell);
+        g_draw_entries[i].chunk = chunk;
+        g_draw_entries[i].region = chunk_region_key(chunk);
+    }
+
+    // Se ven las dos caras del agua y el cristal; sin escribir profundidad lo de detrás sigue visible
+    GLboolean blend = glIsEnabled(GL_BLEND);
+    GLboolean cull = glIsEnabled(GL_CULL_FACE);
+    glEnable(GL_BLEND);
+    glBlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
+    glDepthMask(GL_FALSE);
+    if (cull) glDisable(GL_CULL_FACE);
+
+    draw_chunk_layer(count, CHUNK_LAYER_TRANSLUCENT);
+
+    glDepthMask(GL_TRUE);
+    if (!blend) glDisable(GL_BLEND);
+    if (cull) glEnable(GL_CULL_FACE);
+}
+
+void render_chunk_meshes(ChunkManager* manager, Vect3 cameraPosition, const Frustum* frustum) {
+    if (!manager) return;
+    if (!g_chunk_renderer_ready && !init_chunk_renderer(manager)) return;
+    g_chunk_manager = manager;
+
+    g_chunk_render_stats.drawCalls = 0;
+    g_chunk_render_stats.chunkDraws = 0;
+    g_chunk_render_stats.chunksRemeshed = 0;
+    g_chunk_render_stats.trianglesDrawn = 0;
+    g_chunk_render_stats.uploadedBytes = 0;
+    g_chunk_render_stats.meshJobsSubmitted = 0;
+    g_chunk_render_stats.translucentChunks = 0;
+    g_chunk_render_stats.translucentResorts = 0;
+    g_chunk_render_stats.lodChanges = 0;
+    memset(g_chunk_render_stats.lodChunks, 0, sizeof(g_chunk_render_stats.lodChunks));
+
+    // Las ediciones del frame se aplican juntas: un remesh por chunk tocado
+    g_chunk_render_stats.editsApplied = manager->queuedEdits;
+    g_chunk_render_stats.chunksEdited = flush_remesh_queue(manager);
+    update_chunk_lods(manager, cameraPosition);
+
+    ChunkCullStats cullStats = update_chunk_frustum_visibility(manager, frustum);
+    g_chunk_render_stats.chunksTested = cullStats.tested;
+    g_chunk_render_stats.chunksCulled = cullStats.tested - cullStats.visible;
+    g_chunk_render_stats.chunksCaveCulled = update_chunk_cave_visibility(manager, cameraPosition);
+    ChunkOcclusionStats occlusionStats = update_chunk_occlusion(manager, cameraPosition, frustum);
+    g_chunk_render_stats.chunksOccluded = occlusionStats.occluded;
+    g_chunk_render_stats.occluderFaces = occlusionStats.occluderFaces;
+
+    // Con workers el hilo principal solo copia snapshots y sube resultados; mientras llega
+    // el mesh nuevo se sigue dibujando el anterior
+    BOOL asyncMeshing = chunk_mesh_workers_running();
+    if (asyncMeshing) {
+        submit_chunk_mesh_jobs(manager);
+        upload_finished_chunk_meshes(manager);
+        g_chunk_render_stats.meshJobsInFlight = get_chunk_mesh_jobs_in_flight();
+    }
+
+    // Visible chunks with geometry (y remesh síncrono si no hay workers), agrupados por región
+    int count = 0;
+    for (int i = 0; i < manager->maxChunks; i++) {
+        VoxelChunk* chunk = manager->chunks[i];
+        if (!chunk || !chunk->isGenerated) continue;
+
+        if (!asyncMeshing) update_chunk_mesh(chunk);
+        if (!chunk->meshIndexCount || !chunk->isVisible) continue;
+        if (!reserve_draw_lists(count + 1)) break;
+        g_draw_entries[count].region = chunk_region_key(chunk);
+        g_draw_entries[count].chunk = chunk;
+        g_chunk_render_stats.lodChunks[chunk->meshLod]++;
+        count++;
+    }
+    qsort(g_draw_entries, count, sizeof(ChunkDrawEntry), compare_draw_regions);
+
+    // Los chunks ya están en coordenadas de mundo: modelo identidad
+    float model[16];
+    create_model_matrix(model, vect3_create(0, 0, 0), vect3_create(1, 1, 1), vect3_create(0, 0, 0));
+    glUseProgram(g_chunk_shader.program);
+    set_shader_matrices(g_chunk_uniforms, model, g_chunk_view, g_chunk_projection);
+    set_shader_lighting(g_chunk_uniforms, g_chunk_lighting);
+    set_shader_fog(g_chunk_uniforms, g_chunk_lighting.fogDensity, g_chunk_lighting.fogColor, g_chunk_lighting.fogIntensity);
+
+    // Each uint32 of ChunkVertex as 4 raw bytes (sin normalizar), decoded by the shader. Con
+    // multi-draw los punteros no cambian en todo el frame: el vértice base va en cada comando.
+    glBindBuffer(GL_ARRAY_BUFFER, g_chunk_arena.vertexBuffer);
+    glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, g_chunk_arena.indexBuffer);
+    glEnableVertexAttribArray(g_attrib_packed0);
+    glEnableVertexAttribArray(g_attrib_packed1);
+    glVertexAttribPointer(g_attrib_packed0, 4, GL_UNSIGNED_BYTE, GL_FALSE, sizeof(ChunkVertex),
+                          (const void*)offsetof(ChunkVertex, position));
+    glVertexAttribPointer(g_attrib_packed1, 4, GL_UNSIGNED_BYTE, GL_FALSE, sizeof(ChunkVertex),
+                          (const void*)offsetof(ChunkVertex, material));
+
+    // Opaque pass, luego el recortado: las hojas van tras las caras opacas en el mismo rango,
+    // sin culling de caras porque dejan ver las de dentro de la copa
+    draw_chunk_layer(count, CHUNK_LAYER_OPAQUE);
+    GLboolean cull = glIsEnabled(GL_CULL_FACE);
+    if (cull) glDisable(GL_CULL_FACE);
+    draw_chunk_layer(count, CHUNK_LAYER_CUTOUT);
+    if (cull) glEnable(GL_CULL_FACE);
+
+    render_translucent_layer(manager, cameraPosition);
+
+    glBindBuffer(GL_ARRAY_BUFFER, 0);
+    glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, 0);
+    glDisableVertexAttribArray(g_attrib_packed0);
+    glDisableVertexAttribArray(g_attrib_packed1);
+    glUseProgram(0);
+}
+
+const ChunkRenderStats* get_chunk_render_stats(void) {
+    return &g_chunk_render_stats;
+}
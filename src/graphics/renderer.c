@@ -1,6 +1,7 @@
 #include "world/chunk_system.h"  // Include first to avoid circular dependency
 #include "graphics/renderer.h"
 #include "graphics/window.h"
+#include "graphics/chunk_renderer.h"
 #include "graphics/effects/Volumetrics.h"
 #include "graphics/effects/Shadow.h"
 #include <stdio.h>
@@ -19,6 +20,7 @@ static Player* g_player = NULL;
 static RenderLight g_render_lights[4] = {0};
 static int g_render_light_count = 2;
 static RenderFog g_render_fog = {0};
+static Frustum g_view_frustum;  // Frustum of the current frame, mismos valores que las matrices de begin_frame
 
 // Volumetric effects
 static VolumetricSystem* g_volumetric_system = NULL;
@@ -503,19 +505,24 @@ void begin_frame() {
     glMatrixMode(GL_PROJECTION);
     glLoadIdentity();
     
+    // Las mismas matrices van al shader de chunks y al pipeline fijo (hitbox, HUD, efectos)
     float aspect = (float)g_renderer_context.width / (float)g_renderer_context.height;
-    gluPerspective(g_render_camera.fov, aspect, g_render_camera.nearPlane, g_render_camera.farPlane);
+    float projectionMatrix[16], viewMatrix[16];
+    create_projection_matrix(projectionMatrix, g_render_camera.fov, aspect, g_render_camera.nearPlane, g_render_camera.farPlane);
+    glLoadMatrixf(projectionMatrix);
+    set_chunk_lod_projection(g_render_camera.fov, g_renderer_context.height);
     
     // Set up modelview matrix
     glMatrixMode(GL_MODELVIEW);
     glLoadIdentity();
     
     // Set up camera
-    gluLookAt(
-        g_render_camera.position.x, g_render_camera.position.y, g_render_camera.position.z,
-        g_render_camera.target.x, g_render_camera.target.y, g_render_camera.target.z,
-        g_render_camera.up.x, g_render_camera.up.y, g_render_camera.up.z
-    );
+    create_view_matrix(viewMatrix, g_render_camera.position, g_render_camera.target, g_render_camera.up);
+    glLoadMatrixf(viewMatrix);
+    set_chunk_render_view(viewMatrix, projectionMatrix);
+    frustum_from_camera(&g_view_frustum, g_render_camera.position, g_render_camera.target, g_render_camera.up,
+                        g_render_camera.fov, aspect, g_render_camera.nearPlane, g_render_camera.farPlane);
+    record_camera_frame(g_render_camera.position, g_render_camera.target, g_render_camera.up);
     
     // Enable lighting
     glEnable(GL_LIGHTING);
@@ -619,6 +626,19 @@ void render_test_environment() {
     glLightfv(GL_LIGHT1, GL_DIFFUSE, light1_diff);
     glLightfv(GL_LIGHT1, GL_AMBIENT, light1_amb);
     
+    // Chunk shader: el sol de arriba y el ambiente de estas luces (modelo 0.2 + 0.3 + 0.1),
+    // más la niebla de la escena repartida en su radio
+    ShaderLighting chunkLighting = {
+        render_vect3_create(0.0f, 0.0f, -1.0f),  // Hacia abajo, como light0
+        (Color){255, 255, 255},
+        0.6f,
+        (Color){204, 204, 204},                  // light0_diff
+        g_render_fog.enabled ? g_render_fog.density / g_render_fog.radius : 0.0f,
+        g_render_fog.color,
+        1.0f
+    };
+    set_chunk_render_lighting(chunkLighting);
+    
     // Test cube removed - only render procedural chunks
     
     // Render chunks with procedural colors
@@ -626,83 +646,9 @@ void render_test_environment() {
     if (gameState && gameState->chunkManager) {
         ChunkManager* manager = gameState->chunkManager;
         
-        for (int i = 0; i < manager->maxChunks; i++) {
-            if (manager->chunks[i] && manager->chunks[i]->isGenerated) {
-                VoxelChunk* chunk = manager->chunks[i];
-                
-                // Render each block in the chunk - TODAS LAS CAPAS (incluyendo árboles)
-                for (int x = 0; x < 16; x++) {
-                    for (int y = 0; y < 16; y++) {
-                        for (int z = 0; z < 16; z++) {
-                            VoxelBlock* block = &chunk->blocks[x][y][z];
-                            
-                            if (block->type != VOXEL_AIR && block->isVisible) {
-                                // Calculate world position
-                                float worldX = chunk->chunkX * 16 + x;
-                                float worldY = chunk->chunkY * 16 + y;
-                                float worldZ = (float)z; // Renderizar en la posición correcta del bloque (z=0 para el suelo)
-                                
-                                glPushMatrix();
-                                glTranslatef(worldX, worldY, worldZ);
-                                
-                                // Use the block's random color
-                                glColor3f(block->color.r / 255.0f, 
-                                         block->color.g / 255.0f, 
-                                         block->color.b / 255.0f);
-                                
-                                // Render block as a cube
-                                glBegin(GL_QUADS);
-                                
-                                // Top face
-                                glNormal3f(0, 0, 1);
-                                glVertex3f(-0.5f, -0.5f, 0.5f);
-                                glVertex3f(0.5f, -0.5f, 0.5f);
-                                glVertex3f(0.5f, 0.5f, 0.5f);
-                                glVertex3f(-0.5f, 0.5f, 0.5f);
-                                
-                                // Bottom face
-                                glNormal3f(0, 0, -1);
-                                glVertex3f(-0.5f, -0.5f, -0.5f);
-                                glVertex3f(-0.5f, 0.5f, -0.5f);
-                                glVertex3f(0.5f, 0.5f, -0.5f);
-                                glVertex3f(0.5f, -0.5f, -0.5f);
-                                
-                                // Front face
-                                glNormal3f(0, 1, 0);
-                                glVertex3f(-0.5f, 0.5f, -0.5f);
-                                glVertex3f(-0.5f, 0.5f, 0.5f);
-                                glVertex3f(0.5f, 0.5f, 0.5f);
-                                glVertex3f(0.5f, 0.5f, -0.5f);
-                                
-                                // Back face
-                                glNormal3f(0, -1, 0);
-                                glVertex3f(-0.5f, -0.5f, -0.5f);
-                                glVertex3f(0.5f, -0.5f, -0.5f);
-                                glVertex3f(0.5f, -0.5f, 0.5f);
-                                glVertex3f(-0.5f, -0.5f, 0.5f);
-                                
-                                // Right face
-                                glNormal3f(1, 0, 0);
-                                glVertex3f(0.5f, -0.5f, -0.5f);
-                                glVertex3f(0.5f, 0.5f, -0.5f);
-                                glVertex3f(0.5f, 0.5f, 0.5f);
-                                glVertex3f(0.5f, -0.5f, 0.5f);
-                                
-                                // Left face
-                                glNormal3f(-1, 0, 0);
-                                glVertex3f(-0.5f, -0.5f, -0.5f);
-                                glVertex3f(-0.5f, -0.5f, 0.5f);
-                                glVertex3f(-0.5f, 0.5f, 0.5f);
-                                glVertex3f(-0.5f, 0.5f, -0.5f);
-                                
-                                glEnd();
-                                glPopMatrix();
-                            }
-                        }
-                    }
-                }
-            }
-        }
+        // Un VBO por chunk, reconstruido solo cuando needsRemesh está activo; la capa
+        // translúcida se ordena desde la cámara y los chunks fuera del frustum no se dibujan
+        render_chunk_meshes(manager, g_render_camera.position, &g_view_frustum);
     }
     
             // Render player hitbox (transparent cube)
@@ -799,43 +745,25 @@ void player_set_movement_input(Player* player, float forward, float right, float
     }
 }
 
-// Helper function to check if a block is solid
+// Floor division of a world block coordinate into its chunk coordinate
+static int world_to_chunk_coord(int worldCoord) {
+    int chunkCoord = worldCoord / 16;
+    if (worldCoord % 16 < 0) chunkCoord--;
+    return chunkCoord;
+}
+
+// Helper function to check if a block is solid (occupancy bit test)
 static BOOL is_block_solid_at(ChunkManager* manager, int worldX, int worldY, int worldZ) {
     if (!manager) return FALSE;
     
-    // Calculate chunk coordinates
-    int chunkX = worldX / 16;
-    int chunkY = worldY / 16;
-    int chunkZ = worldZ / 16;
-    
-    // Calculate local block coordinates within chunk
-    int localX = worldX % 16;
-    int localY = worldY % 16;
-    int localZ = worldZ % 16;
-    
-    // Handle negative coordinates correctly
-    if (localX < 0) { localX += 16; chunkX--; }
-    if (localY < 0) { localY += 16; chunkY--; }
-    if (localZ < 0) { localZ += 16; chunkZ--; }
+    int chunkX = world_to_chunk_coord(worldX);
+    int chunkY = world_to_chunk_coord(worldY);
+    int chunkZ = world_to_chunk_coord(worldZ);
     
-    // Find the chunk
-    for (int i = 0; i < manager->loadedChunks; i++) {
-        VoxelChunk* chunk = manager->chunks[i];
-        if (chunk && chunk->chunkX == chunkX && chunk->chunkY == chunkY && chunk->chunkZ == chunkZ) {
-            VoxelBlock* block = &chunk->blocks[localX][localY][localZ];
-            
-            // Check if block is solid using blueprints
-            BlockBlueprint* blueprints = create_block_blueprints();
-            if (blueprints) {
-                BlockBlueprint* blueprint = get_block_blueprint(blueprints, block->type);
-                if (blueprint) {
-                    return blueprint->isSolid;
-                }
-            }
-        }
-    }
+    VoxelChunk* chunk = find_chunk(manager, chunkX, chunkY, chunkZ);
+    if (!chunk || is_chunk_empty(chunk)) return FALSE; // No chunk found or all air
     
-    return FALSE; // No chunk found or block is air
+    return is_chunk_block_solid(chunk, worldX - chunkX * 16, worldY - chunkY * 16, worldZ - chunkZ * 16);
 }
 
 // Helper function to check collision with blocks in a region
@@ -850,11 +778,28 @@ static BOOL check_collision_with_blocks(ChunkManager* manager, Vect3 position, f
     int minZ = (int)floorf(position.z);
     int maxZ = (int)ceilf(position.z + depth);
     
-    for (int x = minX; x <= maxX; x++) {
-        for (int y = minY; y <= maxY; y++) {
-            for (int z = minZ; z <= maxZ; z++) {
-                if (is_block_solid_at(manager, x, y, z)) {
-                    return TRUE; // Collision detected
+    // One lookup per overlapped chunk, then test whole Z ranges of each column at once
+    for (int cx = world_to_chunk_coord(minX); cx <= world_to_chunk_coord(maxX); cx++) {
+        for (int cy = world_to_chunk_coord(minY); cy <= world_to_chunk_coord(maxY); cy++) {
+            for (int cz = world_to_chunk_coord(minZ); cz <= world_to_chunk_coord(maxZ); cz++) {
+                VoxelChunk* chunk = find_chunk(manager, cx, cy, cz);
+                if (!chunk || is_chunk_empty(chunk)) continue;
+                
+                // Box overlap in local coordinates
+                int x0 = minX - cx * 16 < 0 ? 0 : minX - cx * 16;
+                int x1 = maxX - cx * 16 > 15 ? 15 : maxX - cx * 16;
+                int y0 = minY - cy * 16 < 0 ? 0 : minY - cy * 16;
+                int y1 = maxY - cy * 16 > 15 ? 15 : maxY - cy * 16;
+                int z0 = minZ - cz * 16 < 0 ? 0 : minZ - cz * 16;
+                int z1 = maxZ - cz * 16 > 15 ? 15 : maxZ - cz * 16;
+                uint16 zBits = (uint16)(((1u << (z1 - z0 + 1)) - 1u) << z0);
+                
+                for (int x = x0; x <= x1; x++) {
+                    for (int y = y0; y <= y1; y++) {
+                        if (chunk->solidMask[x][y] & zBits) {
+                            return TRUE; // Collision detected
+                        }
+                    }
                 }
             }
         }
@@ -1033,12 +978,9 @@ BlockSelection raycast_from_camera(RenderCamera* camera, ChunkManager* manager,
         int localY = voxelY % 16; if (localY < 0) { localY += 16; chunkY--; }
         int localZ = voxelZ % 16; if (localZ < 0) { localZ += 16; chunkZ--; }
         
-        for (int j = 0; j < manager->loadedChunks; j++) {
-            VoxelChunk* chunk = manager->chunks[j];
-            if (chunk && chunk->chunkX == chunkX && chunk->chunkY == chunkY && chunk->chunkZ == chunkZ) {
-                selection.blockType = chunk->blocks[localX][localY][localZ].type;
-                break;
-            }
+        VoxelChunk* chunk = find_chunk(manager, chunkX, chunkY, chunkZ);
+        if (chunk) {
+            selection.blockType = get_block_type(chunk, localX, localY, localZ);
         }
         
         return selection;
@@ -1062,11 +1004,30 @@ BlockSelection raycast_from_camera(RenderCamera* camera, ChunkManager* manager,
     // Last face normal (for placing blocks)
     int faceX = 0, faceY = 0, faceZ = 0;
     
+    // Chunk the ray is currently crossing: looked up once, then voxels are bit tests
+    int rayChunkX = world_to_chunk_coord(voxelX);
+    int rayChunkY = world_to_chunk_coord(voxelY);
+    int rayChunkZ = world_to_chunk_coord(voxelZ);
+    VoxelChunk* rayChunk = find_chunk(manager, rayChunkX, rayChunkY, rayChunkZ);
+    
     // Traverse ray through voxels with precise intersection detection
     float t = 0;
     for (int i = 0; i < 200 && t < maxDistance; i++) {
-        // Check if current voxel is solid
-        if (is_block_solid_at(manager, voxelX, voxelY, voxelZ)) {
+        int voxelChunkX = world_to_chunk_coord(voxelX);
+        int voxelChunkY = world_to_chunk_coord(voxelY);
+        int voxelChunkZ = world_to_chunk_coord(voxelZ);
+        if (voxelChunkX != rayChunkX || voxelChunkY != rayChunkY || voxelChunkZ != rayChunkZ) {
+            // The DDA moves one voxel at a time, so the next chunk is a cached neighbour link
+            rayChunk = rayChunk ? get_chunk_neighbor(rayChunk, voxelChunkX - rayChunkX, voxelChunkY - rayChunkY, voxelChunkZ - rayChunkZ)
+                                : find_chunk(manager, voxelChunkX, voxelChunkY, voxelChunkZ);
+            rayChunkX = voxelChunkX;
+            rayChunkY = voxelChunkY;
+            rayChunkZ = voxelChunkZ;
+        }
+        
+        // Check if current voxel is solid (all-air chunks are skipped)
+        if (rayChunk && !is_chunk_empty(rayChunk) &&
+            is_chunk_block_solid(rayChunk, voxelX - rayChunkX * 16, voxelY - rayChunkY * 16, voxelZ - rayChunkZ * 16)) {
             selection.hit = TRUE;
             selection.blockX = voxelX;
             selection.blockY = voxelY;
@@ -1087,20 +1048,8 @@ BlockSelection raycast_from_camera(RenderCamera* camera, ChunkManager* manager,
             // Don't continue traversing through blocks
             
             // Get block type
-            int chunkX = voxelX / 16;
-            int chunkY = voxelY / 16;
-            int chunkZ = voxelZ / 16;
-            int localX = voxelX % 16; if (localX < 0) { localX += 16; chunkX--; }
-            int localY = voxelY % 16; if (localY < 0) { localY += 16; chunkY--; }
-            int localZ = voxelZ % 16; if (localZ < 0) { localZ += 16; chunkZ--; }
-            
-            for (int j = 0; j < manager->loadedChunks; j++) {
-                VoxelChunk* chunk = manager->chunks[j];
-                if (chunk && chunk->chunkX == chunkX && chunk->chunkY == chunkY && chunk->chunkZ == chunkZ) {
-                    selection.blockType = chunk->blocks[localX][localY][localZ].type;
-                    break;
-                }
-            }
+            selection.blockType = get_block_type(rayChunk, voxelX - rayChunkX * 16,
+                                                 voxelY - rayChunkY * 16, voxelZ - rayChunkZ * 16);
             
             return selection;
         }
@@ -1183,8 +1132,9 @@ void render_block_selection(BlockSelection* selection) {
 BOOL is_surface_block(ChunkManager* manager, int worldX, int worldY, int worldZ) {
     if (!manager) return FALSE;
     
-    // Check if this is the topmost solid block at this X,Y position
-    for (int z = worldZ + 1; z < 16; z++) {
+    // Check if this is the topmost solid block at this X,Y position (hasta el techo del mundo)
+    int worldTop = manager->maxChunkZ * 16 + 15;
+    for (int z = worldZ + 1; z <= worldTop; z++) {
         if (is_block_solid_at(manager, worldX, worldY, z)) {
             return FALSE; // There's a block above, so this isn't surface
         }
@@ -1205,72 +1155,39 @@ void rerender_terrain_below(ChunkManager* manager, int worldX, int worldY, int w
     printf("Re-rendering terrain below (%d,%d,%d)\n", worldX, worldY, worldZ);
     
     // Find the chunk
-    int chunkX = worldX / 16;
-    int chunkY = worldY / 16;
-    int chunkZ = worldZ / 16;
-    
-    // Handle negative coordinates
-    if (worldX < 0) chunkX--;
-    if (worldY < 0) chunkY--;
-    if (worldZ < 0) chunkZ--;
-    
-    for (int i = 0; i < manager->loadedChunks; i++) {
-        VoxelChunk* chunk = manager->chunks[i];
-        if (chunk && chunk->chunkX == chunkX && chunk->chunkY == chunkY && chunk->chunkZ == chunkZ) {
-            int localX = worldX % 16; if (localX < 0) localX += 16;
-            int localY = worldY % 16; if (localY < 0) localY += 16;
-            int localZ = worldZ % 16; if (localZ < 0) localZ += 16;
-            
-            // Re-render blocks below the broken surface block
-            for (int z = localZ - 1; z >= 0; z--) {
-                VoxelBlock* block = &chunk->blocks[localX][localY][z];
-                
-                // If this block is air, we need to generate terrain below
-                if (block->type == VOXEL_AIR) {
-                    // Generate appropriate block type based on depth
-                    if (z >= 12) {
-                        // Surface layer - grass
-                        block->type = VOXEL_GRASS;
-                    } else if (z >= 8) {
-                        // Middle layer - dirt/stone mix
-                        block->type = VOXEL_WOOD; // Using wood as placeholder for dirt
-                    } else {
-                        // Deep layer - stone
-                        block->type = VOXEL_LEAVES; // Using leaves as placeholder for stone
-                    }
-                    
-                    // Initialize block properties
-                    BlockBlueprint* blueprints = create_block_blueprints();
-                    if (blueprints) {
-                        BlockBlueprint* blueprint = get_block_blueprint(blueprints, block->type);
-                        if (blueprint) {
-                            initialize_block_from_blueprint(block, blueprint);
-                        }
-                    }
-                    
-                    // Recalculate face visibility
-                    calculate_block_faces(chunk, localX, localY, z);
-                }
-            }
-            
-            // Recalculate faces for all affected blocks
-            for (int dx = -1; dx <= 1; dx++) {
-                for (int dy = -1; dy <= 1; dy++) {
-                    for (int dz = -1; dz <= 1; dz++) {
-                        int adjX = localX + dx;
-                        int adjY = localY + dy;
-                        int adjZ = localZ + dz;
-                        
-                        if (adjX >= 0 && adjX < 16 && adjY >= 0 && adjY < 16 && adjZ >= 0 && adjZ < 16) {
-                            calculate_block_faces(chunk, adjX, adjY, adjZ);
-                        }
-                    }
+    int chunkX = world_to_chunk_coord(worldX);
+    int chunkY = world_to_chunk_coord(worldY);
+    int chunkZ = world_to_chunk_coord(worldZ);
+    
+    VoxelChunk* chunk = find_chunk(manager, chunkX, chunkY, chunkZ);
+    if (chunk) {
+        int localX = worldX % 16; if (localX < 0) localX += 16;
+        int localY = worldY % 16; if (localY < 0) localY += 16;
+        int localZ = worldZ % 16; if (localZ < 0) localZ += 16;
+        
+        // Re-render blocks below the broken surface block
+        for (int z = localZ - 1; z >= 0; z--) {
+            // If this block is air, we need to generate terrain below
+            if (get_block_type(chunk, localX, localY, z) == VOXEL_AIR) {
+                // Generate appropriate block type based on depth
+                if (z >= 12) {
+                    // Surface layer - grass
+                    set_block_type(chunk, localX, localY, z, VOXEL_GRASS);
+                } else if (z >= 8) {
+                    // Middle layer - dirt/stone mix
+                    set_block_type(chunk, localX, localY, z, VOXEL_WOOD); // Using wood as placeholder for dirt
+                } else {
+                    // Deep layer - stone
+                    set_block_type(chunk, localX, localY, z, VOXEL_LEAVES); // Using leaves as placeholder for stone
                 }
             }
-            
-            printf("Terrain re-rendered below surface block\n");
-            return;
         }
+        
+        // Face visibility is computed on demand, only the mesh of the column is stale
+        queue_region_remesh(manager, chunk, localX, localY, 0, localX, localY, localZ);
+        
+        printf("Terrain re-rendered below surface block\n");
+        return;
     }
 }
 
@@ -1294,80 +1211,35 @@ void break_block_at(ChunkManager* manager, int worldX, int worldY, int worldZ) {
     if (localZ < 0) { localZ += 16; chunkZ--; }
     
     // Find the chunk
-    for (int i = 0; i < manager->loadedChunks; i++) {
-        VoxelChunk* chunk = manager->chunks[i];
-        if (chunk && chunk->chunkX == chunkX && chunk->chunkY == chunkY && chunk->chunkZ == chunkZ) {
-            VoxelBlock* block = &chunk->blocks[localX][localY][localZ];
+    VoxelChunk* chunk = find_chunk(manager, chunkX, chunkY, chunkZ);
+    if (chunk) {
+        VoxelType type = get_block_type(chunk, localX, localY, localZ);
+        
+        // Only break non-air blocks
+        if (type != VOXEL_AIR) {
+            printf("Breaking block at (%d,%d,%d) type=%d\n", worldX, worldY, worldZ, type);
             
-            // Only break non-air blocks
-            if (block->type != VOXEL_AIR) {
-                printf("Breaking block at (%d,%d,%d) type=%d\n", worldX, worldY, worldZ, block->type);
-                
-                // Check if this is a surface block
-                BOOL wasSurface = is_surface_block(manager, worldX, worldY, worldZ);
-                printf("Block is surface: %s\n", wasSurface ? "YES" : "NO");
-                
-                // Set block to air
-                block->type = VOXEL_AIR;
-                block->isVisible = FALSE;
-                
-                // If this was a surface block, re-render terrain below
-                if (wasSurface) {
-                    printf("Re-rendering terrain below surface block\n");
-                    rerender_terrain_below(manager, worldX, worldY, worldZ);
-                } else {
-                    printf("Block is not surface - no terrain re-rendering needed\n");
-                }
-                
-                // Mark chunk for remeshing
-                chunk->needsRemesh = TRUE;
-                
-                // Recalculate face visibility for this block and adjacent blocks
-                calculate_block_faces(chunk, localX, localY, localZ);
-                
-                // Recalculate faces for adjacent blocks (handle chunk rebases)
-                for (int dx = -1; dx <= 1; dx++) {
-                    for (int dy = -1; dy <= 1; dy++) {
-                        for (int dz = -1; dz <= 1; dz++) {
-                            if (dx == 0 && dy == 0 && dz == 0) continue;
-                            
-                            int adjX = localX + dx;
-                            int adjY = localY + dy;
-                            int adjZ = localZ + dz;
-                            
-                            // Handle chunk rebases for adjacent blocks
-                            int adjChunkX = chunkX;
-                            int adjChunkY = chunkY;
-                            int adjChunkZ = chunkZ;
-                            
-                            if (adjX < 0) { adjX += 16; adjChunkX--; }
-                            else if (adjX >= 16) { adjX -= 16; adjChunkX++; }
-                            if (adjY < 0) { adjY += 16; adjChunkY--; }
-                            else if (adjY >= 16) { adjY -= 16; adjChunkY++; }
-                            if (adjZ < 0) { adjZ += 16; adjChunkZ--; }
-                            else if (adjZ >= 16) { adjZ -= 16; adjChunkZ++; }
-                            
-                            // Find adjacent chunk and mark for remeshing
-                            for (int j = 0; j < manager->loadedChunks; j++) {
-                                VoxelChunk* adjChunk = manager->chunks[j];
-                                if (adjChunk && adjChunk->chunkX == adjChunkX && 
-                                    adjChunk->chunkY == adjChunkY && adjChunk->chunkZ == adjChunkZ) {
-                                    adjChunk->needsRemesh = TRUE;
-                                    calculate_block_faces(adjChunk, adjX, adjY, adjZ);
-                                    break;
-                                }
-                            }
-                            
-                            if (adjX >= 0 && adjX < 16 && adjY >= 0 && adjY < 16 && adjZ >= 0 && adjZ < 16) {
-                                calculate_block_faces(chunk, adjX, adjY, adjZ);
-                            }
-                        }
-                    }
-                }
-                
-                printf("Block broken successfully\n");
-                return;
+            // Check if this is a surface block
+            BOOL wasSurface = is_surface_block(manager, worldX, worldY, worldZ);
+            printf("Block is surface: %s\n", wasSurface ? "YES" : "NO");
+            
+            // Set block to air (the chunk drops back to uniform storage if it was the last block)
+            set_block_type(chunk, localX, localY, localZ, VOXEL_AIR);
+            chunk_storage_compact(&chunk->storage);
+            
+            // If this was a surface block, re-render terrain below
+            if (wasSurface) {
+                printf("Re-rendering terrain below surface block\n");
+                rerender_terrain_below(manager, worldX, worldY, worldZ);
+            } else {
+                printf("Block is not surface - no terrain re-rendering needed\n");
             }
+            
+            // Queue the edit: el remesh (y el de los vecinos si toca el borde) se hace una vez por frame
+            queue_block_remesh(manager, chunk, localX, localY, localZ);
+            
+            printf("Block broken successfully\n");
+            return;
         }
     }
     
@@ -1393,71 +1265,24 @@ void place_block_at(ChunkManager* manager, int worldX, int worldY, int worldZ, V
     if (localZ < 0) { localZ += 16; chunkZ--; }
     
     // Find the chunk
-    for (int i = 0; i < manager->loadedChunks; i++) {
-        VoxelChunk* chunk = manager->chunks[i];
-        if (chunk && chunk->chunkX == chunkX && chunk->chunkY == chunkY && chunk->chunkZ == chunkZ) {
-            VoxelBlock* block = &chunk->blocks[localX][localY][localZ];
+    VoxelChunk* chunk = find_chunk(manager, chunkX, chunkY, chunkZ);
+    if (chunk) {
+        // Only place in air blocks
+        if (get_block_type(chunk, localX, localY, localZ) == VOXEL_AIR) {
+            printf("Placing block at (%d,%d,%d) type=%d\n", worldX, worldY, worldZ, blockType);
             
-            // Only place in air blocks
-            if (block->type == VOXEL_AIR) {
-                printf("Placing block at (%d,%d,%d) type=%d\n", worldX, worldY, worldZ, blockType);
-                
-                // Get block blueprint
-                BlockBlueprint* blueprints = create_block_blueprints();
-                if (blueprints) {
-                    BlockBlueprint* blueprint = get_block_blueprint(blueprints, blockType);
-                    if (blueprint) {
-                        initialize_block_from_blueprint(block, blueprint);
-                        
-                        // Mark chunk for remeshing
-                        chunk->needsRemesh = TRUE;
-                        
-                        // Recalculate face visibility for this block and adjacent blocks
-                        calculate_block_faces(chunk, localX, localY, localZ);
-                        
-                        // Recalculate faces for adjacent blocks (handle chunk rebases)
-                        for (int dx = -1; dx <= 1; dx++) {
-                            for (int dy = -1; dy <= 1; dy++) {
-                                for (int dz = -1; dz <= 1; dz++) {
-                                    if (dx == 0 && dy == 0 && dz == 0) continue;
-                                    
-                                    int adjX = localX + dx;
-                                    int adjY = localY + dy;
-                                    int adjZ = localZ + dz;
-                                    
-                                    // Handle chunk rebases for adjacent blocks
-                                    int adjChunkX = chunkX;
-                                    int adjChunkY = chunkY;
-                                    int adjChunkZ = chunkZ;
-                                    
-                                    if (adjX < 0) { adjX += 16; adjChunkX--; }
-                                    else if (adjX >= 16) { adjX -= 16; adjChunkX++; }
-                                    if (adjY < 0) { adjY += 16; adjChunkY--; }
-                                    else if (adjY >= 16) { adjY -= 16; adjChunkY++; }
-                                    if (adjZ < 0) { adjZ += 16; adjChunkZ--; }
-                                    else if (adjZ >= 16) { adjZ -= 16; adjChunkZ++; }
-                                    
-                                    // Find adjacent chunk and mark for remeshing
-                                    for (int j = 0; j < manager->loadedChunks; j++) {
-                                        VoxelChunk* adjChunk = manager->chunks[j];
-                                        if (adjChunk && adjChunk->chunkX == adjChunkX && 
-                                            adjChunk->chunkY == adjChunkY && adjChunk->chunkZ == adjChunkZ) {
-                                            adjChunk->needsRemesh = TRUE;
-                                            calculate_block_faces(adjChunk, adjX, adjY, adjZ);
-                                            break;
-                                        }
-                                    }
-                                    
-                                    if (adjX >= 0 && adjX < 16 && adjY >= 0 && adjY < 16 && adjZ >= 0 && adjZ < 16) {
-                                        calculate_block_faces(chunk, adjX, adjY, adjZ);
-                                    }
-                                }
-                            }
-                        }
-                        
-                        printf("Block placed successfully\n");
-                        return;
-                    }
+            // Get block blueprint
+            BlockBlueprint* blueprints = create_block_blueprints();
+            if (blueprints) {
+                BlockBlueprint* blueprint = get_block_blueprint(blueprints, blockType);
+                if (blueprint) {
+                    set_block_type(chunk, localX, localY, localZ, blockType);
+                    
+                    // Queue the edit: el remesh (y el de los vecinos si toca el borde) se hace una vez por frame
+                    queue_block_remesh(manager, chunk, localX, localY, localZ);
+                    
+                    printf("Block placed successfully\n");
+                    return;
                 }
             }
         }
@@ -1719,6 +1544,48 @@ void render_performance_info() {
     glVertex2f(10, 65);
     glEnd();
     
+    // Render chunk culling: dibujados en amarillo, detrás de oclusores en rojo, tapados
+    // (cave culling) en naranja y fuera del frustum en gris
+    const ChunkRenderStats* chunkStats = get_chunk_render_stats();
+    if (chunkStats->chunksTested > 0) {
+        float drawn = (float)(chunkStats->chunksTested - chunkStats->chunksCulled - chunkStats->chunksCaveCulled -
+                              chunkStats->chunksOccluded) / chunkStats->chunksTested;
+        float occluded = drawn + (float)chunkStats->chunksOccluded / chunkStats->chunksTested;
+        float hidden = occluded + (float)chunkStats->chunksCaveCulled / chunkStats->chunksTested;
+        
+        glColor3f(1.0f, 1.0f, 0.0f);
+        glBegin(GL_QUADS);
+        glVertex2f(10, 70);
+        glVertex2f(10 + drawn * 100, 70);
+        glVertex2f(10 + drawn * 100, 85);
+        glVertex2f(10, 85);
+        glEnd();
+        
+        glColor3f(0.9f, 0.1f, 0.1f);
+        glBegin(GL_QUADS);
+        glVertex2f(10 + drawn * 100, 70);
+        glVertex2f(10 + occluded * 100, 70);
+        glVertex2f(10 + occluded * 100, 85);
+        glVertex2f(10 + drawn * 100, 85);
+        glEnd();
+        
+        glColor3f(1.0f, 0.5f, 0.0f);
+        glBegin(GL_QUADS);
+        glVertex2f(10 + occluded * 100, 70);
+        glVertex2f(10 + hidden * 100, 70);
+        glVertex2f(10 + hidden * 100, 85);
+        glVertex2f(10 + occluded * 100, 85);
+        glEnd();
+        
+        glColor3f(0.4f, 0.4f, 0.4f);
+        glBegin(GL_QUADS);
+        glVertex2f(10 + hidden * 100, 70);
+        glVertex2f(110, 70);
+        glVertex2f(110, 85);
+        glVertex2f(10 + hidden * 100, 85);
+        glEnd();
+    }
+    
     // Restore OpenGL state
     glMatrixMode(GL_PROJECTION);
     glPopMatrix();
@@ -1734,5 +1601,6 @@ Player* get_player() { return g_player; }
 RenderLight* get_render_lights() { return g_render_lights; }
 int get_render_light_count() { return g_render_light_count; }
 RenderFog* get_render_fog() { return &g_render_fog; }
+const Frustum* get_view_frustum() { return &g_view_frustum; }
 VolumetricSystem* get_volumetric_system() { return g_volumetric_system; }
 AdvancedShadowSystem* get_shadow_system() { return g_shadow_system; }
@@ -84,6 +84,77 @@ static const char* LIT_FRAGMENT_SHADER_SOURCE =
 "    gl_FragColor = vec4(finalColor, 1.0);\n"
 "}\n";
 
+// Vertex shader source for packed chunk vertices (ChunkVertex, world/chunk_mesh.h).
+// GLSL 1.20 no tiene enteros sin signo: cada uint32 llega como vec4 de bytes sin normalizar
+// y los campos de pocos bits se separan con floor/mod. Nada del pipeline fijo: las matrices
+// son las de create_view_matrix/create_projection_matrix y la luz y la niebla se calculan
+// por fragmento con los uniforms de ShaderLighting.
+static const char* LIT_CHUNK_VERTEX_SHADER_SOURCE = 
+"#version 120\n"
+"attribute vec4 aPacked0;  // x, y, z, cara | AO << 3\n"
+"attribute vec4 aPacked1;  // id de bloque, tono, -, -\n"
+"\n"
+"uniform mat4 uView;\n"
+"uniform mat4 uProjection;\n"
+"uniform vec3 uRegionOrigin;  // Región de 8x8x8 chunks: xyz ya lleva el chunk dentro de ella\n"
+"uniform vec4 uBlockColors[16];  // rgb + opacidad (1 fuera de la capa translúcida)\n"
+"\n"
+"varying vec3 vWorldNrm;\n"
+"varying vec3 vViewPos;\n"
+"varying vec3 vAlbedo;\n"
+"varying float vOcclusion;\n"
+"varying float vAlpha;\n"
+"\n"
+"void main() {\n"
+"    // Unpack face id (bits 0-2) and AO (bits 3-4) of the fourth byte\n"
+"    float face = mod(aPacked0.w, 8.0);\n"
+"    float ao = floor(aPacked0.w / 8.0);\n"
+"    float axis = floor(face / 2.0);\n"
+"    float side = 1.0 - 2.0 * mod(face, 2.0);\n"
+"    vWorldNrm = vec3(equal(vec3(axis), vec3(0.0, 1.0, 2.0))) * side;\n"
+"    \n"
+"    // Block color mixed with the per-block tint, darkened by AO (3 = sin oclusión)\n"
+"    vec4 block = uBlockColors[int(aPacked1.x)];\n"
+"    vAlbedo = block.rgb * 0.7 + vec3(aPacked1.y / 255.0 * 0.3);\n"
+"    vOcclusion = 0.55 + 0.15 * ao;\n"
+"    vAlpha = block.a;\n"
+"    \n"
+"    vec4 viewPos = uView * vec4(uRegionOrigin + aPacked0.xyz, 1.0);\n"
+"    vViewPos = viewPos.xyz;\n"
+"    gl_Position = uProjection * viewPos;\n"
+"}\n";
+
+// Lambert with ambient and exponential fog per fragment (misma niebla que el shader lit)
+static const char* LIT_CHUNK_FRAGMENT_SHADER_SOURCE = 
+"#version 120\n"
+"varying vec3 vWorldNrm;\n"
+"varying vec3 vViewPos;\n"
+"varying vec3 vAlbedo;\n"
+"varying float vOcclusion;\n"
+"varying float vAlpha;\n"
+"\n"
+"uniform vec3 uLightDir;\n"
+"uniform vec3 uLightColor;\n"
+"uniform float uAmbient;\n"
+"uniform vec3 uSunColor;\n"
+"uniform float uFogDensity;\n"
+"uniform vec3 uFogColor;\n"
+"uniform float uFogIntensity;\n"
+"\n"
+"void main() {\n"
+"    float NdotL = max(dot(normalize(vWorldNrm), -uLightDir), 0.0);\n"
+"    vec3 light = min(uLightColor * uAmbient + uSunColor * NdotL, vec3(1.0));\n"
+"    vec3 finalColor = vAlbedo * light * vOcclusion;\n"
+"    \n"
+"    // Apply fog if density > 0 (distancia a la cámara)\n"
+"    if (uFogDensity > 0.0) {\n"
+"        float fogFactor = exp(-uFogDensity * length(vViewPos));\n"
+"        finalColor = mix(uFogColor * uFogIntensity, finalColor, fogFactor);\n"
+"    }\n"
+"    \n"
+"    gl_FragColor = vec4(finalColor, vAlpha);\n"
+"}\n";
+
 // Fog shader source
 static const char* FOG_FRAGMENT_SHADER_SOURCE = 
 "#version 120\n"
@@ -281,6 +352,11 @@ ShaderProgram create_lit_shader_program() {
     return create_shader_program(LIT_VERTEX_SHADER_SOURCE, LIT_FRAGMENT_SHADER_SOURCE);
 }
 
+// Create lit shader program for packed chunk vertices
+ShaderProgram create_lit_chunk_shader_program() {
+    return create_shader_program(LIT_CHUNK_VERTEX_SHADER_SOURCE, LIT_CHUNK_FRAGMENT_SHADER_SOURCE);
+}
+
 // Create fog shader program
 ShaderProgram create_fog_shader_program() {
     return create_shader_program(LIT_VERTEX_SHADER_SOURCE, FOG_FRAGMENT_SHADER_SOURCE);
@@ -1,11 +1,15 @@
 #include "world/chunk_system.h"  // Must be included before renderer.h
 #include "graphics/window.h"
+#include "graphics/chunk_renderer.h"
+#include "world/chunk_mesh_worker.h"
+#include "world/chunk_arena.h"
 #include "graphics/opengl/simple_opengl.h"
 #include "graphics/ui/menu.h"
 #include "core/math3d.h"
 #include "core/input.h"
 #include <stdio.h>
 #include <stdlib.h>
+#include <math.h>
 #include <windowsx.h>
 
 // Global game state
@@ -350,6 +354,12 @@ BOOL initialize_game() {
         return FALSE;
     }
     
+    // Presupuesto de memoria para chunks (LRU + distancia + sucios, ver evict_chunk): unos 40
+    // chunks de terreno con índices de 4 bits, o ~75 de aire uniforme. Queda por debajo de los
+    // 100 slots, así expulsa el presupuesto y no el límite de slots, y por encima de los 27
+    // chunks protegidos alrededor del jugador
+    g_game_state.chunkManager->evictionPolicy.memoryBudget = 40 * (sizeof(VoxelChunk) + CHUNK_VOLUME / 2);
+    
     // Initialize terrain generator with world persistence
     g_game_state.terrainGenerator = create_terrain_generator(12345);
     
@@ -362,12 +372,16 @@ BOOL initialize_game() {
         printf("Mundo existente cargado con seed: %d\n", g_game_state.terrainGenerator.seed);
     }
     
-    // Generate initial chunks around origin (3x3 grid)
+    // Generate initial chunks around origin (3x3 grid, vertical stack around the ground)
+    ChunkManager* manager = g_game_state.chunkManager;
     for (int x = -1; x <= 1; x++) {
         for (int y = -1; y <= 1; y++) {
-            VoxelChunk* chunk = get_or_create_chunk(g_game_state.chunkManager, x, y, 0);
-            if (chunk && !chunk->isGenerated) {
-                generate_chunk_terrain(chunk, &g_game_state.terrainGenerator);
+            for (int z = -manager->verticalDistance; z <= manager->verticalDistance; z++) {
+                if (z < manager->minChunkZ || z > manager->maxChunkZ) continue;
+                VoxelChunk* chunk = get_or_create_chunk(manager, x, y, z);
+                if (chunk && !chunk->isGenerated) {
+                    generate_chunk_terrain(chunk, &g_game_state.terrainGenerator);
+                }
             }
         }
     }
@@ -415,6 +429,7 @@ void cleanup_game() {
     if (g_game_state.isInitialized) {
         // Cleanup chunk system
         if (g_game_state.chunkManager) {
+            shutdown_chunk_renderer(g_game_state.chunkManager); // Antes de perder el contexto OpenGL
             destroy_chunk_manager(g_game_state.chunkManager);
         }
         
@@ -593,6 +608,132 @@ void test_all_functionalities() {
     printf("   - Space: %s\n", g_game_state.keys[VK_SPACE] ? "PRESSED" : "RELEASED");
     printf("   - Shift: %s\n", g_game_state.keys[VK_SHIFT] ? "PRESSED" : "RELEASED");
     
+    // Test 10: Chunk storage
+    printf("\n10. CHUNK STORAGE TEST:\n");
+    if (g_game_state.chunkManager) {
+        ChunkManager* manager = g_game_state.chunkManager;
+        size_t storageBytes = 0;
+        int storageChunks = 0;
+        for (int i = 0; i < manager->maxChunks; i++) {
+            VoxelChunk* chunk = manager->chunks[i];
+            if (chunk) {
+                storageBytes += chunk_storage_memory_usage(&chunk->storage);
+                storageChunks++;
+            }
+        }
+        printf("   - Chunks: %d, block storage: %zu bytes (%.1f bytes/chunk)\n",
+               storageChunks, storageBytes,
+               storageChunks > 0 ? (float)storageBytes / storageChunks : 0.0f);
+        print_pool_stats(manager->chunkPool);
+        printf("   - Memoria de chunks: %zu / %zu bytes (presupuesto), expulsados: %d, guardados: %d\n",
+               get_chunk_manager_memory(manager), manager->evictionPolicy.memoryBudget,
+               manager->evictedChunks, manager->savedChunks);
+    }
+    verify_chunk_storage();
+    benchmark_chunk_storage(1000000);
+    
+    // Test 11: Occupancy bitmasks
+    printf("\n11. OCCUPANCY MASK TEST:\n");
+    benchmark_occupancy_masks(1000000);
+    
+    // Test 12: Voxel layout inside chunks
+    printf("\n12. CHUNK LAYOUT TEST:\n");
+    benchmark_chunk_layout(200);
+    
+    // Test 13: Retained chunk meshes
+    printf("\n13. CHUNK MESH TEST:\n");
+    verify_chunk_mesh_builder();
+    verify_cross_chunk_culling();
+    report_chunk_mesh_counts(g_game_state.chunkManager);
+    report_chunk_vertex_memory(g_game_state.chunkManager);
+    const ChunkRenderStats* meshStats = get_chunk_render_stats();
+    printf("   - Último frame: %d draw calls, %d triángulos, %d remesh, %zu bytes subidos, %zu bytes en GPU\n",
+           meshStats->drawCalls, meshStats->trianglesDrawn, meshStats->chunksRemeshed,
+           meshStats->uploadedBytes, meshStats->gpuBytes);
+    
+    // Test 14: Remesh queue (ediciones acumuladas por frame)
+    printf("\n14. REMESH QUEUE TEST:\n");
+    verify_remesh_queue();
+    printf("   - Último frame: %d ediciones en %d chunks\n", meshStats->editsApplied, meshStats->chunksEdited);
+    
+    // Test 15: Meshing en hilos (el hilo principal solo hace snapshots y subidas)
+    printf("\n15. MESH WORKER TEST:\n");
+    verify_chunk_mesh_workers(g_game_state.chunkManager);
+    printf("   - Último frame: %d trabajos enviados, %d en vuelo, %zu bytes subidos (presupuesto %d)\n",
+           meshStats->meshJobsSubmitted, meshStats->meshJobsInFlight, meshStats->uploadedBytes,
+           CHUNK_UPLOAD_BUDGET_BYTES);
+    
+    // Test 16: Capas de render (opaco, recortado, translúcido ordenado)
+    printf("\n16. TRANSLUCENT LAYER TEST:\n");
+    verify_chunk_mesh_layers();
+    printf("   - Último frame: %d chunks translúcidos, %d reordenados\n",
+           meshStats->translucentChunks, meshStats->translucentResorts);
+    
+    // Test 17: Niveles de detalle (2x / 4x) para chunks lejanos
+    printf("\n17. CHUNK LOD TEST:\n");
+    verify_chunk_lod();
+    report_chunk_lod_counts(g_game_state.chunkManager);
+    printf("   - Último frame: %d / %d / %d chunks a 1x / 2x / 4x, %d cambios de nivel\n",
+           meshStats->lodChunks[0], meshStats->lodChunks[1], meshStats->lodChunks[2], meshStats->lodChanges);
+    
+    // Test 18: Frustum culling (chunks fuera de la vista sin llamadas de dibujo)
+    printf("\n18. FRUSTUM CULLING TEST:\n");
+    verify_frustum_culling();
+    benchmark_frustum_culling(16384, 200);
+    printf("   - Último frame: %d de %d chunks fuera del frustum\n",
+           meshStats->chunksCulled, meshStats->chunksTested);
+    
+    // Test 19: Cave culling (chunks tapados dentro del frustum)
+    printf("\n19. CAVE CULLING TEST:\n");
+    verify_cave_culling();
+    printf("   - Último frame: %d chunks tapados descartados de %d dentro del frustum\n",
+           meshStats->chunksCaveCulled, meshStats->chunksTested - meshStats->chunksCulled);
+    
+    // Test 20: Oclusión con Z jerárquico (chunks detrás de colinas y paredes)
+    printf("\n20. OCCLUSION CULLING TEST:\n");
+    verify_chunk_occlusion();
+    ChunkCameraFrame* frames = (ChunkCameraFrame*)safe_malloc(CHUNK_FLYTHROUGH_MAX_FRAMES * sizeof(ChunkCameraFrame));
+    if (frames && camera) {
+        // Replay of the camera path recorded while playing (últimos 30 segundos)
+        int frameCount = get_recorded_camera_frames(frames, CHUNK_FLYTHROUGH_MAX_FRAMES);
+        float aspect = (float)g_game_state.window.width / (float)(g_game_state.window.height > 0 ? g_game_state.window.height : 1);
+        report_occlusion_flythrough(g_game_state.chunkManager, frames, frameCount, camera->fov, aspect);
+    }
+    safe_free(frames);
+    printf("   - Último frame: %d chunks detrás de oclusores (%d caras oclusoras)\n",
+           meshStats->chunksOccluded, meshStats->occluderFaces);
+    
+    // Test 21: Arena de geometría compartida y multi-draw por región
+    printf("\n21. CHUNK ARENA TEST:\n");
+    verify_chunk_arena();
+    printf("   - Último frame: %d draw calls para %d dibujos de chunk, %zu de %zu KB de arena usados, %d compactaciones\n",
+           meshStats->drawCalls, meshStats->chunkDraws, meshStats->gpuBytes / 1024, meshStats->arenaBytes / 1024,
+           meshStats->arenaCompactions);
+
+    // Test 22: Matrices del shader de chunks frente a las del frustum (mismo clip space)
+    printf("\n22. CHUNK SHADER MATRICES TEST:\n");
+    if (camera) {
+        float aspect = (float)g_game_state.window.width / (float)(g_game_state.window.height > 0 ? g_game_state.window.height : 1);
+        float view[16], projection[16];
+        create_view_matrix(view, camera->position, camera->target, camera->up);
+        create_projection_matrix(projection, camera->fov, aspect, camera->nearPlane, camera->farPlane);
+        Frustum frustum;
+        frustum_from_camera(&frustum, camera->position, camera->target, camera->up,
+                            camera->fov, aspect, camera->nearPlane, camera->farPlane);
+
+        // Column-major de GL leído por filas = matriz de vector fila, como Matrix4x4
+        float maxError = 0.0f;
+        for (int i = 0; i < 4; i++) {
+            for (int j = 0; j < 4; j++) {
+                float value = 0.0f;
+                for (int k = 0; k < 4; k++) value += view[i * 4 + k] * projection[k * 4 + j];
+                float error = fabsf(value - frustum.viewProjection.m[i][j]);
+                if (error > maxError) maxError = error;
+            }
+        }
+        printf("   - View * projection vs frustum: error máximo %.6f %s\n", maxError, maxError < 1e-3f ? "OK" : "FALLO");
+    }
+
     printf("\n=== TEST COMPLETE ===\n");
     printf("Press T again to run another test.\n\n");
 }
@@ -633,11 +774,26 @@ void handle_keyboard_input(WPARAM wParam) {
             // New world - delete existing data and create new
             printf("Creando nuevo mundo...\n");
             delete_world_data("world_data.bin");
+            if (g_game_state.chunkManager) {
+                delete_saved_chunks(g_game_state.chunkManager->evictionPolicy.saveDirectory);
+            }
             destroy_terrain_generator(&g_game_state.terrainGenerator);
             g_game_state.terrainGenerator = create_terrain_generator(rand() % 1000000); // Random seed
             save_world_data(&g_game_state.terrainGenerator, "world_data.bin");
             printf("Nuevo mundo creado con seed: %d\n", g_game_state.terrainGenerator.seed);
             break;
+        case 'G':
+            // Rotar el mesher de todos los chunks: naive -> greedy -> binary
+            if (g_game_state.chunkManager) {
+                static const char* meshModeNames[] = {"NAIVE", "GREEDY", "BINARY"};
+                ChunkManager* manager = g_game_state.chunkManager;
+                manager->defaultMeshMode = (ChunkMeshMode)((manager->defaultMeshMode + 1) % 3);
+                for (int i = 0; i < manager->maxChunks; i++) {
+                    set_chunk_mesh_mode(manager->chunks[i], manager->defaultMeshMode);
+                }
+                printf("Mesher de chunks: %s\n", meshModeNames[manager->defaultMeshMode]);
+            }
+            break;
         case VK_SPACE:
             // Handle space input for flight toggle
             Player* player = get_player();
@@ -0,0 +1,229 @@
+#include "world/chunk_arena.h"
+#include "core/memory.h"
+#include <stdio.h>
+#include <string.h>
+
+BOOL chunk_arena_init(ChunkArena* arena, uint32 capacity) {
+    if (!arena) return FALSE;
+    memset(arena, 0, sizeof(ChunkArena));
+    arena->freeCapacity = 64;
+    arena->freeRanges = (ChunkArenaRange*)safe_malloc(arena->freeCapacity * sizeof(ChunkArenaRange));
+    if (!arena->freeRanges) {
+        arena->freeCapacity = 0;
+        return FALSE;
+    }
+    return chunk_arena_reset(arena, capacity, 0);
+}
+
+void chunk_arena_free(ChunkArena* arena) {
+    if (!arena) return;
+    safe_free(arena->freeRanges);
+    memset(arena, 0, sizeof(ChunkArena));
+}
+
+BOOL chunk_arena_alloc(ChunkArena* arena, uint32 size, uint32* offset) {
+    if (!arena || size == 0) return FALSE;
+
+    int best = -1;
+    for (int i = 0; i < arena->freeCount; i++) {
+        uint32 rangeSize = arena->freeRanges[i].size;
+        if (rangeSize >= size && (best < 0 || rangeSize < arena->freeRanges[best].size)) {
+            best = i;
+            if (rangeSize == size) break;
+        }
+    }
+    if (best < 0) return FALSE;
+
+    // Se toma el principio del hueco; si se agota entero desaparece de la lista
+    ChunkArenaRange* range = &arena->freeRanges[best];
+    *offset = range->offset;
+    range->offset += size;
+    range->size -= size;
+    if (range->size == 0) {
+        memmove(range, range + 1, (arena->freeCount - best - 1) * sizeof(ChunkArenaRange));
+        arena->freeCount--;
+    }
+    arena->used += size;
+    return TRUE;
+}
+
+void chunk_arena_release(ChunkArena* arena, uint32 offset, uint32 size) {
+    if (!arena || size == 0) return;
+
+    // Primer hueco que empieza después del rango liberado
+    int lo = 0, hi = arena->freeCount;
+    while (lo < hi) {
+        int mid = (lo + hi) / 2;
+        if (arena->freeRanges[mid].offset < offset) lo = mid + 1; else hi = mid;
+    }
+
+    BOOL joinPrev = lo > 0 && arena->freeRanges[lo - 1].offset + arena->freeRanges[lo - 1].size == offset;
+    BOOL joinNext = lo < arena->freeCount && offset + size == arena->freeRanges[lo].offset;
+    if (joinPrev && joinNext) {
+        arena->freeRanges[lo - 1].size += size + arena->freeRanges[lo].size;
+        memmove(&arena->freeRanges[lo], &arena->freeRanges[lo + 1], (arena->freeCount - lo - 1) * sizeof(ChunkArenaRange));
+        arena->freeCount--;
+        arena->used -= size;
+        return;
+    }
+    if (joinPrev) {
+        arena->freeRanges[lo - 1].size += size;
+        arena->used -= size;
+        return;
+    }
+    if (joinNext) {
+        arena->freeRanges[lo].offset = offset;
+        arena->freeRanges[lo].size += size;
+        arena->used -= size;
+        return;
+    }
+
+    if (arena->freeCount == arena->freeCapacity) {
+        int capacity = arena->freeCapacity * 2;
+        ChunkArenaRange* grown = (ChunkArenaRange*)safe_malloc(capacity * sizeof(ChunkArenaRange));
+        if (!grown) {
+            // Sin memoria para el hueco: sigue contando como usado hasta la próxima compactación
+            printf("WARNING: chunk arena sin memoria para un hueco de %u unidades\n", size);
+            return;
+        }
+        memcpy(grown, arena->freeRanges, arena->freeCount * sizeof(ChunkArenaRange));
+        safe_free(arena->freeRanges);
+        arena->freeRanges = grown;
+        arena->freeCapacity = capacity;
+    }
+    memmove(&arena->freeRanges[lo + 1], &arena->freeRanges[lo], (arena->freeCount - lo) * sizeof(ChunkArenaRange));
+    arena->freeRanges[lo].offset = offset;
+    arena->freeRanges[lo].size = size;
+    arena->freeCount++;
+    arena->used -= size;
+}
+
+uint32 chunk_arena_largest_free(const ChunkArena* arena) {
+    uint32 largest = 0;
+    if (!arena) return 0;
+    for (int i = 0; i < arena->freeCount; i++) {
+        if (arena->freeRanges[i].size > largest) largest = arena->freeRanges[i].size;
+    }
+    return largest;
+}
+
+BOOL chunk_arena_reset(ChunkArena* arena, uint32 capacity, uint32 used) {
+    if (!arena || !arena->freeRanges || used > capacity) return FALSE;
+    arena->capacity = capacity;
+    arena->used = used;
+    arena->freeCount = 0;
+    if (used < capacity) {
+        arena->freeRanges[0].offset = used;
+        arena->freeRanges[0].size = capacity - used;
+        arena->freeCount = 1;
+    }
+    return TRUE;
+}
+
+// ============================================================================
+// SELF-CHECK
+// ============================================================================
+
+static uint32 next_arena_random(uint32* state) {
+    *state = *state * 1664525u + 1013904223u;
+    return *state >> 8;
+}
+
+// Free list sorted, separated, inside the buffer and adding up to capacity - used
+static BOOL arena_is_consistent(const ChunkArena* arena) {
+    uint32 freeTotal = 0;
+    for (int i = 0; i < arena->freeCount; i++) {
+        const ChunkArenaRange* range = &arena->freeRanges[i];
+        if (range->size == 0 || range->offset + range->size > arena->capacity) return FALSE;
+        if (i > 0 && arena->freeRanges[i - 1].offset + arena->freeRanges[i - 1].size >= range->offset) return FALSE;
+        freeTotal += range->size;
+    }
+    return freeTotal == arena->capacity - arena->used;
+}
+
+BOOL verify_chunk_arena(void) {
+    enum { SLOTS = 96, OPERATIONS = 20000, MAX_CAPACITY = 1 << 16 };
+    ChunkArena arena;
+    if (!chunk_arena_init(&arena, 4096)) return FALSE;
+
+    uint32 slotOffset[SLOTS], slotSize[SLOTS];
+    memset(slotSize, 0, sizeof(slotSize));
+    uint8* owner = (uint8*)safe_calloc(MAX_CAPACITY, 1);  // Slot + 1 de cada unidad, 0 libre
+    if (!owner) {
+        chunk_arena_free(&arena);
+        return FALSE;
+    }
+
+    BOOL ok = TRUE;
+    uint32 seed = 777u;
+    int compactions = 0, grows = 0, maxFreeRanges = 0;
+    for (int op = 0; op < OPERATIONS && ok; op++) {
+        int slot = (int)(next_arena_random(&seed) % SLOTS);
+        if (slotSize[slot]) {
+            chunk_arena_release(&arena, slotOffset[slot], slotSize[slot]);
+            memset(owner + slotOffset[slot], 0, slotSize[slot]);
+            slotSize[slot] = 0;
+        } else {
+            // Tamaños de mesh muy distintos: de unos pocos quads a chunks enteros
+            uint32 size = 1 + next_arena_random(&seed) % (next_arena_random(&seed) % 4 ? 64 : 600);
+            uint32 offset;
+            if (!chunk_arena_alloc(&arena, size, &offset)) {
+                // Compactar como el renderer: los vivos seguidos desde 0, doble si ni así cabe
+                uint32 capacity = arena.capacity;
+                if (arena.capacity - arena.used < size) {
+                    capacity *= 2;
+                    grows++;
+                }
+                if (capacity > MAX_CAPACITY) break;
+                memset(owner, 0, MAX_CAPACITY);
+                uint32 cursor = 0;
+                for (int s = 0; s < SLOTS; s++) {
+                    if (!slotSize[s]) continue;
+                    slotOffset[s] = cursor;
+                    memset(owner + cursor, s + 1, slotSize[s]);
+                    cursor += slotSize[s];
+                }
+                chunk_arena_reset(&arena, capacity, cursor);
+                compactions++;
+                if (!chunk_arena_alloc(&arena, size, &offset)) {
+                    printf("   - Sin hueco para %u unidades tras compactar FALLO\n", size);
+                    ok = FALSE;
+                    break;
+                }
+            }
+            for (uint32 u = offset; u < offset + size && ok; u++) {
+                if (u >= arena.capacity || owner[u]) ok = FALSE;
+            }
+            if (!ok) {
+                printf("   - Rango [%u, %u) solapado o fuera del buffer FALLO\n", offset, offset + size);
+                break;
+            }
+            memset(owner + offset, slot + 1, size);
+            slotOffset[slot] = offset;
+            slotSize[slot] = size;
+        }
+        if (arena.freeCount > maxFreeRanges) maxFreeRanges = arena.freeCount;
+        if (!arena_is_consistent(&arena)) {
+            printf("   - Lista de huecos incoherente tras la operación %d FALLO\n", op);
+            ok = FALSE;
+        }
+    }
+
+    // Vaciar en orden aleatorio: todo vuelve a ser un único hueco
+    for (int i = 0; i < SLOTS && ok; i++) {
+        int slot = (int)(next_arena_random(&seed) % SLOTS);
+        for (int k = 0; k < SLOTS && !slotSize[slot]; k++) slot = (slot + 1) % SLOTS;
+        if (!slotSize[slot]) break;
+        chunk_arena_release(&arena, slotOffset[slot], slotSize[slot]);
+        slotSize[slot] = 0;
+    }
+    BOOL merged = arena.used == 0 && arena.freeCount == 1 && arena.freeRanges[0].size == arena.capacity;
+    ok &= merged && compactions > 0;
+    printf("   - Arena: %d operaciones, %d compactaciones (%d ampliando), hasta %d huecos, %s al vaciarla %s\n",
+           OPERATIONS, compactions, grows, maxFreeRanges, merged ? "un hueco" : "huecos sin fusionar",
+           ok ? "OK" : "FALLO");
+
+    safe_free(owner);
+    chunk_arena_free(&arena);
+    return ok;
+}
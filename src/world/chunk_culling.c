@@ -0,0 +1,713 @@
+#include "world/chunk_culling.h"
+#include "core/memory.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+#ifdef __SSE__
+#include <xmmintrin.h>
+#endif
+
+// Packed bounds of the chunks culled last frame (struct of arrays, crece bajo demanda)
+static struct {
+    float* minX;
+    float* minY;
+    float* minZ;
+    uint8* visible;
+    VoxelChunk** chunks;
+    int capacity;
+} g_chunk_bounds = {0};
+
+// Cave culling BFS queue (cada chunk entra una vez) y sello de la búsqueda actual
+typedef struct {
+    VoxelChunk* chunk;
+    uint8 entryFace;   // Cara por la que entró la búsqueda
+    uint8 directions;  // Direcciones ya recorridas (bits BLOCK_FACE_*): no se vuelve por ninguna
+} CaveSearchNode;
+
+static CaveSearchNode* g_cave_queue = NULL;
+static int g_cave_queue_capacity = 0;
+static uint32 g_cave_search = 0;
+
+static const uint8 k_mask_bits[16] = {0, 1, 1, 2, 1, 2, 2, 3, 1, 2, 2, 3, 2, 3, 3, 4};
+
+// ============================================================================
+// FRUSTUM
+// ============================================================================
+
+static void set_plane(FrustumPlane* plane, float x, float y, float z, float w) {
+    float length = sqrtf(x * x + y * y + z * z);
+    float scale = length > 0.0f ? 1.0f / length : 0.0f;
+    plane->x = x * scale;
+    plane->y = y * scale;
+    plane->z = z * scale;
+    plane->w = w * scale;
+}
+
+// Columna j de la matriz = coeficientes de clip_j; dentro: -w <= x, y, z <= w
+void frustum_from_view_projection(Frustum* frustum, Matrix4x4 viewProjection) {
+    if (!frustum) return;
+    frustum->viewProjection = viewProjection;
+
+    float c[4][4];  // c[j]: columna j
+    for (int j = 0; j < 4; j++)
+        for (int i = 0; i < 4; i++)
+            c[j][i] = viewProjection.m[i][j];
+
+    for (int axis = 0; axis < 3; axis++) {
+        set_plane(&frustum->planes[axis * 2], c[3][0] + c[axis][0], c[3][1] + c[axis][1],
+                  c[3][2] + c[axis][2], c[3][3] + c[axis][3]);
+        set_plane(&frustum->planes[axis * 2 + 1], c[3][0] - c[axis][0], c[3][1] - c[axis][1],
+                  c[3][2] - c[axis][2], c[3][3] - c[axis][3]);
+    }
+}
+
+void frustum_from_camera(Frustum* frustum, Vect3 position, Vect3 target, Vect3 up,
+                         float fovYDegrees, float aspect, float nearPlane, float farPlane) {
+    Matrix4x4 view = matrix4x4_look_at(position, target, up);
+    Matrix4x4 projection = matrix4x4_perspective(fovYDegrees, aspect, nearPlane, farPlane);
+    frustum_from_view_projection(frustum, matrix4x4_multiply(view, projection));
+}
+
+BOOL frustum_intersects_box(const Frustum* frustum, Vect3 boxMin, Vect3 boxMax) {
+    for (int p = 0; p < 6; p++) {
+        const FrustumPlane* plane = &frustum->planes[p];
+        float x = plane->x > 0.0f ? boxMax.x : boxMin.x;
+        float y = plane->y > 0.0f ? boxMax.y : boxMin.y;
+        float z = plane->z > 0.0f ? boxMax.z : boxMin.z;
+        if (plane->x * x + plane->y * y + plane->z * z + plane->w < 0.0f) return FALSE;
+    }
+    return TRUE;
+}
+
+// ============================================================================
+// KERNEL - cubos empaquetados, todos del mismo lado
+// ============================================================================
+
+// Distance of the innermost corner = n · min + offset, con offset = w + size * (componentes positivas de n)
+static void plane_offsets(const Frustum* frustum, float size, float offsets[6]) {
+    for (int p = 0; p < 6; p++) {
+        const FrustumPlane* plane = &frustum->planes[p];
+        offsets[p] = plane->w + size * (fmaxf(plane->x, 0.0f) + fmaxf(plane->y, 0.0f) + fmaxf(plane->z, 0.0f));
+    }
+}
+
+static int cull_boxes_scalar(const Frustum* frustum, const float* offsets, const float* minX, const float* minY,
+                             const float* minZ, int first, int count, uint8* visible) {
+    int visibleCount = 0;
+    for (int i = first; i < count; i++) {
+        int inside = 1;
+        for (int p = 0; p < 6; p++) {
+            const FrustumPlane* plane = &frustum->planes[p];
+            inside &= plane->x * minX[i] + plane->y * minY[i] + plane->z * minZ[i] + offsets[p] >= 0.0f;
+        }
+        visible[i] = (uint8)inside;
+        visibleCount += inside;
+    }
+    return visibleCount;
+}
+
+int cull_boxes_in_frustum(const Frustum* frustum, const float* minX, const float* minY, const float* minZ,
+                          int count, float size, uint8* visible) {
+    if (!frustum || count <= 0) return 0;
+
+    float offsets[6];
+    plane_offsets(frustum, size, offsets);
+    int i = 0, visibleCount = 0;
+#ifdef __SSE__
+    __m128 planeX[6], planeY[6], planeZ[6], planeW[6];
+    for (int p = 0; p < 6; p++) {
+        planeX[p] = _mm_set1_ps(frustum->planes[p].x);
+        planeY[p] = _mm_set1_ps(frustum->planes[p].y);
+        planeZ[p] = _mm_set1_ps(frustum->planes[p].z);
+        planeW[p] = _mm_set1_ps(offsets[p]);
+    }
+    const __m128 zero = _mm_setzero_ps();
+    for (; i + 4 <= count; i += 4) {
+        __m128 x = _mm_loadu_ps(minX + i);
+        __m128 y = _mm_loadu_ps(minY + i);
+        __m128 z = _mm_loadu_ps(minZ + i);
+        __m128 inside = _mm_cmpge_ps(_mm_add_ps(_mm_add_ps(_mm_mul_ps(planeX[0], x), _mm_mul_ps(planeY[0], y)),
+                                                _mm_add_ps(_mm_mul_ps(planeZ[0], z), planeW[0])), zero);
+        for (int p = 1; p < 6; p++) {
+            __m128 distance = _mm_add_ps(_mm_add_ps(_mm_mul_ps(planeX[p], x), _mm_mul_ps(planeY[p], y)),
+                                         _mm_add_ps(_mm_mul_ps(planeZ[p], z), planeW[p]));
+            inside = _mm_and_ps(inside, _mm_cmpge_ps(distance, zero));
+        }
+
+        int mask = _mm_movemask_ps(inside);
+        visible[i] = (uint8)(mask & 1);
+        visible[i + 1] = (uint8)((mask >> 1) & 1);
+        visible[i + 2] = (uint8)((mask >> 2) & 1);
+        visible[i + 3] = (uint8)((mask >> 3) & 1);
+        visibleCount += k_mask_bits[mask];
+    }
+#endif
+    return visibleCount + cull_boxes_scalar(frustum, offsets, minX, minY, minZ, i, count, visible);
+}
+
+// ============================================================================
+// CHUNKS
+// ============================================================================
+
+static void free_bounds_arrays(void) {
+    safe_free(g_chunk_bounds.minX);
+    safe_free(g_chunk_bounds.minY);
+    safe_free(g_chunk_bounds.minZ);
+    safe_free(g_chunk_bounds.visible);
+    safe_free(g_chunk_bounds.chunks);
+    memset(&g_chunk_bounds, 0, sizeof(g_chunk_bounds));
+}
+
+static BOOL reserve_chunk_bounds(int count) {
+    if (count <= g_chunk_bounds.capacity) return TRUE;
+
+    int capacity = g_chunk_bounds.capacity ? g_chunk_bounds.capacity : 64;
+    while (capacity < count) capacity *= 2;
+    free_bounds_arrays();
+    g_chunk_bounds.minX = (float*)safe_malloc(capacity * sizeof(float));
+    g_chunk_bounds.minY = (float*)safe_malloc(capacity * sizeof(float));
+    g_chunk_bounds.minZ = (float*)safe_malloc(capacity * sizeof(float));
+    g_chunk_bounds.visible = (uint8*)safe_malloc(capacity);
+    g_chunk_bounds.chunks = (VoxelChunk**)safe_malloc(capacity * sizeof(VoxelChunk*));
+    if (!g_chunk_bounds.minX || !g_chunk_bounds.minY || !g_chunk_bounds.minZ ||
+        !g_chunk_bounds.visible || !g_chunk_bounds.chunks) {
+        free_bounds_arrays();
+        return FALSE;
+    }
+    g_chunk_bounds.capacity = capacity;
+    return TRUE;
+}
+
+void free_chunk_cull_bounds(void) {
+    free_bounds_arrays();
+    safe_free(g_cave_queue);
+    g_cave_queue = NULL;
+    g_cave_queue_capacity = 0;
+}
+
+// Chunk (cx, cy, cz) covers [c * 16 - 0.5, c * 16 + 15.5]: bloques centrados en enteros
+ChunkCullStats update_chunk_frustum_visibility(ChunkManager* manager, const Frustum* frustum) {
+    ChunkCullStats stats = {0, 0};
+    if (!manager) return stats;
+
+    if (!frustum || !reserve_chunk_bounds(manager->maxChunks)) {
+        for (int i = 0; i < manager->maxChunks; i++) {
+            VoxelChunk* chunk = manager->chunks[i];
+            if (!chunk || !chunk->isGenerated) continue;
+            chunk->isVisible = TRUE;
+            stats.tested++;
+        }
+        stats.visible = stats.tested;
+        return stats;
+    }
+
+    int count = 0;
+    for (int i = 0; i < manager->maxChunks; i++) {
+        VoxelChunk* chunk = manager->chunks[i];
+        if (!chunk || !chunk->isGenerated) continue;
+        g_chunk_bounds.minX[count] = chunk->chunkX * CHUNK_SIZE - 0.5f;
+        g_chunk_bounds.minY[count] = chunk->chunkY * CHUNK_SIZE - 0.5f;
+        g_chunk_bounds.minZ[count] = chunk->chunkZ * CHUNK_SIZE - 0.5f;
+        g_chunk_bounds.chunks[count++] = chunk;
+    }
+
+    stats.tested = count;
+    stats.visible = cull_boxes_in_frustum(frustum, g_chunk_bounds.minX, g_chunk_bounds.minY, g_chunk_bounds.minZ,
+                                          count, (float)CHUNK_SIZE, g_chunk_bounds.visible);
+    for (int i = 0; i < count; i++) {
+        g_chunk_bounds.chunks[i]->isVisible = g_chunk_bounds.visible[i] ? TRUE : FALSE;
+    }
+    return stats;
+}
+
+// ============================================================================
+// CAVE CULLING
+// ============================================================================
+
+// Cells of column (x, y) reached by the run of open bits through bit z
+static inline uint32 open_run(uint32 column, int z) {
+    uint32 bit = 1u << z;
+    uint32 up = ((column + bit) ^ column) & column;  // El acarreo recorre los unos desde z
+    uint32 belowGaps = ~column & (bit - 1);
+    uint32 start = belowGaps ? 1u << (32 - __builtin_clz(belowGaps)) : 1u;
+    return up | ((bit - 1) & ~(start - 1));
+}
+
+// Flood fill by vertical runs: cada celda abierta entra en la pila como mucho una vez
+uint16 compute_chunk_connectivity(const uint16 opaqueMask[CHUNK_SIZE][CHUNK_SIZE]) {
+    uint16 open[CHUNK_SIZE][CHUNK_SIZE];
+    uint16 visited[CHUNK_SIZE][CHUNK_SIZE];
+    uint16 queued[CHUNK_SIZE][CHUNK_SIZE];
+    uint16 stack[CHUNK_VOLUME];
+    uint16 anyOpen = 0, allOpen = 0xFFFF;
+
+    for (int x = 0; x < CHUNK_SIZE; x++) {
+        for (int y = 0; y < CHUNK_SIZE; y++) {
+            open[x][y] = (uint16)~opaqueMask[x][y];
+            anyOpen |= open[x][y];
+            allOpen &= open[x][y];
+        }
+    }
+    if (!anyOpen) return 0;
+    if (allOpen == 0xFFFF) return CHUNK_CONNECTIVITY_ALL;
+    memset(visited, 0, sizeof(visited));
+    memset(queued, 0, sizeof(queued));
+
+    uint16 connectivity = 0;
+    for (int sx = 0; sx < CHUNK_SIZE; sx++) {
+        for (int sy = 0; sy < CHUNK_SIZE; sy++) {
+            uint16 unvisited;
+            while ((unvisited = open[sx][sy] & ~visited[sx][sy]) != 0) {
+                int sz = __builtin_ctz(unvisited);
+                int top = 0;
+                stack[top++] = (uint16)((sx << 8) | (sy << 4) | sz);
+                queued[sx][sy] |= (uint16)(1u << sz);
+
+                int faces = 0;
+                while (top > 0) {
+                    int cell = stack[--top];
+                    int x = cell >> 8, y = (cell >> 4) & 15, z = cell & 15;
+                    if ((visited[x][y] >> z) & 1) continue;
+
+                    uint16 run = (uint16)open_run(open[x][y], z);
+                    visited[x][y] |= run;
+                    if (x == CHUNK_SIZE - 1) faces |= BLOCK_FACE_RIGHT;
+                    if (x == 0) faces |= BLOCK_FACE_LEFT;
+                    if (y == CHUNK_SIZE - 1) faces |= BLOCK_FACE_FRONT;
+                    if (y == 0) faces |= BLOCK_FACE_BACK;
+                    if (run & 0x8000) faces |= BLOCK_FACE_TOP;
+                    if (run & 1) faces |= BLOCK_FACE_BOTTOM;
+
+                    // One seed per segment of open cells beside the run in each side column
+                    for (int side = 0; side < 4; side++) {
+                        int nx = x + k_chunk_face_offsets[side][0];
+                        int ny = y + k_chunk_face_offsets[side][1];
+                        if (nx < 0 || nx >= CHUNK_SIZE || ny < 0 || ny >= CHUNK_SIZE) continue;
+                        uint16 candidates = open[nx][ny] & ~visited[nx][ny] & run;
+                        uint16 seeds = candidates & (uint16)~(candidates << 1) & ~queued[nx][ny];
+                        queued[nx][ny] |= seeds;
+                        while (seeds) {
+                            int nz = __builtin_ctz(seeds);
+                            seeds &= seeds - 1;
+                            stack[top++] = (uint16)((nx << 8) | (ny << 4) | nz);
+                        }
+                    }
+                }
+
+                for (int a = 0; a < CHUNK_FACE_COUNT; a++) {
+                    if (!(faces & (1 << a))) continue;
+                    for (int b = a + 1; b < CHUNK_FACE_COUNT; b++) {
+                        if (faces & (1 << b)) connectivity |= (uint16)(1u << chunk_face_pair_bit(a, b));
+                    }
+                }
+            }
+        }
+    }
+    return connectivity;
+}
+
+void update_chunk_connectivity(VoxelChunk* chunk) {
+    if (!chunk) return;
+    chunk->faceConnectivity = is_chunk_empty(chunk) ? CHUNK_CONNECTIVITY_ALL
+                                                    : compute_chunk_connectivity(chunk->opaqueMask);
+}
+
+#define CAVE_NO_ENTRY 0xFF  // El chunk de la cámara: se sale por cualquier cara
+
+int update_chunk_cave_visibility(ChunkManager* manager, Vect3 cameraPosition) {
+    if (!manager) return 0;
+
+    VoxelChunk* start = find_chunk(manager, (int)floorf((cameraPosition.x + 0.5f) / CHUNK_SIZE),
+                                   (int)floorf((cameraPosition.y + 0.5f) / CHUNK_SIZE),
+                                   (int)floorf((cameraPosition.z + 0.5f) / CHUNK_SIZE));
+    if (!start) return 0;
+
+    // Cada chunk entra en la cola una vez
+    if (g_cave_queue_capacity < manager->maxChunks) {
+        safe_free(g_cave_queue);
+        g_cave_queue = (CaveSearchNode*)safe_malloc(manager->maxChunks * sizeof(CaveSearchNode));
+        g_cave_queue_capacity = g_cave_queue ? manager->maxChunks : 0;
+        if (!g_cave_queue) return 0;
+    }
+
+    if (++g_cave_search == 0) g_cave_search = 1;  // 0 es el valor de un chunk recién creado
+    uint32 search = g_cave_search;
+    int head = 0, tail = 0;
+    start->caveVisit = search;
+    g_cave_queue[tail].chunk = start;
+    g_cave_queue[tail].entryFace = CAVE_NO_ENTRY;
+    g_cave_queue[tail++].directions = 0;
+
+    while (head < tail) {
+        CaveSearchNode node = g_cave_queue[head++];
+        for (int face = 0; face < CHUNK_FACE_COUNT; face++) {
+            if (node.directions & (1 << (face ^ 1))) continue;
+            if (node.entryFace != CAVE_NO_ENTRY &&
+                !chunk_faces_connected(node.chunk->faceConnectivity, node.entryFace, face)) continue;
+
+            const int8* offset = k_chunk_face_offsets[face];
+            VoxelChunk* neighbor = node.chunk->neighbors[chunk_neighbor_index(offset[0], offset[1], offset[2])];
+            if (!neighbor || neighbor->caveVisit == search || !neighbor->isVisible) continue;
+
+            neighbor->caveVisit = search;
+            g_cave_queue[tail].chunk = neighbor;
+            g_cave_queue[tail].entryFace = (uint8)(face ^ 1);
+            g_cave_queue[tail++].directions = (uint8)(node.directions | (1 << face));
+        }
+    }
+
+    int rejected = 0;
+    for (int i = 0; i < manager->maxChunks; i++) {
+        VoxelChunk* chunk = manager->chunks[i];
+        if (!chunk || !chunk->isGenerated || !chunk->isVisible || chunk->caveVisit == search) continue;
+        chunk->isVisible = FALSE;
+        rejected++;
+    }
+    return rejected;
+}
+
+// ============================================================================
+// SELF-CHECK Y BENCHMARK - sin OpenGL
+// ============================================================================
+
+// Pseudo-random value in [-range, range] (LCG: mismo resultado en cada ejecución)
+static float next_test_float(uint32* state, float range) {
+    *state = *state * 1664525u + 1013904223u;
+    return ((float)(*state >> 8) / 16777216.0f * 2.0f - 1.0f) * range;
+}
+
+BOOL verify_frustum_culling(void) {
+    Frustum frustum;
+    BOOL ok = TRUE;
+
+    // Cámara en el origen mirando a +X (Z arriba), 60 grados, aspecto 1, lejos a 100
+    Vect3 eye = vect3_create(0, 0, 0);
+    frustum_from_camera(&frustum, eye, vect3_create(1, 0, 0), vect3_create(0, 0, 1), 60.0f, 1.0f, 0.1f, 100.0f);
+
+    struct { Vect3 min, max; BOOL expected; const char* name; } boxes[] = {
+        {{10, -1, -1}, {11, 1, 1}, TRUE, "delante"},
+        {{-11, -1, -1}, {-10, 1, 1}, FALSE, "detrás"},
+        {{200, -1, -1}, {201, 1, 1}, FALSE, "más allá del plano lejano"},
+        {{10, 20, -1}, {11, 21, 1}, FALSE, "a un lado (63 grados)"},
+        {{10, 4, -1}, {11, 8, 1}, TRUE, "cruzando el plano izquierdo"},
+        {{-1, -1, -1}, {1, 1, 1}, TRUE, "con la cámara dentro"}
+    };
+    for (int b = 0; b < (int)(sizeof(boxes) / sizeof(boxes[0])); b++) {
+        BOOL result = frustum_intersects_box(&frustum, boxes[b].min, boxes[b].max);
+        if (result != boxes[b].expected) {
+            printf("   - Caja %s: %s (esperado %s) FALLO\n", boxes[b].name,
+                   result ? "visible" : "descartada", boxes[b].expected ? "visible" : "descartada");
+            ok = FALSE;
+        }
+    }
+    printf("   - Cajas conocidas: %d casos %s\n", (int)(sizeof(boxes) / sizeof(boxes[0])), ok ? "OK" : "FALLO");
+
+    // Planes against the projection: un punto está dentro de los seis planos si y solo si
+    // su posición de clip cumple |x|, |y|, |z| <= w
+    Matrix4x4 viewProjection = matrix4x4_multiply(
+        matrix4x4_look_at(vect3_create(3, -2, 5), vect3_create(10, 4, 1), vect3_create(0, 0, 1)),
+        matrix4x4_perspective(70.0f, 16.0f / 9.0f, 0.5f, 80.0f));
+    frustum_from_view_projection(&frustum, viewProjection);
+    uint32 seed = 12345u;
+    int mismatches = 0, insideCount = 0;
+    for (int i = 0; i < 20000; i++) {
+        float p[3] = {next_test_float(&seed, 100.0f), next_test_float(&seed, 100.0f), next_test_float(&seed, 100.0f)};
+        float clip[4];
+        for (int j = 0; j < 4; j++) {
+            clip[j] = p[0] * viewProjection.m[0][j] + p[1] * viewProjection.m[1][j] +
+                      p[2] * viewProjection.m[2][j] + viewProjection.m[3][j];
+        }
+        BOOL inClip = fabsf(clip[0]) <= clip[3] && fabsf(clip[1]) <= clip[3] && fabsf(clip[2]) <= clip[3];
+        Vect3 point = vect3_create(p[0], p[1], p[2]);
+        BOOL inPlanes = frustum_intersects_box(&frustum, point, point);
+        mismatches += inClip != inPlanes;
+        insideCount += inClip;
+    }
+    // Un punto a menos de un ulp de un plano puede caer a cualquier lado: se tolera alguno
+    BOOL planesOk = mismatches <= 2 && insideCount > 0;
+    printf("   - Planos frente a clip: %d puntos dentro, %d discrepancias %s\n",
+           insideCount, mismatches, planesOk ? "OK" : "FALLO");
+    ok &= planesOk;
+
+    // Kernel (SSE + resto escalar) against the reference test, con un número de cajas no múltiplo de 4
+    enum { KERNEL_BOXES = 1003 };
+    static float minX[KERNEL_BOXES], minY[KERNEL_BOXES], minZ[KERNEL_BOXES];
+    static uint8 visible[KERNEL_BOXES];
+    int expectedVisible = 0, kernelMismatches = 0;
+    for (int i = 0; i < KERNEL_BOXES; i++) {
+        minX[i] = next_test_float(&seed, 90.0f);
+        minY[i] = next_test_float(&seed, 90.0f);
+        minZ[i] = next_test_float(&seed, 90.0f);
+    }
+    int kernelVisible = cull_boxes_in_frustum(&frustum, minX, minY, minZ, KERNEL_BOXES, 16.0f, visible);
+    for (int i = 0; i < KERNEL_BOXES; i++) {
+        BOOL expected = frustum_intersects_box(&frustum, vect3_create(minX[i], minY[i], minZ[i]),
+                                               vect3_create(minX[i] + 16.0f, minY[i] + 16.0f, minZ[i] + 16.0f));
+        expectedVisible += expected;
+        kernelMismatches += expected != (BOOL)visible[i];
+    }
+    BOOL kernelOk = kernelMismatches == 0 && kernelVisible == expectedVisible;
+    printf("   - Kernel empaquetado: %d de %d cajas visibles, igual que la prueba de referencia %s\n",
+           kernelVisible, KERNEL_BOXES, kernelOk ? "OK" : "FALLO");
+    ok &= kernelOk;
+
+    // Chunks: cámara en el centro del chunk (0, 0, 0) mirando a +X. El de detrás (-1, 0, 0)
+    // queda fuera, el de delante y el propio dentro.
+    ChunkManager* manager = create_chunk_manager(32, 1);
+    if (manager) {
+        manager->evictionPolicy.saveDirectory[0] = '\0';
+        for (int cx = -1; cx <= 1; cx++) {
+            for (int cy = -1; cy <= 1; cy++) {
+                VoxelChunk* chunk = get_or_create_chunk(manager, cx, cy, 0);
+                if (chunk) chunk->isGenerated = TRUE;
+            }
+        }
+        frustum_from_camera(&frustum, vect3_create(7.5f, 7.5f, 7.5f), vect3_create(8.5f, 7.5f, 7.5f),
+                            vect3_create(0, 0, 1), 60.0f, 16.0f / 9.0f, 0.1f, 200.0f);
+        ChunkCullStats stats = update_chunk_frustum_visibility(manager, &frustum);
+        VoxelChunk* behind = find_chunk(manager, -1, 0, 0);
+        VoxelChunk* ahead = find_chunk(manager, 1, 0, 0);
+        VoxelChunk* own = find_chunk(manager, 0, 0, 0);
+        BOOL chunksOk = stats.tested == 9 && behind && !behind->isVisible && ahead && ahead->isVisible &&
+                        own && own->isVisible && stats.visible < stats.tested;
+        printf("   - Chunks 3x3 mirando a +X: %d de %d visibles, el de detrás descartado %s\n",
+               stats.visible, stats.tested, chunksOk ? "OK" : "FALLO");
+        ok &= chunksOk;
+        destroy_chunk_manager(manager);
+    } else {
+        ok = FALSE;
+    }
+
+    printf("   - Frustum culling: %s\n", ok ? "OK" : "FALLO");
+    return ok;
+}
+
+// Reference connectivity: BFS celda a celda, sin columnas de bits
+static uint16 reference_connectivity(const uint16 opaqueMask[CHUNK_SIZE][CHUNK_SIZE]) {
+    static uint8 seen[CHUNK_VOLUME];
+    static uint16 queue[CHUNK_VOLUME];
+    memset(seen, 0, sizeof(seen));
+    uint16 connectivity = 0;
+
+    for (int start = 0; start < CHUNK_VOLUME; start++) {
+        if (seen[start] || ((opaqueMask[start >> 8][(start >> 4) & 15] >> (start & 15)) & 1)) continue;
+        int head = 0, tail = 0, faces = 0;
+        seen[start] = 1;
+        queue[tail++] = (uint16)start;
+        while (head < tail) {
+            int cell = queue[head++];
+            int p[3] = {cell >> 8, (cell >> 4) & 15, cell & 15};
+            for (int face = 0; face < CHUNK_FACE_COUNT; face++) {
+                int n[3] = {p[0] + k_chunk_face_offsets[face][0], p[1] + k_chunk_face_offsets[face][1],
+                            p[2] + k_chunk_face_offsets[face][2]};
+                if (n[0] < 0 || n[0] >= CHUNK_SIZE || n[1] < 0 || n[1] >= CHUNK_SIZE || n[2] < 0 || n[2] >= CHUNK_SIZE) {
+                    faces |= 1 << face;
+                    continue;
+                }
+                int next = (n[0] << 8) | (n[1] << 4) | n[2];
+                if (seen[next] || ((opaqueMask[n[0]][n[1]] >> n[2]) & 1)) continue;
+                seen[next] = 1;
+                queue[tail++] = (uint16)next;
+            }
+        }
+        for (int a = 0; a < CHUNK_FACE_COUNT; a++)
+            for (int b = a + 1; b < CHUNK_FACE_COUNT; b++)
+                if ((faces >> a & 1) && (faces >> b & 1)) connectivity |= (uint16)(1u << chunk_face_pair_bit(a, b));
+    }
+    return connectivity;
+}
+
+BOOL verify_cave_culling(void) {
+    static uint16 opaque[CHUNK_SIZE][CHUNK_SIZE];
+    BOOL ok = TRUE;
+
+    // Túneles conocidos en un chunk macizo
+    struct { const char* name; uint16 expected; } cases[5] = {
+        {"macizo", 0},
+        {"aire", CHUNK_CONNECTIVITY_ALL},
+        {"túnel en X", (uint16)(1u << chunk_face_pair_bit(0, 1))},
+        {"codo de -X a +Z", (uint16)(1u << chunk_face_pair_bit(1, 4))},
+        {"túneles X e Y separados", (uint16)((1u << chunk_face_pair_bit(0, 1)) | (1u << chunk_face_pair_bit(2, 3)))}
+    };
+    for (int c = 0; c < 5; c++) {
+        uint16 fill = c == 1 ? 0 : 0xFFFF;
+        for (int x = 0; x < CHUNK_SIZE; x++)
+            for (int y = 0; y < CHUNK_SIZE; y++)
+                opaque[x][y] = fill;
+        if (c == 2) {
+            for (int x = 0; x < CHUNK_SIZE; x++) opaque[x][8] &= (uint16)~(1u << 8);
+        } else if (c == 3) {
+            for (int x = 0; x <= 8; x++) opaque[x][8] &= (uint16)~(1u << 8);
+            opaque[8][8] &= 0x00FF;
+        } else if (c == 4) {
+            for (int x = 0; x < CHUNK_SIZE; x++) opaque[x][3] &= (uint16)~(1u << 3);
+            for (int y = 0; y < CHUNK_SIZE; y++) opaque[12][y] &= (uint16)~(1u << 12);
+        }
+        uint16 connectivity = compute_chunk_connectivity(opaque);
+        if (connectivity != cases[c].expected) {
+            printf("   - Conectividad %s: 0x%04X (esperado 0x%04X) FALLO\n", cases[c].name, connectivity, cases[c].expected);
+            ok = FALSE;
+        }
+    }
+    printf("   - Túneles conocidos: 5 casos %s\n", ok ? "OK" : "FALLO");
+
+    // Cuevas aleatorias de varias densidades frente al BFS celda a celda, con tiempo por chunk
+    uint32 seed = 777u;
+    int mismatches = 0, patterns = 0;
+    LARGE_INTEGER freq, start, end;
+    double fastSeconds = 0.0, referenceSeconds = 0.0;
+    QueryPerformanceFrequency(&freq);
+    for (int density = 30; density <= 75; density += 5) {
+        for (int pattern = 0; pattern < 8; pattern++) {
+            for (int x = 0; x < CHUNK_SIZE; x++) {
+                for (int y = 0; y < CHUNK_SIZE; y++) {
+                    uint16 column = 0;
+                    for (int z = 0; z < CHUNK_SIZE; z++) {
+                        seed = seed * 1664525u + 1013904223u;
+                        if ((int)((seed >> 16) % 100) < density) column |= (uint16)(1u << z);
+                    }
+                    opaque[x][y] = column;
+                }
+            }
+            QueryPerformanceCounter(&start);
+            uint16 fast = compute_chunk_connectivity(opaque);
+            QueryPerformanceCounter(&end);
+            fastSeconds += (double)(end.QuadPart - start.QuadPart) / (double)freq.QuadPart;
+            QueryPerformanceCounter(&start);
+            uint16 reference = reference_connectivity(opaque);
+            QueryPerformanceCounter(&end);
+            referenceSeconds += (double)(end.QuadPart - start.QuadPart) / (double)freq.QuadPart;
+            mismatches += fast != reference;
+            patterns++;
+        }
+    }
+    BOOL randomOk = mismatches == 0;
+    printf("   - Cuevas aleatorias (30-75%% opaco): %d de %d iguales al BFS por celda, %.1f us/chunk (referencia %.1f us) %s\n",
+           patterns - mismatches, patterns, fastSeconds * 1e6 / patterns, referenceSeconds * 1e6 / patterns,
+           randomOk ? "OK" : "FALLO");
+    ok &= randomOk;
+
+    // Columna de tres chunks: cámara en el de arriba (aire), suelo macizo y debajo una cueva.
+    // La cueva queda descartada hasta que se abre un pozo en el suelo, y vuelve a descartarse
+    // al taparlo; cada edición recalcula solo el chunk tocado.
+    ChunkManager* manager = create_chunk_manager(32, 1);
+    if (manager) {
+        manager->evictionPolicy.saveDirectory[0] = '\0';
+        for (int cz = -1; cz <= 1; cz++) {
+            VoxelChunk* chunk = get_or_create_chunk(manager, 0, 0, cz);
+            if (chunk) chunk->isGenerated = TRUE;
+        }
+        fill_block_region(manager, 0, 0, 0, 15, 15, 15, VOXEL_STONE);
+        fill_block_region(manager, 0, 0, -16, 15, 15, -13, VOXEL_STONE);
+        flush_remesh_queue(manager);
+
+        Vect3 camera = vect3_create(8, 8, 24);
+        int rejected[3];
+        update_chunk_frustum_visibility(manager, NULL);
+        rejected[0] = update_chunk_cave_visibility(manager, camera);
+        VoxelChunk* cave = find_chunk(manager, 0, 0, -1);
+        BOOL caveHidden = cave && !cave->isVisible;
+
+        fill_block_region(manager, 8, 8, 0, 8, 8, 15, VOXEL_AIR);
+        flush_remesh_queue(manager);
+        update_chunk_frustum_visibility(manager, NULL);
+        rejected[1] = update_chunk_cave_visibility(manager, camera);
+        BOOL caveShown = cave && cave->isVisible;
+
+        fill_block_region(manager, 8, 8, 15, 8, 8, 15, VOXEL_STONE);
+        flush_remesh_queue(manager);
+        update_chunk_frustum_visibility(manager, NULL);
+        rejected[2] = update_chunk_cave_visibility(manager, camera);
+
+        BOOL columnOk = caveHidden && rejected[0] == 1 && caveShown && rejected[1] == 0 && rejected[2] == 1;
+        printf("   - Cueva bajo suelo macizo: %d descartado, con pozo %d, pozo tapado %d %s\n",
+               rejected[0], rejected[1], rejected[2], columnOk ? "OK" : "FALLO");
+        ok &= columnOk;
+        destroy_chunk_manager(manager);
+    } else {
+        ok = FALSE;
+    }
+
+    printf("   - Cave culling: %s\n", ok ? "OK" : "FALLO");
+    return ok;
+}
+
+void benchmark_frustum_culling(int chunkCount, int iterations) {
+    if (chunkCount <= 0 || iterations <= 0) return;
+
+    float* minX = (float*)safe_malloc(chunkCount * sizeof(float));
+    float* minY = (float*)safe_malloc(chunkCount * sizeof(float));
+    float* minZ = (float*)safe_malloc(chunkCount * sizeof(float));
+    uint8* visible = (uint8*)safe_malloc(chunkCount);
+    if (!minX || !minY || !minZ || !visible) {
+        safe_free(minX);
+        safe_free(minY);
+        safe_free(minZ);
+        safe_free(visible);
+        return;
+    }
+
+    // Losa de chunks de 8 de alto alrededor de la cámara, como un radio de carga grande
+    int side = 1;
+    while (side * side * 8 < chunkCount) side++;
+    for (int i = 0; i < chunkCount; i++) {
+        minX[i] = ((i / 8) % side - side / 2) * (float)CHUNK_SIZE - 0.5f;
+        minY[i] = ((i / 8) / side - side / 2) * (float)CHUNK_SIZE - 0.5f;
+        minZ[i] = (i % 8 - 4) * (float)CHUNK_SIZE - 0.5f;
+    }
+
+    Frustum frustum;
+    frustum_from_camera(&frustum, vect3_create(0, 0, 20), vect3_create(1, 0.3f, 19.8f), vect3_create(0, 0, 1),
+                        70.0f, 16.0f / 9.0f, 0.1f, side * (float)CHUNK_SIZE);
+
+    LARGE_INTEGER freq, start, end;
+    QueryPerformanceFrequency(&freq);
+    double seconds[3] = {0.0, 0.0, 0.0};
+    int visibleCount[3] = {0, 0, 0};
+    volatile int sink = 0;
+    float offsets[6];
+    plane_offsets(&frustum, (float)CHUNK_SIZE, offsets);
+
+    // Alternating rounds, the best of each (el reloj varía entre pasadas)
+    for (int round = 0; round < 3; round++) {
+        for (int method = 0; method < 3; method++) {
+            QueryPerformanceCounter(&start);
+            for (int it = 0; it < iterations; it++) {
+                int count = 0;
+                if (method == 0) {
+                    for (int i = 0; i < chunkCount; i++) {
+                        count += frustum_intersects_box(&frustum, vect3_create(minX[i], minY[i], minZ[i]),
+                                                        vect3_create(minX[i] + CHUNK_SIZE, minY[i] + CHUNK_SIZE, minZ[i] + CHUNK_SIZE));
+                    }
+                } else if (method == 1) {
+                    count = cull_boxes_scalar(&frustum, offsets, minX, minY, minZ, 0, chunkCount, visible);
+                } else {
+                    count = cull_boxes_in_frustum(&frustum, minX, minY, minZ, chunkCount, (float)CHUNK_SIZE, visible);
+                }
+                sink += count;
+                visibleCount[method] = count;
+            }
+            QueryPerformanceCounter(&end);
+            double elapsed = (double)(end.QuadPart - start.QuadPart) / (double)freq.QuadPart / iterations;
+            if (round == 0 || elapsed < seconds[method]) seconds[method] = elapsed;
+        }
+    }
+    (void)sink;
+
+    const char* names[3] = {"caja por caja", "empaquetado", "empaquetado SSE"};
+    for (int method = 0; method < 3; method++) {
+        printf("   - %-16s: %d chunks, %d visibles (%.0f%% descartados), %.1f us por frame, %.2f ns/chunk\n",
+               names[method], chunkCount, visibleCount[method],
+               100.0f * (chunkCount - visibleCount[method]) / chunkCount,
+               seconds[method] * 1e6, seconds[method] * 1e9 / chunkCount);
+    }
+#ifndef __SSE__
+    printf("   - (sin SSE en esta compilación: el kernel usa el camino escalar)\n");
+#endif
+
+    safe_free(minX);
+    safe_free(minY);
+    safe_free(minZ);
+    safe_free(visible);
+}
@@ -0,0 +1,1767 @@
+#include "world/chunk_mesh.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+static BOOL g_bake_ao = TRUE;  // Copiado a cada snapshot (set_chunk_mesh_ao)
+
+// Per-face geometry in BLOCK_FACE_* bit order (+X, -X, +Y, -Y, +Z, -Z)
+// axes: eje normal, eje u, eje v. Las esquinas (u, v) siguen el winding de las caras
+// que dibujaba render_test_environment, así el back-face culling no cambia.
+static const int k_face_axes[6][3] = {
+    {0, 1, 2}, {0, 1, 2}, {1, 0, 2}, {1, 0, 2}, {2, 0, 1}, {2, 0, 1}
+};
+
+static const uint8 k_face_corners[6][4][2] = {
+    {{0, 0}, {1, 0}, {1, 1}, {0, 1}},  // RIGHT
+    {{0, 0}, {0, 1}, {1, 1}, {1, 0}},  // LEFT
+    {{0, 0}, {0, 1}, {1, 1}, {1, 0}},  // FRONT
+    {{0, 0}, {1, 0}, {1, 1}, {0, 1}},  // BACK
+    {{0, 0}, {1, 0}, {1, 1}, {0, 1}},  // TOP
+    {{0, 0}, {0, 1}, {1, 1}, {1, 0}}   // BOTTOM
+};
+
+static const int8 k_face_normals[6][3] = {
+    {1, 0, 0}, {-1, 0, 0}, {0, 1, 0}, {0, -1, 0}, {0, 0, 1}, {0, 0, -1}
+};
+
+void chunk_mesh_init(ChunkMesh* mesh) {
+    if (!mesh) return;
+    memset(mesh, 0, sizeof(ChunkMesh));
+}
+
+void chunk_mesh_free(ChunkMesh* mesh) {
+    if (!mesh) return;
+    safe_free(mesh->vertices);
+    safe_free(mesh->indices);
+    memset(mesh, 0, sizeof(ChunkMesh));
+}
+
+void chunk_mesh_clear(ChunkMesh* mesh) {
+    if (!mesh) return;
+    mesh->vertexCount = 0;
+    mesh->indexCount = 0;
+    memset(mesh->layerIndexCount, 0, sizeof(mesh->layerIndexCount));
+    mesh->lodLevel = 0;
+}
+
+// Make room for one more quad (la capacidad se duplica y se conserva entre builds)
+static BOOL reserve_quad(ChunkMesh* mesh) {
+    if (mesh->vertexCount + 4 <= mesh->vertexCapacity && mesh->indexCount + 6 <= mesh->indexCapacity) {
+        return TRUE;
+    }
+
+    int quads = mesh->vertexCapacity / 4;
+    int newQuads = quads > 0 ? quads * 2 : 256;
+    if (newQuads > CHUNK_MESH_MAX_QUADS) newQuads = CHUNK_MESH_MAX_QUADS;
+    if (newQuads <= quads) return FALSE;
+
+    ChunkVertex* vertices = (ChunkVertex*)safe_malloc(newQuads * 4 * sizeof(ChunkVertex));
+    uint16* indices = (uint16*)safe_malloc(newQuads * 6 * sizeof(uint16));
+    if (!vertices || !indices) {
+        safe_free(vertices);
+        safe_free(indices);
+        return FALSE;
+    }
+
+    if (mesh->vertexCount > 0) memcpy(vertices, mesh->vertices, mesh->vertexCount * sizeof(ChunkVertex));
+    if (mesh->indexCount > 0) memcpy(indices, mesh->indices, mesh->indexCount * sizeof(uint16));
+    safe_free(mesh->vertices);
+    safe_free(mesh->indices);
+    mesh->vertices = vertices;
+    mesh->indices = indices;
+    mesh->vertexCapacity = newQuads * 4;
+    mesh->indexCapacity = newQuads * 6;
+    return TRUE;
+}
+
+// Emit one quad covering width x height voxels along the face's u and v axes.
+// ao: 2 bits por esquina en el orden de k_face_corners (CHUNK_AO_NONE = sin oclusión).
+static BOOL emit_quad(ChunkMesh* mesh, int face, int x, int y, int z, int width, int height,
+                      uint8 block, uint8 tint, uint8 ao) {
+    if (!reserve_quad(mesh)) return FALSE;
+
+    int base[3] = {x, y, z};
+    int normalAxis = k_face_axes[face][0];
+    int uAxis = k_face_axes[face][1];
+    int vAxis = k_face_axes[face][2];
+    if (!(face & 1)) base[normalAxis] += 1; // Caras positivas: plano en el lado +1 del bloque
+
+    uint16 first = (uint16)mesh->vertexCount;
+    uint32 material = chunk_vertex_pack_material(block, tint);
+    int cornerAo[4];
+    for (int i = 0; i < 4; i++) {
+        int corner[3] = {base[0], base[1], base[2]};
+        corner[uAxis] += k_face_corners[face][i][0] * width;
+        corner[vAxis] += k_face_corners[face][i][1] * height;
+        cornerAo[i] = (ao >> (i * 2)) & 3;
+
+        ChunkVertex* v = &mesh->vertices[mesh->vertexCount++];
+        v->position = chunk_vertex_pack_position(corner[0], corner[1], corner[2], face, cornerAo[i]);
+        v->material = material;
+    }
+
+    // Quad flip: la diagonal compartida une las esquinas más claras, así la interpolación
+    // del AO es simétrica (sin la franja oscura en diagonal)
+    int pivot = (cornerAo[0] + cornerAo[2] < cornerAo[1] + cornerAo[3]) ? 1 : 0;
+    uint16* index = &mesh->indices[mesh->indexCount];
+    index[0] = first + pivot;
+    index[1] = first + (pivot + 1) % 4;
+    index[2] = first + (pivot + 2) % 4;
+    index[3] = first + pivot;
+    index[4] = first + (pivot + 2) % 4;
+    index[5] = first + (pivot + 3) % 4;
+    mesh->indexCount += 6;
+    return TRUE;
+}
+
+// ============================================================================
+// SNAPSHOT - copia del chunk y de su borde de 1 voxel tomada al empezar el remesh
+// ============================================================================
+
+// Chunk holding padded coordinate p (0..17) along one axis, and its local coordinate
+static inline int padded_chunk_offset(int p, int* local) {
+    if (p == 0) {
+        *local = 15;
+        return -1;
+    }
+    if (p == CHUNK_PADDED_SIZE - 1) {
+        *local = 0;
+        return 1;
+    }
+    *local = p - 1;
+    return 0;
+}
+
+// Padded range covered by neighbour offset d along one axis
+static inline void padded_range(int d, int* first, int* last) {
+    *first = d < 0 ? 0 : (d > 0 ? CHUNK_PADDED_SIZE - 1 : 1);
+    *last = d < 0 ? 0 : (d > 0 ? CHUNK_PADDED_SIZE - 1 : CHUNK_SIZE);
+}
+
+typedef uint16 ChunkColumnMasks[CHUNK_SIZE][CHUNK_SIZE];
+
+static inline const ChunkColumnMasks* column_masks(const VoxelChunk* chunk, BOOL opaque) {
+    if (!chunk) return NULL;
+    return opaque ? (const ChunkColumnMasks*)&chunk->opaqueMask : (const ChunkColumnMasks*)&chunk->occupiedMask;
+}
+
+// Neighbour seen by the padding. Un vecino de cara a otro nivel de detalle cuenta como aire:
+// cada lado dibuja su pared del borde y la costura queda cerrada (los de arista y esquina
+// solo aportan AO y se leen siempre)
+static inline VoxelChunk* padding_neighbor(VoxelChunk* chunk, int dx, int dy, int dz) {
+    VoxelChunk* neighbor = chunk->neighbors[chunk_neighbor_index(dx, dy, dz)];
+    if (neighbor && abs(dx) + abs(dy) + abs(dz) == 1 && neighbor->lodLevel != chunk->lodLevel) return NULL;
+    return neighbor;
+}
+
+// Padded columns: bit z + 1 = bloque z, con el bloque de debajo en el bit 0 y el de
+// encima en el bit 17. Los chunks no cargados cuentan como aire.
+static void build_padded_columns(uint32 columns[CHUNK_PADDED_SIZE][CHUNK_PADDED_SIZE], VoxelChunk* chunk, BOOL opaque) {
+    for (int dx = -1; dx <= 1; dx++) {
+        for (int dy = -1; dy <= 1; dy++) {
+            const ChunkColumnMasks* below = column_masks(padding_neighbor(chunk, dx, dy, -1), opaque);
+            const ChunkColumnMasks* middle = column_masks((dx || dy) ? padding_neighbor(chunk, dx, dy, 0) : chunk, opaque);
+            const ChunkColumnMasks* above = column_masks(padding_neighbor(chunk, dx, dy, 1), opaque);
+            int firstX, lastX, firstY, lastY;
+            padded_range(dx, &firstX, &lastX);
+            padded_range(dy, &firstY, &lastY);
+
+            for (int X = firstX; X <= lastX; X++) {
+                int x;
+                padded_chunk_offset(X, &x);
+                for (int Y = firstY; Y <= lastY; Y++) {
+                    int y;
+                    padded_chunk_offset(Y, &y);
+                    uint32 column = middle ? (uint32)(*middle)[x][y] << 1 : 0;
+                    if (below) column |= (uint32)(*below)[x][y] >> 15;
+                    if (above) column |= ((uint32)(*above)[x][y] & 1u) << 17;
+                    columns[X][Y] = column;
+                }
+            }
+        }
+    }
+}
+
+// Bits set in a nibble: las celdas tienen como mucho 4 bloques de alto
+static const uint8 k_nibble_bits[16] = {0, 1, 1, 2, 1, 2, 2, 3, 1, 2, 2, 3, 2, 3, 3, 4};
+
+// CHUNK_LOD_CELL_* flags of the cell of scale^3 blocks at (x0, y0, z0), solo con las máscaras
+static uint8 lod_cell_flags(const uint16 occupied[CHUNK_SIZE][CHUNK_SIZE], const uint16 opaque[CHUNK_SIZE][CHUNK_SIZE],
+                            int x0, int y0, int z0, int scale) {
+    uint16 bits = (uint16)((1u << scale) - 1u);
+    int occupiedCount = 0, opaqueCount = 0;
+    for (int x = x0; x < x0 + scale; x++) {
+        for (int y = y0; y < y0 + scale; y++) {
+            occupiedCount += k_nibble_bits[(occupied[x][y] >> z0) & bits];
+            opaqueCount += k_nibble_bits[(opaque[x][y] >> z0) & bits];
+        }
+    }
+
+    int volume = scale * scale * scale;
+    uint8 flags = 0;
+    if (occupiedCount * 2 >= volume) flags |= CHUNK_LOD_CELL_OCCUPIED;
+    if (opaqueCount * 2 >= volume) flags |= CHUNK_LOD_CELL_OPAQUE;
+    return flags;
+}
+
+// Neighbour cells touching each face, calculadas como las calcula el propio vecino
+static void build_lod_border(ChunkMeshSnapshot* snapshot, VoxelChunk* chunk) {
+    int scale = 1 << snapshot->lodLevel;
+    int cells = CHUNK_SIZE / scale;
+
+    memset(snapshot->lodBorder, 0, sizeof(snapshot->lodBorder));
+    for (int face = 0; face < 6; face++) {
+        const int8* normal = k_face_normals[face];
+        VoxelChunk* neighbor = padding_neighbor(chunk, normal[0], normal[1], normal[2]);
+        if (!neighbor) continue;
+
+        int normalAxis = k_face_axes[face][0];
+        int uAxis = k_face_axes[face][1];
+        int vAxis = k_face_axes[face][2];
+        for (int u = 0; u < cells; u++) {
+            for (int v = 0; v < cells; v++) {
+                int p[3];
+                p[normalAxis] = normal[normalAxis] > 0 ? 0 : cells - 1;
+                p[uAxis] = u;
+                p[vAxis] = v;
+                snapshot->lodBorder[face][u][v] = lod_cell_flags(neighbor->occupiedMask, neighbor->opaqueMask,
+                                                                 p[0] * scale, p[1] * scale, p[2] * scale, scale);
+            }
+        }
+    }
+}
+
+BOOL take_chunk_mesh_snapshot(VoxelChunk* chunk, ChunkMeshSnapshot* snapshot) {
+    if (!chunk || !snapshot) return FALSE;
+
+    snapshot->chunkX = chunk->chunkX;
+    snapshot->chunkY = chunk->chunkY;
+    snapshot->chunkZ = chunk->chunkZ;
+    snapshot->colorSeed = chunk->colorSeed;
+    snapshot->meshMode = chunk->meshMode;
+    snapshot->bakeAo = g_bake_ao;
+    snapshot->lodLevel = chunk->lodLevel < CHUNK_LOD_COUNT ? chunk->lodLevel : CHUNK_LOD_COUNT - 1;
+    snapshot->isEmpty = is_chunk_empty(chunk);
+    snapshot->typeCount = 0;
+    if (snapshot->isEmpty) return TRUE;
+
+    // Block types present in the chunk (la paleta puede guardar alguno sin usar)
+    for (int p = 0; p < chunk->storage.paletteCount; p++) {
+        if (chunk->storage.palette[p] != VOXEL_AIR) {
+            snapshot->types[snapshot->typeCount++] = chunk->storage.palette[p];
+        }
+    }
+
+    // Block ids en orden [x][y][z]: con el layout lineal es el orden del almacenamiento
+#ifdef CHUNK_LAYOUT_MORTON
+    uint8 decoded[CHUNK_VOLUME];
+    chunk_storage_get_all(&chunk->storage, decoded);
+    for (int x = 0; x < CHUNK_SIZE; x++)
+        for (int y = 0; y < CHUNK_SIZE; y++)
+            for (int z = 0; z < CHUNK_SIZE; z++)
+                snapshot->blocks[x][y][z] = decoded[chunk_block_index(x, y, z)];
+#else
+    chunk_storage_get_all(&chunk->storage, &snapshot->blocks[0][0][0]);
+#endif
+
+    build_padded_columns(snapshot->occupiedCols, chunk, FALSE);
+    build_padded_columns(snapshot->opaqueCols, chunk, TRUE);
+    if (snapshot->lodLevel > 0) build_lod_border(snapshot, chunk);
+
+    // Render layer per type; los bloques translúcidos se marcan por columna para ocultar
+    // las caras entre ellos (agua contra agua)
+    snapshot->hasTranslucent = FALSE;
+    for (int t = 0; t < snapshot->typeCount; t++) {
+        uint8 type = snapshot->types[t];
+        snapshot->blockLayers[type] = (uint8)get_voxel_render_layer((VoxelType)type);
+        if (snapshot->blockLayers[type] == CHUNK_LAYER_TRANSLUCENT) snapshot->hasTranslucent = TRUE;
+    }
+    if (snapshot->hasTranslucent) {
+        for (int x = 0; x < CHUNK_SIZE; x++) {
+            for (int y = 0; y < CHUNK_SIZE; y++) {
+                uint16 candidates = chunk->occupiedMask[x][y] & (uint16)~chunk->opaqueMask[x][y];
+                uint16 translucent = 0;
+                while (candidates) {
+                    int z = __builtin_ctz(candidates);
+                    candidates &= candidates - 1;
+                    if (snapshot->blockLayers[snapshot->blocks[x][y][z]] == CHUNK_LAYER_TRANSLUCENT) translucent |= (uint16)(1u << z);
+                }
+                snapshot->translucentCols[x][y] = translucent;
+            }
+        }
+    }
+    return TRUE;
+}
+
+// Visible faces of every column at once: ocupado y sin bloque opaco en esa dirección,
+// también al otro lado del borde del chunk
+static void compute_face_columns(const ChunkMeshSnapshot* snapshot, uint16 faceCols[6][CHUNK_SIZE][CHUNK_SIZE]) {
+    for (int x = 0; x < CHUNK_SIZE; x++) {
+        for (int y = 0; y < CHUNK_SIZE; y++) {
+            int X = x + 1, Y = y + 1;
+            uint16 occupied = (uint16)(snapshot->occupiedCols[X][Y] >> 1);
+            uint32 opaque = snapshot->opaqueCols[X][Y];
+
+            faceCols[0][x][y] = occupied & (uint16)~(snapshot->opaqueCols[X + 1][Y] >> 1);
+            faceCols[1][x][y] = occupied & (uint16)~(snapshot->opaqueCols[X - 1][Y] >> 1);
+            faceCols[2][x][y] = occupied & (uint16)~(snapshot->opaqueCols[X][Y + 1] >> 1);
+            faceCols[3][x][y] = occupied & (uint16)~(snapshot->opaqueCols[X][Y - 1] >> 1);
+            faceCols[4][x][y] = occupied & (uint16)~(opaque >> 2);
+            faceCols[5][x][y] = occupied & (uint16)~opaque;
+        }
+    }
+    if (!snapshot->hasTranslucent) return;
+
+    // A translucent face is only visible against air: contra otro bloque no opaco
+    // (agua, vidrio, hojas) se oculta, así no hay caras internas en la mezcla
+    for (int x = 0; x < CHUNK_SIZE; x++) {
+        for (int y = 0; y < CHUNK_SIZE; y++) {
+            uint16 translucent = snapshot->translucentCols[x][y];
+            if (!translucent) continue;
+
+            int X = x + 1, Y = y + 1;
+            uint32 occupied = snapshot->occupiedCols[X][Y];
+            faceCols[0][x][y] &= (uint16)~(translucent & (snapshot->occupiedCols[X + 1][Y] >> 1));
+            faceCols[1][x][y] &= (uint16)~(translucent & (snapshot->occupiedCols[X - 1][Y] >> 1));
+            faceCols[2][x][y] &= (uint16)~(translucent & (snapshot->occupiedCols[X][Y + 1] >> 1));
+            faceCols[3][x][y] &= (uint16)~(translucent & (snapshot->occupiedCols[X][Y - 1] >> 1));
+            faceCols[4][x][y] &= (uint16)~(translucent & (occupied >> 2));
+            faceCols[5][x][y] &= (uint16)~(translucent & occupied);
+        }
+    }
+}
+
+// AO of the corner (u, v) = (0|2, 0|2) of a 3x3 neighbourhood: los dos laterales y la diagonal
+static inline uint32 corner_ao(uint32 around, int u, int v) {
+    uint32 side1 = (around >> (u * 3 + 1)) & 1;
+    uint32 side2 = (around >> (3 + v)) & 1;
+    uint32 corner = (around >> (u * 3 + v)) & 1;
+    return (3 - (side1 + side2 + corner)) * (1 - (side1 & side2));
+}
+
+// Standard 3-neighbour AO of the 4 corners of a face: por esquina, los dos laterales y la
+// diagonal de la celda de delante; dos laterales opacos encierran la esquina (0).
+// Los 3x3 vecinos de esa celda se leen de una vez: bit (du * 3 + dv), du/dv = 0..2 en u/v.
+static uint8 face_corner_ao(const ChunkMeshSnapshot* snapshot, int face, int x, int y, int z) {
+    int front = (face & 1) ? -1 : 1;
+    int X = x + 1, Y = y + 1;
+    uint32 around = 0;
+    if (face < 2) {
+        for (int du = 0; du < 3; du++) around |= ((snapshot->opaqueCols[X + front][Y + du - 1] >> z) & 7u) << (du * 3);
+    } else if (face < 4) {
+        for (int du = 0; du < 3; du++) around |= ((snapshot->opaqueCols[X + du - 1][Y + front] >> z) & 7u) << (du * 3);
+    } else {
+        int bit = z + 1 + front;
+        for (int du = 0; du < 3; du++)
+            for (int dv = 0; dv < 3; dv++)
+                around |= ((snapshot->opaqueCols[X + du - 1][Y + dv - 1] >> bit) & 1u) << (du * 3 + dv);
+    }
+
+    // k_face_corners solo tiene dos órdenes: (0,0) (1,0) (1,1) (0,1) en RIGHT, BACK y TOP,
+    // y el mismo con la segunda y la cuarta esquina cambiadas en el resto
+    uint32 ao00 = corner_ao(around, 0, 0), ao20 = corner_ao(around, 2, 0);
+    uint32 ao22 = corner_ao(around, 2, 2), ao02 = corner_ao(around, 0, 2);
+    if (face == 0 || face == 3 || face == 4) return (uint8)(ao00 | ao20 << 2 | ao22 << 4 | ao02 << 6);
+    return (uint8)(ao00 | ao02 << 2 | ao22 << 4 | ao20 << 6);
+}
+
+static BOOL report_mesh_overflow(const ChunkMeshSnapshot* snapshot) {
+    printf("ERROR: Sin memoria para el mesh del chunk (%d, %d, %d)\n",
+           snapshot->chunkX, snapshot->chunkY, snapshot->chunkZ);
+    return FALSE;
+}
+
+// Bit z: some opaque block in z-1..z+1 (bits z..z+2 de la columna con borde)
+static inline uint16 dilate_column_z(uint32 column) {
+    return (uint16)(column | (column >> 1) | (column >> 2));
+}
+
+// OR of the 16 columns of one row, 4 por palabra: se compara con column_word sin plegar
+static inline uint64 or_face_row(const uint16 row[CHUNK_SIZE]) {
+    uint64 words[CHUNK_SIZE / 4];
+    memcpy(words, row, sizeof(words));
+    return words[0] | words[1] | words[2] | words[3];
+}
+
+// Column mask repeated in the 4 columns of a word
+static inline uint64 column_word(uint16 column) {
+    return column * 0x0001000100010001ULL;
+}
+
+// Faces with an opaque block around the cell in front of them, en el plano de la cara:
+// solo esas tienen alguna esquina con AO < 3. La propia celda de delante no es opaca
+// (si no, la cara no sería visible), así que entra en la dilatación sin cambiar nada.
+// Solo se miran las columnas y direcciones con caras visibles: en terreno normal casi
+// todas las columnas tienen como mucho la cara de arriba. layers: por cara, las capas con
+// alguna cara ocluida (bits z en ±Z, x en ±X, y en ±Y). Devuelve FALSE si no hay ninguna.
+static BOOL compute_occluded_columns(const ChunkMeshSnapshot* snapshot, uint16 faceCols[6][CHUNK_SIZE][CHUNK_SIZE],
+                                     uint16 occluded[6][CHUNK_SIZE][CHUNK_SIZE], uint32 layers[6]) {
+    const uint32 (*opaque)[CHUNK_PADDED_SIZE] = snapshot->opaqueCols;
+    uint32 rowOpaque[CHUNK_PADDED_SIZE];  // [X]: OR de las columnas opacas con ese X
+    uint32 colOpaque[CHUNK_PADDED_SIZE];  // [Y]: lo mismo con ese Y
+    uint16 colFaces[2][CHUNK_SIZE];       // ±Y: OR de las caras de cada capa y
+
+    // Descarte por filas y capas: si ninguna capa con caras tiene bloques opacos en las
+    // filas de al lado (terreno llano, subsuelo, bordes hacia chunks sin cargar) no se mira
+    // columna a columna. Los OR van por palabras de 64 bits: 2 columnas con borde o 4 sin él
+    uint64 colWords[CHUNK_PADDED_SIZE / 2];
+    memset(colWords, 0, sizeof(colWords));
+    for (int X = 0; X < CHUNK_PADDED_SIZE; X++) {
+        uint64 words[CHUNK_PADDED_SIZE / 2];
+        uint64 row = 0;
+        memcpy(words, opaque[X], sizeof(words));
+        for (int i = 0; i < CHUNK_PADDED_SIZE / 2; i++) {
+            row |= words[i];
+            colWords[i] |= words[i];
+        }
+        rowOpaque[X] = (uint32)(row | row >> 32);
+    }
+    memcpy(colOpaque, colWords, sizeof(colOpaque));
+
+    uint64 faceWords[2][CHUNK_SIZE / 4];
+    memset(faceWords, 0, sizeof(faceWords));
+    for (int x = 0; x < CHUNK_SIZE; x++) {
+        for (int face = 0; face < 2; face++) {
+            uint64 words[CHUNK_SIZE / 4];
+            memcpy(words, faceCols[face + 2][x], sizeof(words));
+            for (int i = 0; i < CHUNK_SIZE / 4; i++) faceWords[face][i] |= words[i];
+        }
+    }
+    memcpy(colFaces, faceWords, sizeof(colFaces));
+    uint16 checkY[2] = {0, 0};  // bit y: capas de ±Y con caras y bloques opacos delante
+    for (int y = 0; y < CHUNK_SIZE; y++) {
+        checkY[0] |= (colFaces[0][y] & dilate_column_z(colOpaque[y + 2])) ? (uint16)(1u << y) : 0;
+        checkY[1] |= (colFaces[1][y] & dilate_column_z(colOpaque[y])) ? (uint16)(1u << y) : 0;
+    }
+
+    BOOL cleared = FALSE;  // occluded solo se usa si alguna fila pasa el descarte
+    memset(layers, 0, sizeof(uint32) * 6);
+    for (int x = 0; x < CHUNK_SIZE; x++) {
+        int X = x + 1;
+        uint32 near = rowOpaque[X - 1] | rowOpaque[X] | rowOpaque[X + 1];
+        BOOL checkX0 = (or_face_row(faceCols[0][x]) & column_word(dilate_column_z(rowOpaque[X + 1]))) != 0;
+        BOOL checkX1 = (or_face_row(faceCols[1][x]) & column_word(dilate_column_z(rowOpaque[X - 1]))) != 0;
+        BOOL checkZ = ((or_face_row(faceCols[4][x]) & column_word((uint16)(near >> 2))) |
+                       (or_face_row(faceCols[5][x]) & column_word((uint16)near))) != 0;
+        uint32 columns = (checkX0 | checkX1 | checkZ) ? 0xFFFFu : (uint32)(checkY[0] | checkY[1]);
+        if (columns && !cleared) {
+            memset(occluded, 0, sizeof(uint16) * 6 * CHUNK_SIZE * CHUNK_SIZE);
+            cleared = TRUE;
+        }
+
+        while (columns) {
+            int y = __builtin_ctz(columns);
+            int Y = y + 1;
+            columns &= columns - 1;
+            if (checkX0 && faceCols[0][x][y]) {
+                occluded[0][x][y] = faceCols[0][x][y] &
+                    dilate_column_z(opaque[X + 1][Y - 1] | opaque[X + 1][Y] | opaque[X + 1][Y + 1]);
+            }
+            if (checkX1 && faceCols[1][x][y]) {
+                occluded[1][x][y] = faceCols[1][x][y] &
+                    dilate_column_z(opaque[X - 1][Y - 1] | opaque[X - 1][Y] | opaque[X - 1][Y + 1]);
+            }
+            if (((checkY[0] >> y) & 1) && faceCols[2][x][y]) {
+                occluded[2][x][y] = faceCols[2][x][y] &
+                    dilate_column_z(opaque[X - 1][Y + 1] | opaque[X][Y + 1] | opaque[X + 1][Y + 1]);
+            }
+            if (((checkY[1] >> y) & 1) && faceCols[3][x][y]) {
+                occluded[3][x][y] = faceCols[3][x][y] &
+                    dilate_column_z(opaque[X - 1][Y - 1] | opaque[X][Y - 1] | opaque[X + 1][Y - 1]);
+            }
+            if (checkZ && (faceCols[4][x][y] | faceCols[5][x][y])) {
+                uint32 around = opaque[X - 1][Y - 1] | opaque[X][Y - 1] | opaque[X + 1][Y - 1] |
+                                opaque[X - 1][Y] | opaque[X][Y] | opaque[X + 1][Y] |
+                                opaque[X - 1][Y + 1] | opaque[X][Y + 1] | opaque[X + 1][Y + 1];
+                occluded[4][x][y] = faceCols[4][x][y] & (uint16)(around >> 2);
+                occluded[5][x][y] = faceCols[5][x][y] & (uint16)around;
+            }
+            if (occluded[0][x][y] | occluded[1][x][y]) {
+                layers[0] |= occluded[0][x][y] ? 1u << x : 0;
+                layers[1] |= occluded[1][x][y] ? 1u << x : 0;
+            }
+            if (occluded[2][x][y] | occluded[3][x][y]) {
+                layers[2] |= occluded[2][x][y] ? 1u << y : 0;
+                layers[3] |= occluded[3][x][y] ? 1u << y : 0;
+            }
+            layers[4] |= occluded[4][x][y];
+            layers[5] |= occluded[5][x][y];
+        }
+    }
+    return (layers[0] | layers[1] | layers[2] | layers[3] | layers[4] | layers[5]) != 0;
+}
+
+// Greedy merge of one slice given as 16 rows of bits: row index = u, bit = v.
+// Cada rectángulo sale de un tramo de bits consecutivos que se extiende a las filas
+// siguientes mientras contengan el mismo tramo.
+static BOOL merge_face_rows(ChunkMesh* mesh, uint16 rows[16], int face, int d, uint8 block, uint8 ao) {
+    int normalAxis = k_face_axes[face][0];
+    int uAxis = k_face_axes[face][1];
+    int vAxis = k_face_axes[face][2];
+
+    for (int u = 0; u < 16; u++) {
+        uint32 row = rows[u];
+        while (row) {
+            int v = __builtin_ctz(row);
+            int length = __builtin_ctz(~(row >> v));   // row < 2^16: siempre hay un cero
+            uint32 run = ((1u << length) - 1u) << v;
+
+            int span = 1;
+            while (u + span < 16 && (rows[u + span] & run) == run) {
+                rows[u + span] &= (uint16)~run;
+                span++;
+            }
+            row &= ~run;
+
+            int p[3];
+            p[normalAxis] = d;
+            p[uAxis] = u;
+            p[vAxis] = v;
+            if (!emit_quad(mesh, face, p[0], p[1], p[2], span, length, block, CHUNK_VERTEX_TINT_MEAN, ao)) return FALSE;
+        }
+    }
+    return TRUE;
+}
+
+// Occluded faces of one slice (rows[u], bit v) grouped by signature: mismo bloque y mismo AO
+// en las 4 esquinas. Cada grupo se fusiona con merge_face_rows como las caras sin oclusión,
+// así solo salen quads 1x1 donde las esquinas cambian de una cara a la siguiente.
+#define CHUNK_AO_MAX_SIGNATURES 32
+
+typedef struct {
+    uint16 key;        // bloque << 8 | AO de las 4 esquinas
+    uint16 count;
+    uint8 u, v;        // primera cara: con una sola no hace falta fusionar
+    uint16 rows[16];
+} ChunkAoSignature;
+
+static BOOL merge_occluded_slice(const ChunkMeshSnapshot* snapshot, ChunkMesh* mesh, const uint16 rows[16],
+                                 int face, int d) {
+    ChunkAoSignature signatures[CHUNK_AO_MAX_SIGNATURES];
+    int signatureCount = 0;
+    int normalAxis = k_face_axes[face][0];
+    int uAxis = k_face_axes[face][1];
+    int vAxis = k_face_axes[face][2];
+
+    for (int u = 0; u < 16; u++) {
+        uint32 row = rows[u];
+        while (row) {
+            int v = __builtin_ctz(row);
+            row &= row - 1;
+
+            int p[3];
+            p[normalAxis] = d;
+            p[uAxis] = u;
+            p[vAxis] = v;
+            uint8 block = snapshot->blocks[p[0]][p[1]][p[2]];
+            uint8 ao = face_corner_ao(snapshot, face, p[0], p[1], p[2]);
+            uint16 key = (uint16)(block << 8 | ao);
+
+            int s = 0;
+            while (s < signatureCount && signatures[s].key != key) s++;
+            if (s == signatureCount) {
+                if (signatureCount == CHUNK_AO_MAX_SIGNATURES) {
+                    // Demasiados patrones en la capa: esta cara sale sola
+                    if (!emit_quad(mesh, face, p[0], p[1], p[2], 1, 1, block, CHUNK_VERTEX_TINT_MEAN, ao)) return FALSE;
+                    continue;
+                }
+                signatures[s].key = key;
+                signatures[s].count = 0;
+                signatures[s].u = (uint8)u;
+                signatures[s].v = (uint8)v;
+                memset(signatures[s].rows, 0, sizeof(signatures[s].rows));
+                signatureCount++;
+            }
+            signatures[s].count++;
+            signatures[s].rows[u] |= (uint16)(1u << v);
+        }
+    }
+
+    for (int s = 0; s < signatureCount; s++) {
+        uint8 block = (uint8)(signatures[s].key >> 8);
+        uint8 ao = (uint8)(signatures[s].key & 0xFF);
+        if (signatures[s].count == 1) {
+            int p[3];
+            p[normalAxis] = d;
+            p[uAxis] = signatures[s].u;
+            p[vAxis] = signatures[s].v;
+            if (!emit_quad(mesh, face, p[0], p[1], p[2], 1, 1, block, CHUNK_VERTEX_TINT_MEAN, ao)) return FALSE;
+        } else if (!merge_face_rows(mesh, signatures[s].rows, face, d, block, ao)) {
+            return FALSE;
+        }
+    }
+    return TRUE;
+}
+
+// Faces with some corner AO < 3 leave faceCols and are merged per signature; greedy y binary
+// solo fusionan después las caras sin oclusión
+static BOOL emit_occluded_faces(const ChunkMeshSnapshot* snapshot, ChunkMesh* mesh,
+                                uint16 faceCols[6][CHUNK_SIZE][CHUNK_SIZE]) {
+    uint16 occluded[6][CHUNK_SIZE][CHUNK_SIZE];
+    uint32 layers[6];
+    uint16 rows[16];
+    if (!snapshot->bakeAo || !compute_occluded_columns(snapshot, faceCols, occluded, layers)) return TRUE;
+
+    for (int face = 0; face < 6; face++) {
+        if (!layers[face]) continue;
+
+        if (face < 4) {
+            // ±X: capa x, filas y, bits z. ±Y: capa y, filas x, bits z
+            while (layers[face]) {
+                int d = __builtin_ctz(layers[face]);
+                layers[face] &= layers[face] - 1;
+                for (int u = 0; u < 16; u++) {
+                    uint16* column = face < 2 ? &faceCols[face][d][u] : &faceCols[face][u][d];
+                    rows[u] = face < 2 ? occluded[face][d][u] : occluded[face][u][d];
+                    *column &= (uint16)~rows[u];
+                }
+                if (!merge_occluded_slice(snapshot, mesh, rows, face, d)) return FALSE;
+            }
+            continue;
+        }
+
+        // ±Z: capa z, filas x, bits y. Una pasada reparte los bits de cada columna en sus capas
+        uint16 slabs[16][16];  // [z][x], bit y
+        memset(slabs, 0, sizeof(slabs));
+        for (int x = 0; x < CHUNK_SIZE; x++) {
+            if (!or_face_row(occluded[face][x])) continue;
+            for (int y = 0; y < CHUNK_SIZE; y++) {
+                uint16 bits = occluded[face][x][y];
+                if (!bits) continue;
+                faceCols[face][x][y] &= (uint16)~bits;
+                while (bits) {
+                    int z = __builtin_ctz(bits);
+                    bits &= bits - 1;
+                    slabs[z][x] |= (uint16)(1u << y);
+                }
+            }
+        }
+        while (layers[face]) {
+            int d = __builtin_ctz(layers[face]);
+            layers[face] &= layers[face] - 1;
+            if (!merge_occluded_slice(snapshot, mesh, slabs[d], face, d)) return FALSE;
+        }
+    }
+    return TRUE;
+}
+
+// Naive mesher: one quad per visible face, coloured per block
+static BOOL mesh_snapshot_naive(const ChunkMeshSnapshot* snapshot, ChunkMesh* mesh) {
+    uint16 faceCols[6][CHUNK_SIZE][CHUNK_SIZE];
+    uint16 occluded[6][CHUNK_SIZE][CHUNK_SIZE];
+    uint32 layers[6];
+
+    compute_face_columns(snapshot, faceCols);
+    if (!snapshot->bakeAo || !compute_occluded_columns(snapshot, faceCols, occluded, layers)) {
+        memset(occluded, 0, sizeof(occluded));
+    }
+    for (int x = 0; x < 16; x++) {
+        for (int y = 0; y < 16; y++) {
+            uint16 visible = faceCols[0][x][y] | faceCols[1][x][y] | faceCols[2][x][y] |
+                             faceCols[3][x][y] | faceCols[4][x][y] | faceCols[5][x][y];
+            while (visible) {
+                int z = __builtin_ctz(visible);
+                visible &= visible - 1;
+
+                // Tono: la variación aleatoria de get_terrain_color reducida a gris
+                uint8 block = snapshot->blocks[x][y][z];
+                Color random = generate_random_color(snapshot->chunkX * 16 + x, snapshot->chunkY * 16 + y,
+                                                     snapshot->chunkZ * 16 + z, snapshot->colorSeed);
+                uint8 tint = (uint8)((random.r + random.g + random.b) / 3);
+                for (int face = 0; face < 6; face++) {
+                    if (!((faceCols[face][x][y] >> z) & 1)) continue;
+
+                    uint8 ao = ((occluded[face][x][y] >> z) & 1) ? face_corner_ao(snapshot, face, x, y, z) : CHUNK_AO_NONE;
+                    if (!emit_quad(mesh, face, x, y, z, 1, 1, block, tint, ao)) {
+                        return report_mesh_overflow(snapshot);
+                    }
+                }
+            }
+        }
+    }
+
+    return TRUE;
+}
+
+// Greedy merge of one size x size slice of keys (tipo de bloque + 1, 0 = sin cara): cada
+// rectángulo crece primero a lo largo de u y luego en v. scale: bloques por celda (LOD).
+static BOOL merge_face_slice(ChunkMesh* mesh, uint8 slice[16][16], int size, int face, int d, int scale) {
+    int normalAxis = k_face_axes[face][0];
+    int uAxis = k_face_axes[face][1];
+    int vAxis = k_face_axes[face][2];
+
+    for (int v = 0; v < size; v++) {
+        for (int u = 0; u < size; ) {
+            uint8 key = slice[v][u];
+            if (!key) {
+                u++;
+                continue;
+            }
+
+            int width = 1;
+            while (u + width < size && slice[v][u + width] == key) width++;
+
+            int height = 1;
+            for (; v + height < size; height++) {
+                int k = 0;
+                while (k < width && slice[v + height][u + k] == key) k++;
+                if (k < width) break;
+            }
+
+            for (int h = 0; h < height; h++) {
+                memset(&slice[v + h][u], 0, width);
+            }
+
+            // emit_quad pone las caras positivas en el lado +1 del bloque: el último de la celda
+            int p[3];
+            p[normalAxis] = d * scale + ((face & 1) ? 0 : scale - 1);
+            p[uAxis] = u * scale;
+            p[vAxis] = v * scale;
+            if (!emit_quad(mesh, face, p[0], p[1], p[2], width * scale, height * scale, (uint8)(key - 1),
+                           CHUNK_VERTEX_TINT_MEAN, CHUNK_AO_NONE)) {
+                return FALSE;
+            }
+            u += width;
+        }
+    }
+    return TRUE;
+}
+
+// Greedy mesher: por cada dirección y capa, una máscara 16x16 con el tipo de bloque
+// de cada cara visible; las celdas iguales se fusionan en el rectángulo más grande
+// posible (primero a lo largo de u, luego se extiende en v).
+static BOOL mesh_snapshot_greedy(const ChunkMeshSnapshot* snapshot, ChunkMesh* mesh) {
+    uint16 faceCols[6][CHUNK_SIZE][CHUNK_SIZE];
+    uint8 slice[16][16];  // [v][u]: tipo de bloque + 1 si la cara es visible y sin oclusión
+
+    compute_face_columns(snapshot, faceCols);
+    if (!emit_occluded_faces(snapshot, mesh, faceCols)) return report_mesh_overflow(snapshot);
+    for (int face = 0; face < 6; face++) {
+        int normalAxis = k_face_axes[face][0];
+        int uAxis = k_face_axes[face][1];
+        int vAxis = k_face_axes[face][2];
+
+        for (int d = 0; d < 16; d++) {
+            int visible = 0;
+            for (int v = 0; v < 16; v++) {
+                for (int u = 0; u < 16; u++) {
+                    int p[3];
+                    p[normalAxis] = d;
+                    p[uAxis] = u;
+                    p[vAxis] = v;
+                    uint8 key = 0;
+                    if ((faceCols[face][p[0]][p[1]] >> p[2]) & 1) {
+                        key = (uint8)(snapshot->blocks[p[0]][p[1]][p[2]] + 1);
+                        visible++;
+                    }
+                    slice[v][u] = key;
+                }
+            }
+            if (!visible) continue;
+
+            if (!merge_face_slice(mesh, slice, CHUNK_SIZE, face, d, 1)) return report_mesh_overflow(snapshot);
+        }
+    }
+
+    return TRUE;
+}
+
+// Binary mesher: las caras visibles de cada eje salen de operaciones de bits sobre las
+// columnas de ocupación (bit z de la columna x,y), sin mirar voxel a voxel; después cada
+// capa se fusiona con merge_face_rows. Un juego de máscaras por tipo de bloque.
+static BOOL mesh_snapshot_binary(const ChunkMeshSnapshot* snapshot, ChunkMesh* mesh) {
+    uint16 faceCols[6][CHUNK_SIZE][CHUNK_SIZE];  // [face][x][y], bit z: cara visible sin oclusión
+    uint16 typeCols[CHUNK_SIZE][CHUNK_SIZE];     // [x][y], bit z: bloque del tipo actual
+    uint16 visible[CHUNK_SIZE][CHUNK_SIZE];
+    uint16 rows[16];
+
+    compute_face_columns(snapshot, faceCols);
+    if (!emit_occluded_faces(snapshot, mesh, faceCols)) return report_mesh_overflow(snapshot);
+    for (int t = 0; t < snapshot->typeCount; t++) {
+        uint8 type = snapshot->types[t];
+
+        // Column masks of this block type. Un solo tipo (lo normal: suelo, subsuelo):
+        // son las columnas de ocupación
+        for (int x = 0; x < 16; x++) {
+            for (int y = 0; y < 16; y++) {
+                uint16 column = (uint16)(snapshot->occupiedCols[x + 1][y + 1] >> 1);
+                if (snapshot->typeCount > 1) {
+                    const uint8* blocks = snapshot->blocks[x][y];
+                    column = 0;
+                    for (int z = 0; z < 16; z++) {
+                        column |= (uint16)((blocks[z] == type) << z);
+                    }
+                }
+                typeCols[x][y] = column;
+            }
+        }
+
+        for (int face = 0; face < 6; face++) {
+            if (face < 4) {
+                // ±X: capa x, filas y, bits z. ±Y: capa y, filas x, bits z
+                for (int d = 0; d < 16; d++) {
+                    uint16 any = 0;
+                    for (int u = 0; u < 16; u++) {
+                        int x = face < 2 ? d : u;
+                        int y = face < 2 ? u : d;
+                        rows[u] = faceCols[face][x][y] & typeCols[x][y];
+                        any |= rows[u];
+                    }
+                    if (any && !merge_face_rows(mesh, rows, face, d, type, CHUNK_AO_NONE)) {
+                        return report_mesh_overflow(snapshot);
+                    }
+                }
+                continue;
+            }
+
+            // ±Z: capa z, filas x, bits y (transpuesta de las columnas); solo las capas con caras
+            uint32 layers = 0;
+            for (int x = 0; x < 16; x++) {
+                for (int y = 0; y < 16; y++) {
+                    visible[x][y] = faceCols[face][x][y] & typeCols[x][y];
+                    layers |= visible[x][y];
+                }
+            }
+            while (layers) {
+                int d = __builtin_ctz(layers);
+                layers &= layers - 1;
+                for (int x = 0; x < 16; x++) {
+                    uint16 row = 0;
+                    for (int y = 0; y < 16; y++) {
+                        row |= (uint16)(((visible[x][y] >> d) & 1u) << y);
+                    }
+                    rows[x] = row;
+                }
+                if (!merge_face_rows(mesh, rows, face, d, type, CHUNK_AO_NONE)) {
+                    return report_mesh_overflow(snapshot);
+                }
+            }
+        }
+    }
+
+    return TRUE;
+}
+
+// Most frequent block type of the cell among the opaque ones (o los no opacos si la celda
+// no es opaca): el color de la celda sigue a la clase que decide su culling
+static uint8 lod_cell_type(const ChunkMeshSnapshot* snapshot, int x0, int y0, int z0, int scale, BOOL opaque) {
+    if (snapshot->typeCount == 1) return snapshot->types[0];
+
+    uint8 types[64];
+    int counts[64];
+    int typeCount = 0, best = -1;
+    for (int x = x0; x < x0 + scale; x++) {
+        for (int y = y0; y < y0 + scale; y++) {
+            uint32 opaqueColumn = snapshot->opaqueCols[x + 1][y + 1] >> 1;
+            for (int z = z0; z < z0 + scale; z++) {
+                uint8 block = snapshot->blocks[x][y][z];
+                if (block == VOXEL_AIR || (BOOL)((opaqueColumn >> z) & 1) != opaque) continue;
+
+                int t = 0;
+                while (t < typeCount && types[t] != block) t++;
+                if (t == typeCount) {
+                    types[typeCount] = block;
+                    counts[typeCount++] = 0;
+                }
+                counts[t]++;
+                if (best < 0 || counts[t] > counts[best]) best = t;
+            }
+        }
+    }
+    return best >= 0 ? types[best] : VOXEL_AIR;
+}
+
+// Cells of the LOD grid with a 1-cell border (las del vecino, de lodBorder)
+#define LOD_PADDED_CELLS (CHUNK_LOD_BORDER_CELLS + 2)
+
+static inline int lod_cell_index(int x, int y, int z) {
+    return ((x + 1) * LOD_PADDED_CELLS + (y + 1)) * LOD_PADDED_CELLS + (z + 1);
+}
+
+// LOD mesher: baja el snapshot a celdas de 2^lodLevel bloques, oculta las caras entre celdas
+// (y contra las celdas del vecino en lodBorder) como compute_face_columns, y fusiona cada
+// capa con merge_face_slice escalado. Sin AO: la oclusión por bloque no se vería a esa distancia.
+// El tipo de una celda solo se calcula si tiene alguna cara visible.
+static BOOL mesh_snapshot_lod(const ChunkMeshSnapshot* snapshot, ChunkMesh* mesh) {
+    int scale = 1 << snapshot->lodLevel;
+    int cells = CHUNK_SIZE / scale;
+    uint16 occupied[CHUNK_SIZE][CHUNK_SIZE];
+    uint16 opaque[CHUNK_SIZE][CHUNK_SIZE];
+    uint8 cellFlags[LOD_PADDED_CELLS * LOD_PADDED_CELLS * LOD_PADDED_CELLS];
+    uint8 cellTypes[LOD_PADDED_CELLS * LOD_PADDED_CELLS * LOD_PADDED_CELLS];  // 0xFF: sin calcular
+    uint8 slice[16][16];
+    const int strides[3] = {LOD_PADDED_CELLS * LOD_PADDED_CELLS, LOD_PADDED_CELLS, 1};
+
+    for (int x = 0; x < CHUNK_SIZE; x++) {
+        for (int y = 0; y < CHUNK_SIZE; y++) {
+            occupied[x][y] = (uint16)(snapshot->occupiedCols[x + 1][y + 1] >> 1);
+            opaque[x][y] = (uint16)(snapshot->opaqueCols[x + 1][y + 1] >> 1);
+        }
+    }
+    memset(cellFlags, 0, sizeof(cellFlags));
+    memset(cellTypes, 0xFF, sizeof(cellTypes));
+    for (int x = 0; x < cells; x++) {
+        for (int y = 0; y < cells; y++) {
+            for (int z = 0; z < cells; z++) {
+                cellFlags[lod_cell_index(x, y, z)] = lod_cell_flags(occupied, opaque, x * scale, y * scale, z * scale, scale);
+            }
+        }
+    }
+    for (int face = 0; face < 6; face++) {
+        int normalAxis = k_face_axes[face][0];
+        int uAxis = k_face_axes[face][1];
+        int vAxis = k_face_axes[face][2];
+        for (int u = 0; u < cells; u++) {
+            for (int v = 0; v < cells; v++) {
+                int p[3];
+                p[normalAxis] = k_face_normals[face][normalAxis] > 0 ? cells : -1;
+                p[uAxis] = u;
+                p[vAxis] = v;
+                cellFlags[lod_cell_index(p[0], p[1], p[2])] = snapshot->lodBorder[face][u][v];
+            }
+        }
+    }
+
+    for (int face = 0; face < 6; face++) {
+        int normalAxis = k_face_axes[face][0];
+        int normalStride = strides[normalAxis] * k_face_normals[face][normalAxis];
+        int uStride = strides[k_face_axes[face][1]];
+        int vStride = strides[k_face_axes[face][2]];
+
+        for (int d = 0; d < cells; d++) {
+            int visible = 0;
+            int layer = lod_cell_index(0, 0, 0) + d * strides[normalAxis];
+            for (int v = 0; v < cells; v++) {
+                for (int u = 0; u < cells; u++) {
+                    int cell = layer + u * uStride + v * vStride;
+                    uint8 flags = cellFlags[cell];
+                    uint8 neighbor = cellFlags[cell + normalStride];
+                    slice[v][u] = 0;
+                    if (!(flags & CHUNK_LOD_CELL_OCCUPIED) || (neighbor & CHUNK_LOD_CELL_OPAQUE)) continue;
+
+                    if (cellTypes[cell] == 0xFF) {
+                        int x = cell / strides[0] - 1, y = cell / strides[1] % LOD_PADDED_CELLS - 1, z = cell % LOD_PADDED_CELLS - 1;
+                        cellTypes[cell] = lod_cell_type(snapshot, x * scale, y * scale, z * scale, scale,
+                                                        (flags & CHUNK_LOD_CELL_OPAQUE) != 0);
+                    }
+                    // Translucent cells only show against air, como en compute_face_columns
+                    uint8 type = cellTypes[cell];
+                    if (snapshot->blockLayers[type] == CHUNK_LAYER_TRANSLUCENT && (neighbor & CHUNK_LOD_CELL_OCCUPIED)) continue;
+
+                    slice[v][u] = (uint8)(type + 1);
+                    visible++;
+                }
+            }
+            if (visible && !merge_face_slice(mesh, slice, cells, face, d, scale)) {
+                return report_mesh_overflow(snapshot);
+            }
+        }
+    }
+
+    return TRUE;
+}
+
+typedef BOOL (*ChunkSnapshotMesherFn)(const ChunkMeshSnapshot* snapshot, ChunkMesh* mesh);
+
+static const ChunkSnapshotMesherFn k_snapshot_meshers[] = {
+    mesh_snapshot_naive,    // CHUNK_MESH_NAIVE
+    mesh_snapshot_greedy,   // CHUNK_MESH_GREEDY
+    mesh_snapshot_binary    // CHUNK_MESH_BINARY
+};
+
+static inline int mesh_quad_layer(const ChunkMeshSnapshot* snapshot, const ChunkMesh* mesh, int quad) {
+    return snapshot->blockLayers[chunk_vertex_block(&mesh->vertices[mesh->indices[quad * 6]])];
+}
+
+static inline void swap_mesh_quads(ChunkMesh* mesh, int a, int b) {
+    uint16 temp[6];
+    memcpy(temp, &mesh->indices[a * 6], sizeof(temp));
+    memcpy(&mesh->indices[a * 6], &mesh->indices[b * 6], sizeof(temp));
+    memcpy(&mesh->indices[b * 6], temp, sizeof(temp));
+}
+
+// Group the quads by render layer: partición en tres sobre grupos de 6 índices (el orden
+// dentro de cada capa da igual), los vértices no se mueven
+static void group_mesh_layers(const ChunkMeshSnapshot* snapshot, ChunkMesh* mesh) {
+    BOOL layered = FALSE;
+    for (int t = 0; t < snapshot->typeCount; t++) {
+        if (snapshot->blockLayers[snapshot->types[t]] != CHUNK_LAYER_OPAQUE) layered = TRUE;
+    }
+
+    memset(mesh->layerIndexCount, 0, sizeof(mesh->layerIndexCount));
+    if (!layered) {
+        mesh->layerIndexCount[CHUNK_LAYER_OPAQUE] = mesh->indexCount;
+        return;
+    }
+
+    int quads = mesh->indexCount / 6;
+    int low = 0, mid = 0, high = quads;
+    while (mid < high) {
+        int layer = mesh_quad_layer(snapshot, mesh, mid);
+        if (layer == CHUNK_LAYER_OPAQUE) {
+            swap_mesh_quads(mesh, low++, mid++);
+        } else if (layer == CHUNK_LAYER_CUTOUT) {
+            mid++;
+        } else {
+            swap_mesh_quads(mesh, mid, --high);
+        }
+    }
+    mesh->layerIndexCount[CHUNK_LAYER_OPAQUE] = low * 6;
+    mesh->layerIndexCount[CHUNK_LAYER_CUTOUT] = (high - low) * 6;
+    mesh->layerIndexCount[CHUNK_LAYER_TRANSLUCENT] = (quads - high) * 6;
+}
+
+static BOOL build_mesh_with(const ChunkMeshSnapshot* snapshot, ChunkMesh* mesh, int mode) {
+    if (!snapshot || !mesh) return FALSE;
+
+    chunk_mesh_clear(mesh);
+    if (snapshot->isEmpty) return TRUE;
+    if (mode < CHUNK_MESH_NAIVE || mode > CHUNK_MESH_BINARY) mode = CHUNK_MESH_NAIVE;
+    ChunkSnapshotMesherFn mesher = snapshot->lodLevel > 0 ? mesh_snapshot_lod : k_snapshot_meshers[mode];
+    if (!mesher(snapshot, mesh)) return FALSE;
+    group_mesh_layers(snapshot, mesh);
+    mesh->lodLevel = snapshot->lodLevel;
+    return TRUE;
+}
+
+BOOL build_chunk_mesh_from_snapshot(const ChunkMeshSnapshot* snapshot, ChunkMesh* mesh) {
+    return snapshot ? build_mesh_with(snapshot, mesh, snapshot->meshMode) : FALSE;
+}
+
+// Snapshot + mesher: los wrappers por chunk mantienen la API de antes
+static BOOL build_chunk_mesh_mode(VoxelChunk* chunk, ChunkMesh* mesh, int mode) {
+    ChunkMeshSnapshot snapshot;
+    if (!chunk || !mesh || !take_chunk_mesh_snapshot(chunk, &snapshot)) return FALSE;
+    return build_mesh_with(&snapshot, mesh, mode);
+}
+
+BOOL build_chunk_mesh_naive(VoxelChunk* chunk, ChunkMesh* mesh) {
+    return build_chunk_mesh_mode(chunk, mesh, CHUNK_MESH_NAIVE);
+}
+
+BOOL build_chunk_mesh_greedy(VoxelChunk* chunk, ChunkMesh* mesh) {
+    return build_chunk_mesh_mode(chunk, mesh, CHUNK_MESH_GREEDY);
+}
+
+BOOL build_chunk_mesh_binary(VoxelChunk* chunk, ChunkMesh* mesh) {
+    return build_chunk_mesh_mode(chunk, mesh, CHUNK_MESH_BINARY);
+}
+
+BOOL build_chunk_mesh(VoxelChunk* chunk, ChunkMesh* mesh) {
+    if (!chunk) return FALSE;
+    return build_chunk_mesh_mode(chunk, mesh, chunk->meshMode);
+}
+
+// Switch a chunk's mesher; la geometría se reconstruye en el siguiente frame
+void set_chunk_mesh_mode(VoxelChunk* chunk, ChunkMeshMode mode) {
+    if (!chunk || chunk->meshMode == (uint8)mode) return;
+    chunk->meshMode = (uint8)mode;
+    chunk->needsRemesh = TRUE;
+}
+
+// Los chunks ya mallados conservan su AO hasta el siguiente remesh
+void set_chunk_mesh_ao(BOOL enabled) {
+    g_bake_ao = enabled ? TRUE : FALSE;
+}
+
+// ============================================================================
+// LEVEL OF DETAIL - nivel por chunk elegido por error en pantalla
+// ============================================================================
+
+// Worst surface displacement of a level, en bloques: una celda de 2^lod bloques puede
+// mover la superficie hasta 2^lod - 1
+static inline float chunk_lod_error(int lod) {
+    return (float)((1 << lod) - 1);
+}
+
+int select_chunk_lod(float distance, float pixelsPerUnit, int currentLod) {
+    float pixelsPerBlock = pixelsPerUnit / (distance > 1.0f ? distance : 1.0f);
+    int lod = currentLod < 0 ? 0 : (currentLod >= CHUNK_LOD_COUNT ? CHUNK_LOD_COUNT - 1 : currentLod);
+
+    while (lod + 1 < CHUNK_LOD_COUNT && chunk_lod_error(lod + 1) * pixelsPerBlock <= CHUNK_LOD_MAX_ERROR_PIXELS) {
+        lod++;
+    }
+    while (lod > 0 && chunk_lod_error(lod) * pixelsPerBlock > CHUNK_LOD_MAX_ERROR_PIXELS * CHUNK_LOD_HYSTERESIS) {
+        lod--;
+    }
+    return lod;
+}
+
+void set_chunk_lod(VoxelChunk* chunk, int lod) {
+    if (!chunk || lod < 0 || lod >= CHUNK_LOD_COUNT || chunk->lodLevel == (uint8)lod) return;
+
+    chunk->lodLevel = (uint8)lod;
+    chunk->needsRemesh = TRUE;
+    for (int face = 0; face < 6; face++) {
+        const int8* normal = k_face_normals[face];
+        VoxelChunk* neighbor = chunk->neighbors[chunk_neighbor_index(normal[0], normal[1], normal[2])];
+        if (neighbor) neighbor->needsRemesh = TRUE;
+    }
+}
+
+// ============================================================================
+// TRANSLUCENT ORDER - la capa translúcida se reordena sin volver a mallar
+// ============================================================================
+
+int extract_translucent_quads(const ChunkMesh* mesh, ChunkTranslucentQuad* quads) {
+    int first = mesh->layerIndexCount[CHUNK_LAYER_OPAQUE] + mesh->layerIndexCount[CHUNK_LAYER_CUTOUT];
+    int count = mesh->layerIndexCount[CHUNK_LAYER_TRANSLUCENT] / 6;
+    for (int q = 0; q < count; q++) {
+        const uint16* index = &mesh->indices[first + q * 6];
+        memcpy(quads[q].indices, index, sizeof(quads[q].indices));
+
+        // Las esquinas 0 y 2 de cada quad son opuestas: su suma es el doble del centro
+        const ChunkVertex* a = &mesh->vertices[index[0] & ~3];
+        const ChunkVertex* c = &mesh->vertices[(index[0] & ~3) + 2];
+        quads[q].center[0] = (int16)(chunk_vertex_x(a) + chunk_vertex_x(c));
+        quads[q].center[1] = (int16)(chunk_vertex_y(a) + chunk_vertex_y(c));
+        quads[q].center[2] = (int16)(chunk_vertex_z(a) + chunk_vertex_z(c));
+        quads[q].sortKey = 0;
+    }
+    return count;
+}
+
+static int compare_translucent_far_first(const void* a, const void* b) {
+    uint32 keyA = ((const ChunkTranslucentQuad*)a)->sortKey;
+    uint32 keyB = ((const ChunkTranslucentQuad*)b)->sortKey;
+    return (keyA < keyB) - (keyA > keyB);
+}
+
+void sort_translucent_quads(ChunkTranslucentQuad* quads, int count, const int eye[3], uint16* indices) {
+    for (int q = 0; q < count; q++) {
+        int dx = quads[q].center[0] - eye[0];
+        int dy = quads[q].center[1] - eye[1];
+        int dz = quads[q].center[2] - eye[2];
+        quads[q].sortKey = (uint32)(dx * dx + dy * dy + dz * dz);
+    }
+    qsort(quads, count, sizeof(ChunkTranslucentQuad), compare_translucent_far_first);
+    for (int q = 0; q < count; q++) {
+        memcpy(&indices[q * 6], quads[q].indices, sizeof(quads[q].indices));
+    }
+}
+
+typedef BOOL (*ChunkMesherFn)(VoxelChunk* chunk, ChunkMesh* mesh);
+
+static const struct {
+    const char* name;
+    ChunkMesherFn build;
+} k_chunk_meshers[] = {
+    {"naive", build_chunk_mesh_naive},
+    {"greedy", build_chunk_mesh_greedy},
+    {"binary", build_chunk_mesh_binary}
+};
+
+// Triangles and build time of every mesher over the loaded chunks
+void report_chunk_mesh_counts(ChunkManager* manager) {
+    if (!manager) return;
+
+    const int repetitions = 100;  // Varias pasadas para medir microsegundos estables
+    ChunkMesh mesh;
+    LARGE_INTEGER freq, start, end;
+    int naiveTriangles = 0;
+
+    chunk_mesh_init(&mesh);
+    QueryPerformanceFrequency(&freq);
+    for (int m = 0; m < (int)(sizeof(k_chunk_meshers) / sizeof(k_chunk_meshers[0])); m++) {
+        int chunks = 0, triangles = 0;
+        double seconds = 0.0;
+
+        for (int i = 0; i < manager->maxChunks; i++) {
+            VoxelChunk* chunk = manager->chunks[i];
+            if (!chunk || !chunk->isGenerated || is_chunk_empty(chunk)) continue;
+
+            k_chunk_meshers[m].build(chunk, &mesh); // Calentamiento: capacidad del mesh y caché
+            QueryPerformanceCounter(&start);
+            for (int r = 0; r < repetitions; r++) {
+                k_chunk_meshers[m].build(chunk, &mesh);
+            }
+            QueryPerformanceCounter(&end);
+            seconds += (double)(end.QuadPart - start.QuadPart) / (double)freq.QuadPart / repetitions;
+            triangles += chunk_mesh_triangle_count(&mesh);
+            chunks++;
+        }
+
+        if (chunks == 0) {
+            printf("   - No hay chunks con bloques cargados\n");
+            break;
+        }
+        if (m == 0) naiveTriangles = triangles;
+        printf("   - %-6s: %d chunks, %d triángulos (x%.1f menos que naive), %.1f us/chunk, %zu bytes de buffers\n",
+               k_chunk_meshers[m].name, chunks, triangles,
+               triangles > 0 ? (float)naiveTriangles / triangles : 0.0f, seconds * 1e6 / chunks,
+               (size_t)triangles * 2 * sizeof(ChunkVertex) + (size_t)triangles * 3 * sizeof(uint16));
+    }
+
+    // AO cost: mismo recorrido con y sin AO horneado, alternados varias rondas y
+    // quedándose con la mejor de cada uno (el reloj varía entre pasadas). En naive es solo
+    // el cálculo; en binary se suman los quads de las caras con oclusión, que solo se
+    // fusionan entre caras con el mismo bloque y el mismo AO en las 4 esquinas.
+    const int aoModes[2] = {CHUNK_MESH_NAIVE, CHUNK_MESH_BINARY};
+    BOOL bakeAo = g_bake_ao;
+    for (int m = 0; m < 2; m++) {
+        double aoSeconds[2] = {0.0, 0.0};
+        int aoTriangles[2] = {0, 0};
+        for (int round = 0; round < 5; round++) {
+            for (int pass = 0; pass < 2; pass++) {
+                double seconds = 0.0;
+                g_bake_ao = pass == 1;
+                aoTriangles[pass] = 0;
+                for (int i = 0; i < manager->maxChunks; i++) {
+                    VoxelChunk* chunk = manager->chunks[i];
+                    if (!chunk || !chunk->isGenerated || is_chunk_empty(chunk)) continue;
+
+                    build_chunk_mesh_mode(chunk, &mesh, aoModes[m]);
+                    QueryPerformanceCounter(&start);
+                    for (int r = 0; r < repetitions; r++) {
+                        build_chunk_mesh_mode(chunk, &mesh, aoModes[m]);
+                    }
+                    QueryPerformanceCounter(&end);
+                    seconds += (double)(end.QuadPart - start.QuadPart) / (double)freq.QuadPart / repetitions;
+                    aoTriangles[pass] += chunk_mesh_triangle_count(&mesh);
+                }
+                if (round == 0 || seconds < aoSeconds[pass]) aoSeconds[pass] = seconds;
+            }
+        }
+        if (aoSeconds[0] > 0.0) {
+            printf("   - AO (%s): %.1f us sin AO, %.1f us con AO (+%.1f%%), %d -> %d triángulos\n",
+                   k_chunk_meshers[aoModes[m]].name, aoSeconds[0] * 1e6, aoSeconds[1] * 1e6,
+                   100.0 * (aoSeconds[1] - aoSeconds[0]) / aoSeconds[0], aoTriangles[0], aoTriangles[1]);
+        }
+    }
+    g_bake_ao = bakeAo;
+    chunk_mesh_free(&mesh);
+}
+
+// VRAM of the loaded chunks' meshes (lo mismo que se sube al remallar todo el área) con el
+// vértice empaquetado frente al ChunkVertex de 16 bytes anterior y a Vertex3D
+void report_chunk_vertex_memory(ChunkManager* manager) {
+    if (!manager) return;
+
+    const int modes[2] = {CHUNK_MESH_NAIVE, CHUNK_MESH_BINARY};
+    const size_t previousVertexBytes = 16;  // int16 x,y,z,pad + int8 normal + cara + RGBA
+    ChunkMesh mesh;
+
+    chunk_mesh_init(&mesh);
+    for (int m = 0; m < 2; m++) {
+        int chunks = 0;
+        size_t vertices = 0, indices = 0;
+        for (int i = 0; i < manager->maxChunks; i++) {
+            VoxelChunk* chunk = manager->chunks[i];
+            if (!chunk || !chunk->isGenerated || is_chunk_empty(chunk)) continue;
+            if (!build_chunk_mesh_mode(chunk, &mesh, modes[m])) continue;
+            vertices += mesh.vertexCount;
+            indices += mesh.indexCount;
+            chunks++;
+        }
+
+        size_t indexBytes = indices * sizeof(uint16);
+        size_t packed = vertices * sizeof(ChunkVertex) + indexBytes;
+        size_t previous = vertices * previousVertexBytes + indexBytes;
+        size_t wide = vertices * sizeof(Vertex3D) + indexBytes;
+        printf("   - %-6s: %d chunks, %zu vértices: %zu bytes (%zu B/vértice) vs %zu (%zu B, -%.0f%%) vs %zu (Vertex3D %zu B, -%.0f%%)\n",
+               k_chunk_meshers[modes[m]].name, chunks, vertices, packed, sizeof(ChunkVertex),
+               previous, previousVertexBytes, previous ? 100.0 * (previous - packed) / previous : 0.0,
+               wide, sizeof(Vertex3D), wide ? 100.0 * (wide - packed) / wide : 0.0);
+    }
+    chunk_mesh_free(&mesh);
+}
+
+// Every loaded chunk meshed at each level (binary a nivel 0, como el renderer): los vecinos
+// están al mismo nivel, así que no hay paredes de costura en la cuenta
+void report_chunk_lod_counts(ChunkManager* manager) {
+    if (!manager) return;
+
+    const int repetitions = 20;
+    ChunkMesh mesh;
+    LARGE_INTEGER freq, start, end;
+    int fullTriangles = 0;
+    uint8* levels = (uint8*)safe_malloc(manager->maxChunks);
+    ChunkMeshSnapshot* snapshot = (ChunkMeshSnapshot*)safe_malloc(sizeof(ChunkMeshSnapshot));
+    if (!levels || !snapshot) {
+        safe_free(levels);
+        safe_free(snapshot);
+        return;
+    }
+
+    // Los niveles pedidos se restauran al final; needsRemesh no se toca
+    for (int i = 0; i < manager->maxChunks; i++) {
+        levels[i] = manager->chunks[i] ? manager->chunks[i]->lodLevel : 0;
+    }
+
+    chunk_mesh_init(&mesh);
+    QueryPerformanceFrequency(&freq);
+    for (int lod = 0; lod < CHUNK_LOD_COUNT; lod++) {
+        int chunks = 0, triangles = 0;
+        double seconds = 0.0;
+
+        for (int i = 0; i < manager->maxChunks; i++) {
+            if (manager->chunks[i]) manager->chunks[i]->lodLevel = (uint8)lod;
+        }
+        for (int i = 0; i < manager->maxChunks; i++) {
+            VoxelChunk* chunk = manager->chunks[i];
+            if (!chunk || !chunk->isGenerated || is_chunk_empty(chunk)) continue;
+
+            take_chunk_mesh_snapshot(chunk, snapshot);
+            build_mesh_with(snapshot, &mesh, CHUNK_MESH_BINARY);
+            QueryPerformanceCounter(&start);
+            for (int r = 0; r < repetitions; r++) {
+                build_mesh_with(snapshot, &mesh, CHUNK_MESH_BINARY);
+            }
+            QueryPerformanceCounter(&end);
+            seconds += (double)(end.QuadPart - start.QuadPart) / (double)freq.QuadPart / repetitions;
+            triangles += chunk_mesh_triangle_count(&mesh);
+            chunks++;
+        }
+
+        if (chunks == 0) {
+            printf("   - No hay chunks con bloques cargados\n");
+            break;
+        }
+        if (lod == 0) fullTriangles = triangles;
+        printf("   - LOD %d (%dx): %d chunks, %d triángulos (%.0f%% del nivel 0), %.1f us/chunk\n",
+               lod, 1 << lod, chunks, triangles, fullTriangles ? 100.0f * triangles / fullTriangles : 0.0f,
+               seconds * 1e6 / chunks);
+    }
+
+    for (int i = 0; i < manager->maxChunks; i++) {
+        if (manager->chunks[i]) manager->chunks[i]->lodLevel = levels[i];
+    }
+    chunk_mesh_free(&mesh);
+    safe_free(snapshot);
+    safe_free(levels);
+}
+
+// ============================================================================
+// SELF-CHECK - conteos de vértices conocidos, sin OpenGL
+// ============================================================================
+
+// Counter-clockwise seen from outside: (v1 - v0) x (v2 - v0) points along the normal
+static BOOL check_mesh_winding(const ChunkMesh* mesh) {
+    for (int i = 0; i + 2 < mesh->indexCount; i += 3) {
+        const ChunkVertex* a = &mesh->vertices[mesh->indices[i]];
+        const ChunkVertex* b = &mesh->vertices[mesh->indices[i + 1]];
+        const ChunkVertex* c = &mesh->vertices[mesh->indices[i + 2]];
+        int ux = chunk_vertex_x(b) - chunk_vertex_x(a), uy = chunk_vertex_y(b) - chunk_vertex_y(a), uz = chunk_vertex_z(b) - chunk_vertex_z(a);
+        int vx = chunk_vertex_x(c) - chunk_vertex_x(a), vy = chunk_vertex_y(c) - chunk_vertex_y(a), vz = chunk_vertex_z(c) - chunk_vertex_z(a);
+        const int8* normal = k_face_normals[chunk_vertex_face(a)];
+        int dot = (uy * vz - uz * vy) * normal[0] + (uz * vx - ux * vz) * normal[1] + (ux * vy - uy * vx) * normal[2];
+        if (dot <= 0) return FALSE;
+    }
+    return TRUE;
+}
+
+// Quad flip: la diagonal de cada quad une el par de esquinas con más AO sumado
+static BOOL check_mesh_quad_flip(const ChunkMesh* mesh) {
+    for (int i = 0; i + 5 < mesh->indexCount; i += 6) {
+        int first = mesh->indices[i] & ~3;  // Cuatro vértices por quad, alineados
+        int ao[4];
+        for (int c = 0; c < 4; c++) ao[c] = chunk_vertex_ao(&mesh->vertices[first + c]);
+        // La diagonal es la arista compartida por los dos triángulos: índices 0 y 2
+        int a = mesh->indices[i] - first, b = mesh->indices[i + 2] - first;
+        BOOL alongFirst = (a == 0 && b == 2) || (a == 2 && b == 0);
+        BOOL wantFirst = ao[0] + ao[2] >= ao[1] + ao[3];
+        if (alongFirst != wantFirst) return FALSE;
+    }
+    return TRUE;
+}
+
+// Voxel faces covered by the mesh (un quad fusionado de w x h cuenta w * h)
+static int mesh_face_area(const ChunkMesh* mesh) {
+    int area = 0;
+    for (int i = 0; i + 3 < mesh->vertexCount; i += 4) {
+        const ChunkVertex* a = &mesh->vertices[i];
+        const ChunkVertex* c = &mesh->vertices[i + 2];
+        int dx = abs(chunk_vertex_x(c) - chunk_vertex_x(a));
+        int dy = abs(chunk_vertex_y(c) - chunk_vertex_y(a));
+        int dz = abs(chunk_vertex_z(c) - chunk_vertex_z(a));
+        area += (dx ? dx : 1) * (dy ? dy : 1) * (dz ? dz : 1);
+    }
+    return area;
+}
+
+// Greedy y binary deben cubrir exactamente las caras del naive (mismos conteos en
+// formas simples, el orden de fusión puede diferir en formas irregulares)
+static BOOL check_mesh_counts(const char* name, VoxelChunk* chunk, ChunkMesh* mesh, int naiveQuads, int mergedQuads) {
+    BOOL ok = TRUE;
+    for (int mode = CHUNK_MESH_NAIVE; mode <= CHUNK_MESH_BINARY; mode++) {
+        int expectedQuads = mode == CHUNK_MESH_NAIVE ? naiveQuads : mergedQuads;
+        chunk->meshMode = (uint8)mode;
+        BOOL built = build_chunk_mesh(chunk, mesh);
+        BOOL modeOk = built && check_mesh_winding(mesh) && mesh_face_area(mesh) == naiveQuads &&
+                      (expectedQuads < 0 || (mesh->vertexCount == expectedQuads * 4 && mesh->indexCount == expectedQuads * 6));
+        printf("   - %s (%s): %d vértices, %d triángulos, %d caras cubiertas %s\n",
+               name, k_chunk_meshers[mode].name, mesh->vertexCount,
+               chunk_mesh_triangle_count(mesh), mesh_face_area(mesh), modeOk ? "OK" : "FALLO");
+        ok &= modeOk;
+    }
+    return ok;
+}
+
+BOOL verify_chunk_mesh_builder(void) {
+    static VoxelChunk chunk;
+    ChunkMesh mesh;
+    BOOL ok = TRUE;
+
+    // Chunk suelto: sin vecinos, los bordes se tratan como aire
+    memset(&chunk, 0, sizeof(VoxelChunk));
+    if (!chunk_storage_init(&chunk.storage, VOXEL_AIR)) return FALSE;
+    chunk_mesh_init(&mesh);
+
+    ok &= check_mesh_counts("Chunk vacío", &chunk, &mesh, 0, 0);
+
+    set_block_type(&chunk, 5, 5, 5, VOXEL_STONE);
+    ok &= check_mesh_counts("Un bloque", &chunk, &mesh, 6, 6);
+
+    // Dos bloques pegados: la cara compartida desaparece en ambos, greedy fusiona el resto
+    set_block_type(&chunk, 6, 5, 5, VOXEL_STONE);
+    ok &= check_mesh_counts("Dos bloques", &chunk, &mesh, 10, 6);
+
+    // Tipos distintos no se fusionan
+    set_block_type(&chunk, 6, 5, 5, VOXEL_WOOD);
+    ok &= check_mesh_counts("Piedra + madera", &chunk, &mesh, 10, 10);
+
+    // Plano de pasto 16x16: 256 arriba + 256 abajo + 64 laterales
+    chunk_storage_free(&chunk.storage);
+    chunk_storage_init(&chunk.storage, VOXEL_AIR);
+    rebuild_chunk_occupancy(&chunk);
+    for (int x = 0; x < 16; x++)
+        for (int y = 0; y < 16; y++)
+            set_block_type(&chunk, x, y, 0, VOXEL_GRASS);
+    ok &= check_mesh_counts("Plano 16x16", &chunk, &mesh, 576, 6);
+
+    // Chunk macizo: solo la cáscara exterior, 6 * 256 caras
+    chunk_storage_free(&chunk.storage);
+    chunk_storage_init(&chunk.storage, VOXEL_STONE);
+    rebuild_chunk_occupancy(&chunk);
+    ok &= check_mesh_counts("Chunk macizo", &chunk, &mesh, 6 * 256, 6);
+
+    // Terreno irregular con varios tipos: solo se comprueba el área cubierta
+    uint32 seed = 4242;
+    chunk_storage_free(&chunk.storage);
+    chunk_storage_init(&chunk.storage, VOXEL_AIR);
+    rebuild_chunk_occupancy(&chunk);
+    for (int x = 0; x < 16; x++) {
+        for (int y = 0; y < 16; y++) {
+            seed = seed * 1664525u + 1013904223u;
+            int height = 2 + (int)((seed >> 16) % 10);
+            for (int z = 0; z < height; z++) {
+                seed = seed * 1664525u + 1013904223u;
+                VoxelType type = (seed >> 28) < 2 ? VOXEL_LEAVES : ((seed >> 28) < 4 ? VOXEL_WOOD : VOXEL_GRASS);
+                set_block_type(&chunk, x, y, z, type);
+            }
+        }
+    }
+    chunk.meshMode = CHUNK_MESH_NAIVE;
+    build_chunk_mesh(&chunk, &mesh);
+    ok &= check_mesh_counts("Terreno irregular", &chunk, &mesh, chunk_mesh_quad_count(&mesh), -1);
+    ok &= check_mesh_quad_flip(&mesh);
+
+    // AO: suelo 3x3 con un bloque encima en el centro. Las caras superiores del suelo tocan
+    // el bloque con 2 esquinas (laterales) o 1 (diagonales): 4 * 2 + 4 = 12 vértices a 2.
+    // Las 4 caras laterales del bloque tienen el suelo debajo: 2 esquinas a 1 cada una.
+    chunk_storage_free(&chunk.storage);
+    chunk_storage_init(&chunk.storage, VOXEL_AIR);
+    rebuild_chunk_occupancy(&chunk);
+    for (int x = 4; x <= 6; x++)
+        for (int y = 4; y <= 6; y++)
+            set_block_type(&chunk, x, y, 0, VOXEL_STONE);
+    set_block_type(&chunk, 5, 5, 1, VOXEL_STONE);
+    for (int mode = CHUNK_MESH_NAIVE; mode <= CHUNK_MESH_BINARY; mode++) {
+        int aoCounts[4] = {0, 0, 0, 0};
+        chunk.meshMode = (uint8)mode;
+        BOOL aoOk = build_chunk_mesh(&chunk, &mesh) && check_mesh_winding(&mesh) && check_mesh_quad_flip(&mesh);
+        for (int i = 0; i < mesh.vertexCount; i++) aoCounts[chunk_vertex_ao(&mesh.vertices[i])]++;
+        aoOk &= aoCounts[0] == 0 && aoCounts[1] == 8 && aoCounts[2] == 12;
+        printf("   - AO suelo + bloque (%s): %d vértices con AO 1, %d con AO 2, %d con AO 0 %s\n",
+               k_chunk_meshers[mode].name, aoCounts[1], aoCounts[2], aoCounts[0], aoOk ? "OK" : "FALLO");
+        ok &= aoOk;
+    }
+
+    // Rincón: dos paredes en L sobre el suelo, (4,5,1) y (5,4,1). Las 6 caras que llegan a
+    // la esquina (5, 5, 1) la tienen encerrada (AO 0): 2 del suelo y 2 de cada pared
+    set_block_type(&chunk, 5, 5, 1, VOXEL_AIR);
+    set_block_type(&chunk, 4, 5, 1, VOXEL_STONE);
+    set_block_type(&chunk, 5, 4, 1, VOXEL_STONE);
+    chunk.meshMode = CHUNK_MESH_BINARY;
+    {
+        int enclosed = 0;
+        BOOL cornerOk = build_chunk_mesh(&chunk, &mesh) && check_mesh_quad_flip(&mesh);
+        for (int i = 0; i < mesh.vertexCount; i++) {
+            const ChunkVertex* v = &mesh.vertices[i];
+            if (chunk_vertex_ao(v) == 0) {
+                enclosed++;
+                cornerOk &= chunk_vertex_x(v) == 5 && chunk_vertex_y(v) == 5 && chunk_vertex_z(v) == 1;
+            }
+        }
+        cornerOk &= enclosed == 6;
+        printf("   - AO rincón: %d vértices encerrados %s\n", enclosed, cornerOk ? "OK" : "FALLO");
+        ok &= cornerOk;
+    }
+
+    chunk_mesh_free(&mesh);
+    chunk_storage_free(&chunk.storage);
+    printf("   - Mesh builder: %s\n", ok ? "OK" : "FALLO");
+    return ok;
+}
+
+// Faces covered by one layer's index range; FALSE si algún quad no es de esa capa
+static BOOL mesh_layer_face_area(const ChunkMesh* mesh, int layer, int* area) {
+    int first = 0;
+    for (int l = 0; l < layer; l++) first += mesh->layerIndexCount[l];
+
+    *area = 0;
+    for (int i = first; i < first + mesh->layerIndexCount[layer]; i += 6) {
+        const ChunkVertex* a = &mesh->vertices[mesh->indices[i] & ~3];
+        const ChunkVertex* c = &mesh->vertices[(mesh->indices[i] & ~3) + 2];
+        if ((int)get_voxel_render_layer((VoxelType)chunk_vertex_block(a)) != layer) return FALSE;
+        int dx = abs(chunk_vertex_x(c) - chunk_vertex_x(a));
+        int dy = abs(chunk_vertex_y(c) - chunk_vertex_y(a));
+        int dz = abs(chunk_vertex_z(c) - chunk_vertex_z(a));
+        *area += (dx ? dx : 1) * (dy ? dy : 1) * (dz ? dz : 1);
+    }
+    return TRUE;
+}
+
+BOOL verify_chunk_mesh_layers(void) {
+    static VoxelChunk chunk;
+    ChunkMesh mesh;
+    BOOL ok = TRUE;
+
+    // Charco de agua 3x3 con una piedra al lado (+X) y hojas encima del centro.
+    // Agua: 9 + 9 + 12 caras sueltas, menos la que toca la piedra y la tapada por las hojas.
+    memset(&chunk, 0, sizeof(VoxelChunk));
+    if (!chunk_storage_init(&chunk.storage, VOXEL_AIR)) return FALSE;
+    chunk_mesh_init(&mesh);
+    for (int x = 2; x <= 4; x++)
+        for (int y = 2; y <= 4; y++)
+            set_block_type(&chunk, x, y, 5, VOXEL_WATER);
+    set_block_type(&chunk, 5, 3, 5, VOXEL_STONE);
+    set_block_type(&chunk, 3, 3, 6, VOXEL_LEAVES);
+
+    const int expected[CHUNK_LAYER_COUNT] = {6, 6, 28};
+    for (int mode = CHUNK_MESH_NAIVE; mode <= CHUNK_MESH_BINARY; mode++) {
+        int area[CHUNK_LAYER_COUNT] = {0, 0, 0};
+        chunk.meshMode = (uint8)mode;
+        BOOL modeOk = build_chunk_mesh(&chunk, &mesh) && check_mesh_winding(&mesh) &&
+                      mesh.layerIndexCount[0] + mesh.layerIndexCount[1] + mesh.layerIndexCount[2] == mesh.indexCount;
+        for (int layer = 0; layer < CHUNK_LAYER_COUNT; layer++) {
+            modeOk &= mesh_layer_face_area(&mesh, layer, &area[layer]) && area[layer] == expected[layer];
+        }
+        printf("   - Capas (%s): %d caras opacas, %d recortadas, %d translúcidas %s\n",
+               k_chunk_meshers[mode].name, area[0], area[1], area[2], modeOk ? "OK" : "FALLO");
+        ok &= modeOk;
+    }
+
+    // Back-to-front: desde cualquier punto, cada quad está igual o más cerca que el anterior
+    chunk.meshMode = CHUNK_MESH_NAIVE;
+    build_chunk_mesh(&chunk, &mesh);
+    int count = mesh.layerIndexCount[CHUNK_LAYER_TRANSLUCENT] / 6;
+    ChunkTranslucentQuad* quads = (ChunkTranslucentQuad*)safe_malloc(count * sizeof(ChunkTranslucentQuad));
+    uint16* sorted = (uint16*)safe_malloc(count * 6 * sizeof(uint16));
+    if (quads && sorted) {
+        const int eyes[3][3] = {{-20, 7, 11}, {40, 40, 40}, {7, 7, 13}};
+        BOOL sortOk = extract_translucent_quads(&mesh, quads) == count;
+        for (int e = 0; e < 3; e++) {
+            sort_translucent_quads(quads, count, eyes[e], sorted);
+            for (int q = 0; q < count; q++) {
+                sortOk &= (q == 0 || quads[q].sortKey <= quads[q - 1].sortKey);
+                sortOk &= memcmp(&sorted[q * 6], quads[q].indices, sizeof(quads[q].indices)) == 0;
+            }
+        }
+        printf("   - Orden translúcido: %d quads de atrás hacia delante desde 3 puntos %s\n",
+               count, sortOk ? "OK" : "FALLO");
+        ok &= sortOk;
+    } else {
+        ok = FALSE;
+    }
+    safe_free(quads);
+    safe_free(sorted);
+
+    chunk_mesh_free(&mesh);
+    chunk_storage_free(&chunk.storage);
+    printf("   - Capas de render: %s\n", ok ? "OK" : "FALLO");
+    return ok;
+}
+
+// Grass plane at z = 0 in section (chunkX, chunkY, 0), enlazado con los chunks ya cargados
+static VoxelChunk* create_flat_field_chunk(ChunkManager* manager, int chunkX, int chunkY) {
+    VoxelChunk* chunk = get_or_create_chunk(manager, chunkX, chunkY, 0);
+    if (!chunk) return NULL;
+
+    for (int x = 0; x < 16; x++)
+        for (int y = 0; y < 16; y++)
+            set_block_type(chunk, x, y, 0, VOXEL_GRASS);
+    chunk->isGenerated = TRUE;
+    return chunk;
+}
+
+// Faces covered by one chunk's mesh with the given mesher
+static int chunk_face_area(VoxelChunk* chunk, ChunkMesh* mesh, int mode) {
+    return build_chunk_mesh_mode(chunk, mesh, mode) ? mesh_face_area(mesh) : -1;
+}
+
+BOOL verify_cross_chunk_culling(void) {
+    ChunkManager* manager = create_chunk_manager(32, 1);
+    ChunkMesh mesh;
+    BOOL ok = TRUE;
+
+    if (!manager) return FALSE;
+    manager->evictionPolicy.saveDirectory[0] = '\0'; // La prueba no toca el disco
+    chunk_mesh_init(&mesh);
+
+    // Campo de 3x3 chunks (48x48 bloques): arriba + abajo + solo el perímetro exterior.
+    // Sin culling entre chunks cada chunk dibujaría sus 64 caras laterales.
+    for (int cx = -1; cx <= 1; cx++)
+        for (int cy = -1; cy <= 1; cy++)
+            ok &= create_flat_field_chunk(manager, cx, cy) != NULL;
+
+    int expected = 2 * 48 * 48 + 4 * 48;
+    int unculled = 9 * (2 * 256 + 4 * 16);
+    for (int mode = CHUNK_MESH_NAIVE; mode <= CHUNK_MESH_BINARY; mode++) {
+        int faces = 0;
+        for (int i = 0; i < manager->maxChunks; i++) {
+            if (manager->chunks[i]) faces += chunk_face_area(manager->chunks[i], &mesh, mode);
+        }
+        printf("   - Campo 3x3 (%s): %d caras (esperadas %d, %d sin culling entre chunks) %s\n",
+               k_chunk_meshers[mode].name, faces, expected, unculled, faces == expected ? "OK" : "FALLO");
+        ok &= faces == expected;
+    }
+
+    // Loading a neighbour: solo los chunks que lo tocan se remallan y pierden su lateral
+    for (int i = 0; i < manager->maxChunks; i++) {
+        if (manager->chunks[i]) manager->chunks[i]->needsRemesh = FALSE;
+    }
+    VoxelChunk* east = create_flat_field_chunk(manager, 2, 0);
+    VoxelChunk* border = find_chunk(manager, 1, 0, 0);
+    VoxelChunk* inner = find_chunk(manager, 0, 0, 0);
+    BOOL loadOk = east && border && inner && border->needsRemesh && !inner->needsRemesh &&
+                  chunk_face_area(border, &mesh, CHUNK_MESH_BINARY) == 2 * 256;
+    printf("   - Vecino cargado: borde marcado para remesh y sin caras compartidas %s\n", loadOk ? "OK" : "FALLO");
+    ok &= loadOk;
+
+    // Border edit: el hueco en x = 15 destapa la cara -X del bloque del vecino
+    if (loadOk) {
+        int eastFaces = chunk_face_area(east, &mesh, CHUNK_MESH_BINARY);
+        east->needsRemesh = FALSE;
+        border->needsRemesh = FALSE;
+        set_block_type(border, 15, 8, 0, VOXEL_AIR);
+        mark_block_remesh(border, 15, 8, 0);
+        BOOL editOk = border->needsRemesh && east->needsRemesh && !inner->needsRemesh &&
+                      chunk_face_area(east, &mesh, CHUNK_MESH_BINARY) == eastFaces + 1;
+        printf("   - Edición en el borde: vecino marcado y cara destapada %s\n", editOk ? "OK" : "FALLO");
+        ok &= editOk;
+    }
+
+    chunk_mesh_free(&mesh);
+    destroy_chunk_manager(manager);
+    printf("   - Culling entre chunks: %s\n", ok ? "OK" : "FALLO");
+    return ok;
+}
+
+// Every corner on the level's cell grid (múltiplos de 2^lod bloques)
+static BOOL check_mesh_lod_grid(const ChunkMesh* mesh, int lod) {
+    int mask = (1 << lod) - 1;
+    for (int i = 0; i < mesh->vertexCount; i++) {
+        const ChunkVertex* v = &mesh->vertices[i];
+        if ((chunk_vertex_x(v) | chunk_vertex_y(v) | chunk_vertex_z(v)) & mask) return FALSE;
+    }
+    return mesh->lodLevel == lod;
+}
+
+static int chunk_lod_face_area(VoxelChunk* chunk, ChunkMesh* mesh) {
+    return build_chunk_mesh_mode(chunk, mesh, CHUNK_MESH_BINARY) && check_mesh_winding(mesh) ? mesh_face_area(mesh) : -1;
+}
+
+BOOL verify_chunk_lod(void) {
+    static VoxelChunk chunk;
+    ChunkMesh mesh;
+    BOOL ok = TRUE;
+
+    memset(&chunk, 0, sizeof(VoxelChunk));
+    if (!chunk_storage_init(&chunk.storage, VOXEL_AIR)) return FALSE;
+    chunk_mesh_init(&mesh);
+
+    // Losa 16x16x8: a cualquier nivel la misma superficie (arriba, abajo y 4 lados de 16x8)
+    for (int x = 0; x < 16; x++)
+        for (int y = 0; y < 16; y++)
+            for (int z = 0; z < 8; z++)
+                set_block_type(&chunk, x, y, z, VOXEL_STONE);
+    for (int lod = 0; lod < CHUNK_LOD_COUNT; lod++) {
+        chunk.lodLevel = (uint8)lod;
+        int area = chunk_lod_face_area(&chunk, &mesh);
+        BOOL levelOk = area == 2 * 256 + 4 * 128 && check_mesh_lod_grid(&mesh, lod);
+        printf("   - Losa a LOD %d: %d caras cubiertas, %d triángulos %s\n",
+               lod, area, chunk_mesh_triangle_count(&mesh), levelOk ? "OK" : "FALLO");
+        ok &= levelOk;
+    }
+
+    // Terreno irregular (alturas 4..8): cada nivel con menos triángulos que el anterior
+    for (int x = 0; x < 16; x++)
+        for (int y = 0; y < 16; y++)
+            for (int z = 0; z < 16; z++)
+                set_block_type(&chunk, x, y, z, z < 4 + (x * 7 + y * 13) % 5 ? VOXEL_DIRT : VOXEL_AIR);
+    int triangles[CHUNK_LOD_COUNT];
+    for (int lod = 0; lod < CHUNK_LOD_COUNT; lod++) {
+        chunk.lodLevel = (uint8)lod;
+        triangles[lod] = chunk_lod_face_area(&chunk, &mesh) > 0 && check_mesh_lod_grid(&mesh, lod)
+                         ? chunk_mesh_triangle_count(&mesh) : -1;
+    }
+    BOOL fewerOk = triangles[0] > triangles[1] && triangles[1] > triangles[2] && triangles[2] > 0;
+    printf("   - Terreno irregular: %d / %d / %d triángulos (1x / 2x / 4x) %s\n",
+           triangles[0], triangles[1], triangles[2], fewerOk ? "OK" : "FALLO");
+    ok &= fewerOk;
+    chunk_storage_free(&chunk.storage);
+
+    // Costura: dos chunks de césped (z = 0) lado a lado. Al mismo nivel no hay caras en el
+    // borde compartido; a niveles distintos cada uno pone su pared y el escalón queda cerrado.
+    ChunkManager* manager = create_chunk_manager(8, 1);
+    if (manager) {
+        manager->evictionPolicy.saveDirectory[0] = '\0';
+        VoxelChunk* west = create_flat_field_chunk(manager, 0, 0);
+        VoxelChunk* east = create_flat_field_chunk(manager, 1, 0);
+        BOOL seamOk = west && east && chunk_lod_face_area(west, &mesh) == 2 * 256 + 3 * 16;
+
+        // Solo el este a 2x: el oeste se remalla y muestra su lateral de 16x1; el este, con
+        // la superficie en z = 2, sus cuatro paredes de 16x2
+        if (seamOk) {
+            west->needsRemesh = FALSE;
+            set_chunk_lod(east, 1);
+            seamOk = west->needsRemesh && east->needsRemesh &&
+                     chunk_lod_face_area(west, &mesh) == 2 * 256 + 4 * 16 &&
+                     chunk_lod_face_area(east, &mesh) == 2 * 256 + 4 * 32;
+        }
+        printf("   - Costura 1x | 2x: paredes en los dos lados del borde %s\n", seamOk ? "OK" : "FALLO");
+        ok &= seamOk;
+
+        // Ambos a 2x: el borde se oculta con las celdas del vecino
+        if (seamOk) {
+            set_chunk_lod(west, 1);
+            seamOk = chunk_lod_face_area(west, &mesh) == 2 * 256 + 3 * 32 &&
+                     chunk_lod_face_area(east, &mesh) == 2 * 256 + 3 * 32;
+            printf("   - Costura 2x | 2x: sin caras en el borde compartido %s\n", seamOk ? "OK" : "FALLO");
+            ok &= seamOk;
+        }
+        destroy_chunk_manager(manager);
+    } else {
+        ok = FALSE;
+    }
+
+    // Selection: 720 píxeles de alto y 60 grados (623.5 píxeles por unidad a distancia 1).
+    // 2x desde ~156 bloques, 4x desde ~468; para volver a 1x hace falta bajar de ~125.
+    const float pixelsPerUnit = 623.5f;
+    BOOL selectOk = select_chunk_lod(50.0f, pixelsPerUnit, 0) == 0 &&
+                    select_chunk_lod(200.0f, pixelsPerUnit, 0) == 1 &&
+                    select_chunk_lod(600.0f, pixelsPerUnit, 0) == 2 &&
+                    select_chunk_lod(140.0f, pixelsPerUnit, 1) == 1 &&
+                    select_chunk_lod(140.0f, pixelsPerUnit, 0) == 0 &&
+                    select_chunk_lod(110.0f, pixelsPerUnit, 1) == 0 &&
+                    select_chunk_lod(50.0f, pixelsPerUnit, 2) == 0;
+    printf("   - Selección por error en pantalla (%.0f px) con histéresis %s\n",
+           CHUNK_LOD_MAX_ERROR_PIXELS, selectOk ? "OK" : "FALLO");
+    ok &= selectOk;
+
+    chunk_mesh_free(&mesh);
+    printf("   - Niveles de detalle: %s\n", ok ? "OK" : "FALLO");
+    return ok;
+}
@@ -0,0 +1,305 @@
+#include "world/chunk_mesh_worker.h"
+#include "core/memory.h"
+#include <stdio.h>
+#include <string.h>
+#include <windows.h>
+
+// Jobs cycle free -> pending -> done -> free. La lista libre y inFlight solo los toca el
+// hilo principal; pending y done van protegidas por el lock.
+static struct {
+    BOOL running;
+    BOOL stopping;
+    HANDLE threads[CHUNK_MESH_MAX_WORKERS];
+    int threadCount;
+    CRITICAL_SECTION lock;
+    CONDITION_VARIABLE jobReady;
+    ChunkMeshJob* jobs;
+    ChunkMeshJob* freeJobs;
+    ChunkMeshJob* pendingHead;
+    ChunkMeshJob* pendingTail;
+    ChunkMeshJob* doneHead;
+    ChunkMeshJob* doneTail;
+    int inFlight;
+    uint32 nextRevision;  // Global: un chunk descargado y vuelto a cargar no reutiliza revisiones
+} g_mesh_workers = {0};
+
+static void push_job(ChunkMeshJob** head, ChunkMeshJob** tail, ChunkMeshJob* job) {
+    job->next = NULL;
+    if (*tail) {
+        (*tail)->next = job;
+    } else {
+        *head = job;
+    }
+    *tail = job;
+}
+
+static ChunkMeshJob* pop_job(ChunkMeshJob** head, ChunkMeshJob** tail) {
+    ChunkMeshJob* job = *head;
+    if (!job) return NULL;
+    *head = job->next;
+    if (!*head) *tail = NULL;
+    job->next = NULL;
+    return job;
+}
+
+static DWORD WINAPI chunk_mesh_worker_main(LPVOID param) {
+    (void)param;
+    for (;;) {
+        EnterCriticalSection(&g_mesh_workers.lock);
+        while (!g_mesh_workers.pendingHead && !g_mesh_workers.stopping) {
+            SleepConditionVariableCS(&g_mesh_workers.jobReady, &g_mesh_workers.lock, INFINITE);
+        }
+        if (g_mesh_workers.stopping) {
+            LeaveCriticalSection(&g_mesh_workers.lock);
+            return 0;
+        }
+        ChunkMeshJob* job = pop_job(&g_mesh_workers.pendingHead, &g_mesh_workers.pendingTail);
+        LeaveCriticalSection(&g_mesh_workers.lock);
+
+        // Solo lee el snapshot: ningún chunk se toca fuera del hilo principal
+        job->built = build_chunk_mesh_from_snapshot(&job->snapshot, &job->mesh);
+
+        EnterCriticalSection(&g_mesh_workers.lock);
+        push_job(&g_mesh_workers.doneHead, &g_mesh_workers.doneTail, job);
+        LeaveCriticalSection(&g_mesh_workers.lock);
+    }
+}
+
+BOOL init_chunk_mesh_workers(int threadCount) {
+    if (g_mesh_workers.running) return TRUE;
+
+    if (threadCount <= 0) {
+        SYSTEM_INFO info;
+        GetSystemInfo(&info);
+        threadCount = (int)info.dwNumberOfProcessors - 1;  // Uno queda para el hilo principal
+    }
+    if (threadCount < 1) threadCount = 1;
+    if (threadCount > CHUNK_MESH_MAX_WORKERS) threadCount = CHUNK_MESH_MAX_WORKERS;
+
+    g_mesh_workers.jobs = (ChunkMeshJob*)safe_calloc(CHUNK_MESH_JOB_COUNT, sizeof(ChunkMeshJob));
+    if (!g_mesh_workers.jobs) return FALSE;
+    g_mesh_workers.freeJobs = NULL;
+    for (int i = CHUNK_MESH_JOB_COUNT - 1; i >= 0; i--) {
+        chunk_mesh_init(&g_mesh_workers.jobs[i].mesh);
+        g_mesh_workers.jobs[i].next = g_mesh_workers.freeJobs;
+        g_mesh_workers.freeJobs = &g_mesh_workers.jobs[i];
+    }
+
+    InitializeCriticalSection(&g_mesh_workers.lock);
+    InitializeConditionVariable(&g_mesh_workers.jobReady);
+    g_mesh_workers.pendingHead = g_mesh_workers.pendingTail = NULL;
+    g_mesh_workers.doneHead = g_mesh_workers.doneTail = NULL;
+    g_mesh_workers.inFlight = 0;
+    g_mesh_workers.stopping = FALSE;
+    g_mesh_workers.running = TRUE;
+
+    g_mesh_workers.threadCount = 0;
+    for (int i = 0; i < threadCount; i++) {
+        HANDLE thread = CreateThread(NULL, 0, chunk_mesh_worker_main, NULL, 0, NULL);
+        if (!thread) break;
+        g_mesh_workers.threads[g_mesh_workers.threadCount++] = thread;
+    }
+    if (g_mesh_workers.threadCount == 0) {
+        printf("ERROR: No se pudo crear ningún hilo de meshing\n");
+        shutdown_chunk_mesh_workers(NULL);
+        return FALSE;
+    }
+
+    printf("Chunk mesh workers: %d hilos, %d trabajos en vuelo como máximo\n",
+           g_mesh_workers.threadCount, CHUNK_MESH_JOB_COUNT);
+    return TRUE;
+}
+
+void shutdown_chunk_mesh_workers(ChunkManager* manager) {
+    if (!g_mesh_workers.running) return;
+
+    // Los trabajos aún pendientes se descartan; el que esté a medias termina antes de salir
+    EnterCriticalSection(&g_mesh_workers.lock);
+    g_mesh_workers.stopping = TRUE;
+    WakeAllConditionVariable(&g_mesh_workers.jobReady);
+    LeaveCriticalSection(&g_mesh_workers.lock);
+
+    if (g_mesh_workers.threadCount > 0) {
+        WaitForMultipleObjects((DWORD)g_mesh_workers.threadCount, g_mesh_workers.threads, TRUE, INFINITE);
+        for (int i = 0; i < g_mesh_workers.threadCount; i++) {
+            CloseHandle(g_mesh_workers.threads[i]);
+        }
+    }
+    DeleteCriticalSection(&g_mesh_workers.lock);
+
+    // Sus chunks tienen needsRemesh a FALSE desde el envío: se vuelven a marcar para que el
+    // mesh se rehaga (en el hilo principal si ya no hay workers)
+    ChunkMeshJob* unfinished[2] = {g_mesh_workers.pendingHead, g_mesh_workers.doneHead};
+    for (int list = 0; list < 2; list++) {
+        for (ChunkMeshJob* job = unfinished[list]; job; job = job->next) {
+            VoxelChunk* chunk = find_chunk_mesh_job_target(manager, job);
+            if (chunk) chunk->needsRemesh = TRUE;
+        }
+    }
+
+    for (int i = 0; i < CHUNK_MESH_JOB_COUNT; i++) {
+        chunk_mesh_free(&g_mesh_workers.jobs[i].mesh);
+    }
+    safe_free(g_mesh_workers.jobs);
+    memset(&g_mesh_workers, 0, sizeof(g_mesh_workers));
+}
+
+BOOL chunk_mesh_workers_running(void) {
+    return g_mesh_workers.running;
+}
+
+BOOL submit_chunk_mesh_job(VoxelChunk* chunk) {
+    if (!g_mesh_workers.running || !chunk || !g_mesh_workers.freeJobs) return FALSE;
+
+    ChunkMeshJob* job = g_mesh_workers.freeJobs;
+    if (!take_chunk_mesh_snapshot(chunk, &job->snapshot)) return FALSE;
+    g_mesh_workers.freeJobs = job->next;
+
+    job->chunkX = chunk->chunkX;
+    job->chunkY = chunk->chunkY;
+    job->chunkZ = chunk->chunkZ;
+    job->revision = ++g_mesh_workers.nextRevision;
+    job->built = FALSE;
+    chunk->meshRevision = job->revision;
+    chunk->needsRemesh = FALSE;  // Una edición posterior lo vuelve a marcar y deja este resultado viejo
+    g_mesh_workers.inFlight++;
+
+    EnterCriticalSection(&g_mesh_workers.lock);
+    push_job(&g_mesh_workers.pendingHead, &g_mesh_workers.pendingTail, job);
+    WakeConditionVariable(&g_mesh_workers.jobReady);
+    LeaveCriticalSection(&g_mesh_workers.lock);
+    return TRUE;
+}
+
+ChunkMeshJob* poll_chunk_mesh_job(void) {
+    if (!g_mesh_workers.running) return NULL;
+
+    EnterCriticalSection(&g_mesh_workers.lock);
+    ChunkMeshJob* job = pop_job(&g_mesh_workers.doneHead, &g_mesh_workers.doneTail);
+    LeaveCriticalSection(&g_mesh_workers.lock);
+    return job;
+}
+
+void release_chunk_mesh_job(ChunkMeshJob* job) {
+    if (!job) return;
+    job->next = g_mesh_workers.freeJobs;
+    g_mesh_workers.freeJobs = job;
+    g_mesh_workers.inFlight--;
+}
+
+VoxelChunk* find_chunk_mesh_job_target(ChunkManager* manager, const ChunkMeshJob* job) {
+    if (!manager || !job) return NULL;
+
+    VoxelChunk* chunk = find_chunk(manager, job->chunkX, job->chunkY, job->chunkZ);
+    if (!chunk || chunk->meshRevision != job->revision) return NULL;
+    return chunk;
+}
+
+int get_chunk_mesh_jobs_in_flight(void) {
+    return g_mesh_workers.inFlight;
+}
+
+// ============================================================================
+// SELF-CHECK - meshing en los workers frente al build síncrono
+// ============================================================================
+
+// Simulated frames: el hilo principal solo hace snapshots (con el mismo presupuesto que
+// el renderer) y recoge resultados; se mide su tiempo por frame
+BOOL verify_chunk_mesh_workers(ChunkManager* manager) {
+    if (!manager) return FALSE;
+
+    BOOL startedHere = FALSE;
+    if (!g_mesh_workers.running) {
+        if (!init_chunk_mesh_workers(0)) return FALSE;
+        startedHere = TRUE;
+    }
+
+    const double frameBudget = 0.0005;  // Snapshots por frame: 0.5 ms, igual que el renderer
+    int* expected = (int*)safe_malloc(manager->maxChunks * sizeof(int));
+    int* received = (int*)safe_malloc(manager->maxChunks * sizeof(int));
+    if (!expected || !received) {
+        safe_free(expected);
+        safe_free(received);
+        if (startedHere) shutdown_chunk_mesh_workers(manager);
+        return FALSE;
+    }
+
+    // Reference: build síncrono de cada chunk cargado
+    ChunkMesh mesh;
+    int chunks = 0;
+    chunk_mesh_init(&mesh);
+    for (int i = 0; i < manager->maxChunks; i++) {
+        VoxelChunk* chunk = manager->chunks[i];
+        expected[i] = -1;
+        received[i] = -1;
+        if (!chunk || !chunk->isGenerated) continue;
+        expected[i] = build_chunk_mesh(chunk, &mesh) ? mesh.indexCount : -1;
+        chunk->needsRemesh = TRUE;
+        chunks++;
+    }
+    chunk_mesh_free(&mesh);
+
+    LARGE_INTEGER freq, start, now;
+    QueryPerformanceFrequency(&freq);
+    double worstFrame = 0.0, totalMain = 0.0;
+    int frames = 0, completed = 0, stale = 0;
+    while (completed < chunks && frames < 2000) {
+        QueryPerformanceCounter(&start);
+        double elapsed = 0.0;
+
+        // Snapshot + submit dentro del presupuesto del frame
+        for (int i = 0; i < manager->maxChunks && elapsed < frameBudget; i++) {
+            VoxelChunk* chunk = manager->chunks[i];
+            if (!chunk || !chunk->isGenerated || !chunk->needsRemesh) continue;
+            if (!submit_chunk_mesh_job(chunk)) break;
+            QueryPerformanceCounter(&now);
+            elapsed = (double)(now.QuadPart - start.QuadPart) / (double)freq.QuadPart;
+        }
+
+        // Resultados terminados (en el juego aquí va la subida a GPU)
+        ChunkMeshJob* job;
+        while ((job = poll_chunk_mesh_job()) != NULL) {
+            VoxelChunk* chunk = find_chunk_mesh_job_target(manager, job);
+            if (chunk) {
+                for (int i = 0; i < manager->maxChunks; i++) {
+                    if (manager->chunks[i] == chunk) {
+                        if (received[i] < 0) completed++;
+                        received[i] = job->built ? job->mesh.indexCount : -1;
+                        break;
+                    }
+                }
+            } else {
+                stale++;
+            }
+            release_chunk_mesh_job(job);
+        }
+
+        QueryPerformanceCounter(&now);
+        elapsed = (double)(now.QuadPart - start.QuadPart) / (double)freq.QuadPart;
+        if (elapsed > worstFrame) worstFrame = elapsed;
+        totalMain += elapsed;
+        frames++;
+        Sleep(1);  // El resto del frame: los workers siguen mallando
+    }
+
+    BOOL ok = completed == chunks;
+    int mismatched = 0;
+    for (int i = 0; i < manager->maxChunks; i++) {
+        if (expected[i] != received[i]) mismatched++;
+        // El renderer vuelve a subir todo: sus trabajos en vuelo se recogieron aquí
+        if (manager->chunks[i] && manager->chunks[i]->isGenerated) manager->chunks[i]->needsRemesh = TRUE;
+    }
+    ok &= mismatched == 0;
+
+    // El tiempo por frame depende del reloj y de la carga de la máquina: se informa, no falla
+    printf("   - Workers: %d chunks en %d frames, %d distintos del build síncrono, %d resultados viejos descartados %s\n",
+           completed, frames, mismatched, stale, ok ? "OK" : "FALLO");
+    printf("   - Hilo principal: peor frame %.3f ms, media %.3f ms (objetivo 1 ms%s)\n",
+           worstFrame * 1000.0, frames ? totalMain * 1000.0 / frames : 0.0,
+           worstFrame < 0.001 ? "" : ", superado en esta pasada");
+
+    safe_free(expected);
+    safe_free(received);
+    if (startedHere) shutdown_chunk_mesh_workers(manager);
+    return ok;
+}
@@ -0,0 +1,688 @@
+#include "world/chunk_occlusion.h"
+#include "world/chunk_mesh.h"
+#include "core/memory.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+
+// Depth pyramid: nivel 0 a resolución completa, cada nivel siguiente con el máximo de 2x2.
+// Profundidad = z / w del clip (OpenGL, -1 cerca, 1 lejos), lineal en pantalla.
+static struct {
+    Matrix4x4 viewProjection;
+    int width[CHUNK_OCCLUSION_LEVELS];
+    int height[CHUNK_OCCLUSION_LEVELS];
+    int offset[CHUNK_OCCLUSION_LEVELS];
+    float depth[CHUNK_OCCLUSION_WIDTH * CHUNK_OCCLUSION_HEIGHT * 2];
+} g_occlusion;
+
+// Recorded camera path (anillo)
+static ChunkCameraFrame g_camera_frames[CHUNK_FLYTHROUGH_MAX_FRAMES];
+static int g_camera_frame_next = 0;
+static int g_camera_frame_count = 0;
+
+// ============================================================================
+// RASTERIZADOR DE OCLUSORES
+// ============================================================================
+
+void begin_occlusion_buffer(Matrix4x4 viewProjection) {
+    g_occlusion.viewProjection = viewProjection;
+
+    int offset = 0;
+    for (int level = 0; level < CHUNK_OCCLUSION_LEVELS; level++) {
+        int w = CHUNK_OCCLUSION_WIDTH >> level, h = CHUNK_OCCLUSION_HEIGHT >> level;
+        g_occlusion.width[level] = w > 0 ? w : 1;
+        g_occlusion.height[level] = h > 0 ? h : 1;
+        g_occlusion.offset[level] = offset;
+        offset += g_occlusion.width[level] * g_occlusion.height[level];
+    }
+    for (int i = 0; i < CHUNK_OCCLUSION_WIDTH * CHUNK_OCCLUSION_HEIGHT; i++) {
+        g_occlusion.depth[i] = 1.0f;
+    }
+}
+
+static void transform_to_clip(Vect3 p, float clip[4]) {
+    const Matrix4x4* m = &g_occlusion.viewProjection;
+    for (int j = 0; j < 4; j++) {
+        clip[j] = p.x * m->m[0][j] + p.y * m->m[1][j] + p.z * m->m[2][j] + m->m[3][j];
+    }
+}
+
+// Convex screen polygon (x, y en píxeles, profundidad): solo los píxeles que cubre por
+// completo, con la profundidad más lejana que alcanza dentro de cada uno. Las caras se
+// rasterizan enteras y no como dos triángulos: la diagonal no cubre del todo ningún píxel.
+static void rasterize_screen_polygon(float screen[][3], int count) {
+    float area = 0.0f;
+    int best = 1;
+    float bestArea = 0.0f;
+    for (int i = 1; i + 1 < count; i++) {
+        float part = (screen[i][0] - screen[0][0]) * (screen[i + 1][1] - screen[0][1]) -
+                     (screen[i + 1][0] - screen[0][0]) * (screen[i][1] - screen[0][1]);
+        area += part;
+        if (fabsf(part) > fabsf(bestArea)) {
+            bestArea = part;
+            best = i;
+        }
+    }
+    if (fabsf(bestArea) < 1e-6f) return;
+    float orientation = area < 0.0f ? -1.0f : 1.0f;
+
+    float minX = screen[0][0], maxX = screen[0][0], minY = screen[0][1], maxY = screen[0][1];
+    float maxDepth = screen[0][2];
+    for (int i = 1; i < count; i++) {
+        minX = fminf(minX, screen[i][0]);
+        maxX = fmaxf(maxX, screen[i][0]);
+        minY = fminf(minY, screen[i][1]);
+        maxY = fmaxf(maxY, screen[i][1]);
+        maxDepth = fmaxf(maxDepth, screen[i][2]);
+    }
+    int x0 = (int)floorf(minX), x1 = (int)ceilf(maxX) - 1;
+    int y0 = (int)floorf(minY), y1 = (int)ceilf(maxY) - 1;
+    if (x0 < 0) x0 = 0;
+    if (y0 < 0) y0 = 0;
+    if (x1 > CHUNK_OCCLUSION_WIDTH - 1) x1 = CHUNK_OCCLUSION_WIDTH - 1;
+    if (y1 > CHUNK_OCCLUSION_HEIGHT - 1) y1 = CHUNK_OCCLUSION_HEIGHT - 1;
+    if (x0 > x1 || y0 > y1) return;
+
+    // Edge i = v[i] -> v[i+1], positiva dentro; el píxel entero queda dentro si en su centro
+    // supera medio píxel de pendiente
+    float edgeX[6], edgeY[6], edgeC[6];
+    for (int i = 0; i < count; i++) {
+        const float* p = screen[i];
+        const float* q = screen[(i + 1) % count];
+        edgeX[i] = -(q[1] - p[1]) * orientation;
+        edgeY[i] = (q[0] - p[0]) * orientation;
+        edgeC[i] = -(edgeX[i] * p[0] + edgeY[i] * p[1]) - 0.5f * (fabsf(edgeX[i]) + fabsf(edgeY[i]));
+    }
+
+    // Depth plane through the largest triangle of the fan (la cara es plana)
+    const float* a = screen[0];
+    const float* b = screen[best];
+    const float* c = screen[best + 1];
+    float gradX = ((b[2] - a[2]) * (c[1] - a[1]) - (c[2] - a[2]) * (b[1] - a[1])) / bestArea;
+    float gradY = ((c[2] - a[2]) * (b[0] - a[0]) - (b[2] - a[2]) * (c[0] - a[0])) / bestArea;
+    float depthBias = 0.5f * (fabsf(gradX) + fabsf(gradY));
+
+    // Each row's span straight from the edges: x + 0.5 dentro de todas las semirrectas
+    for (int y = y0; y <= y1; y++) {
+        float py = y + 0.5f;
+        int spanStart = x0, spanEnd = x1;
+        for (int i = 0; i < count && spanStart <= spanEnd; i++) {
+            float rest = edgeY[i] * py + edgeC[i];
+            if (edgeX[i] > 0.0f) {
+                int first = (int)ceilf(-rest / edgeX[i] - 0.5f);
+                if (first > spanStart) spanStart = first;
+            } else if (edgeX[i] < 0.0f) {
+                int last = (int)floorf(-rest / edgeX[i] - 0.5f);
+                if (last < spanEnd) spanEnd = last;
+            } else if (rest < 0.0f) {
+                spanEnd = spanStart - 1;
+            }
+        }
+
+        float* row = g_occlusion.depth + y * CHUNK_OCCLUSION_WIDTH;
+        float depth = a[2] + gradX * (spanStart + 0.5f - a[0]) + gradY * (py - a[1]) + depthBias;
+        for (int x = spanStart; x <= spanEnd; x++, depth += gradX) {
+            float clamped = depth > maxDepth ? maxDepth : depth;
+            if (clamped < row[x]) row[x] = clamped;
+        }
+    }
+}
+
+// Clip a face against the near plane (z >= -w) and rasterize it; FALSE si queda detrás
+static BOOL rasterize_clip_quad(const float* clip[4]) {
+    float polygon[5][4];
+    int count = 0;
+    for (int i = 0; i < 4; i++) {
+        const float* p = clip[i];
+        const float* q = clip[(i + 1) % 4];
+        float dp = p[2] + p[3], dq = q[2] + q[3];
+        if (dp >= 0.0f) memcpy(polygon[count++], p, sizeof(float) * 4);
+        if ((dp >= 0.0f) != (dq >= 0.0f)) {
+            float t = dp / (dp - dq);
+            for (int j = 0; j < 4; j++) polygon[count][j] = p[j] + (q[j] - p[j]) * t;
+            count++;
+        }
+    }
+    if (count < 3) return FALSE;
+
+    float screen[5][3];
+    for (int i = 0; i < count; i++) {
+        float w = polygon[i][3];
+        if (w < 1e-6f) return FALSE;
+        screen[i][0] = (polygon[i][0] / w * 0.5f + 0.5f) * CHUNK_OCCLUSION_WIDTH;
+        screen[i][1] = (polygon[i][1] / w * 0.5f + 0.5f) * CHUNK_OCCLUSION_HEIGHT;
+        screen[i][2] = polygon[i][2] / w;
+    }
+    rasterize_screen_polygon(screen, count);
+    return TRUE;
+}
+
+// Faces of the box that look at the camera (como mucho tres), menos las marcadas en buried
+// (bit = cara en orden +X, -X, +Y, -Y, +Z, -Z pegada a otro oclusor que ya la tapa)
+static int rasterize_box_faces(Vect3 boxMin, Vect3 boxMax, Vect3 cameraPosition, uint8 buried) {
+    BOOL facing[6] = {
+        cameraPosition.x > boxMax.x, cameraPosition.x < boxMin.x,
+        cameraPosition.y > boxMax.y, cameraPosition.y < boxMin.y,
+        cameraPosition.z > boxMax.z, cameraPosition.z < boxMin.z
+    };
+    BOOL any = FALSE;
+    for (int face = 0; face < 6; face++) {
+        facing[face] = facing[face] && !(buried & (1u << face));
+        any |= facing[face];
+    }
+    if (!any) return 0;
+
+    float corners[8][4];
+    for (int i = 0; i < 8; i++) {
+        Vect3 corner = vect3_create(i & 1 ? boxMax.x : boxMin.x, i & 2 ? boxMax.y : boxMin.y,
+                                    i & 4 ? boxMax.z : boxMin.z);
+        transform_to_clip(corner, corners[i]);
+    }
+
+    // Corners of each face in order around it (bit 1: x, 2: y, 4: z)
+    static const int k_box_faces[6][4] = {
+        {1, 3, 7, 5}, {0, 4, 6, 2},  // +X, -X
+        {2, 6, 7, 3}, {0, 1, 5, 4},  // +Y, -Y
+        {4, 5, 7, 6}, {0, 2, 3, 1}   // +Z, -Z
+    };
+
+    int faces = 0;
+    for (int face = 0; face < 6; face++) {
+        if (!facing[face]) continue;
+        const int* quad = k_box_faces[face];
+        const float* clip[4] = {corners[quad[0]], corners[quad[1]], corners[quad[2]], corners[quad[3]]};
+        faces += rasterize_clip_quad(clip);
+    }
+    return faces;
+}
+
+int rasterize_occluder_box(Vect3 boxMin, Vect3 boxMax, Vect3 cameraPosition) {
+    return rasterize_box_faces(boxMin, boxMax, cameraPosition, 0);
+}
+
+void build_occlusion_pyramid(void) {
+    for (int level = 1; level < CHUNK_OCCLUSION_LEVELS; level++) {
+        const float* src = g_occlusion.depth + g_occlusion.offset[level - 1];
+        float* dst = g_occlusion.depth + g_occlusion.offset[level];
+        int srcWidth = g_occlusion.width[level - 1], srcHeight = g_occlusion.height[level - 1];
+        for (int y = 0; y < g_occlusion.height[level]; y++) {
+            int sy0 = y * 2, sy1 = sy0 + 1 < srcHeight ? sy0 + 1 : sy0;
+            for (int x = 0; x < g_occlusion.width[level]; x++) {
+                int sx0 = x * 2, sx1 = sx0 + 1 < srcWidth ? sx0 + 1 : sx0;
+                float d = fmaxf(fmaxf(src[sy0 * srcWidth + sx0], src[sy0 * srcWidth + sx1]),
+                                fmaxf(src[sy1 * srcWidth + sx0], src[sy1 * srcWidth + sx1]));
+                dst[y * g_occlusion.width[level] + x] = d;
+            }
+        }
+    }
+}
+
+// Screen rectangle and nearest depth of the box; tapada si todo el rectángulo tiene un
+// oclusor más cerca, mirado en el nivel donde ocupa como mucho 2x2 texels
+BOOL is_box_occluded(Vect3 boxMin, Vect3 boxMax) {
+    float minX = 1e30f, minY = 1e30f, maxX = -1e30f, maxY = -1e30f, nearest = 1.0f;
+    for (int i = 0; i < 8; i++) {
+        float clip[4];
+        transform_to_clip(vect3_create(i & 1 ? boxMax.x : boxMin.x, i & 2 ? boxMax.y : boxMin.y,
+                                       i & 4 ? boxMax.z : boxMin.z), clip);
+        if (clip[3] < 1e-6f || clip[2] < -clip[3]) return FALSE;  // Cruza el plano cercano
+        float x = (clip[0] / clip[3] * 0.5f + 0.5f) * CHUNK_OCCLUSION_WIDTH;
+        float y = (clip[1] / clip[3] * 0.5f + 0.5f) * CHUNK_OCCLUSION_HEIGHT;
+        minX = fminf(minX, x);
+        maxX = fmaxf(maxX, x);
+        minY = fminf(minY, y);
+        maxY = fmaxf(maxY, y);
+        nearest = fminf(nearest, clip[2] / clip[3]);
+    }
+
+    int x0 = (int)floorf(minX), x1 = (int)ceilf(maxX) - 1;
+    int y0 = (int)floorf(minY), y1 = (int)ceilf(maxY) - 1;
+    if (x0 < 0) x0 = 0;
+    if (y0 < 0) y0 = 0;
+    if (x1 > CHUNK_OCCLUSION_WIDTH - 1) x1 = CHUNK_OCCLUSION_WIDTH - 1;
+    if (y1 > CHUNK_OCCLUSION_HEIGHT - 1) y1 = CHUNK_OCCLUSION_HEIGHT - 1;
+    if (x0 > x1 || y0 > y1) return FALSE;  // Fuera de la pantalla: eso lo decide el frustum
+
+    int level = 0;
+    while (level < CHUNK_OCCLUSION_LEVELS - 1 && ((x1 >> level) - (x0 >> level) > 1 || (y1 >> level) - (y0 >> level) > 1)) {
+        level++;
+    }
+
+    const float* depth = g_occlusion.depth + g_occlusion.offset[level];
+    int width = g_occlusion.width[level];
+    for (int y = y0 >> level; y <= (y1 >> level); y++) {
+        for (int x = x0 >> level; x <= (x1 >> level); x++) {
+            if (depth[y * width + x] >= nearest) return FALSE;
+        }
+    }
+    return TRUE;
+}
+
+// ============================================================================
+// CHUNKS
+// ============================================================================
+
+// Side of a chunk entirely opaque (sus 16x16 bloques de ese borde), orden +X, -X, +Y, -Y, +Z, -Z
+static BOOL chunk_side_solid(const VoxelChunk* chunk, int face) {
+    if (!chunk || !chunk->isGenerated) return FALSE;
+    for (int a = 0; a < CHUNK_SIZE; a++) {
+        for (int b = 0; b < CHUNK_SIZE; b++) {
+            uint16 column;
+            uint16 need = 0xFFFF;
+            switch (face) {
+                case 0: column = chunk->opaqueMask[CHUNK_SIZE - 1][a]; break;
+                case 1: column = chunk->opaqueMask[0][a]; break;
+                case 2: column = chunk->opaqueMask[a][CHUNK_SIZE - 1]; break;
+                case 3: column = chunk->opaqueMask[a][0]; break;
+                case 4: column = chunk->opaqueMask[a][b]; need = 0x8000; break;
+                default: column = chunk->opaqueMask[a][b]; need = 0x0001; break;
+            }
+            if ((column & need) != need) return FALSE;
+            if (face < 4) break;  // Los lados en x e y son una columna por a
+        }
+    }
+    return TRUE;
+}
+
+// Solid interior of a chunk as boxes: celdas de 4x4x4 bloques opacos, tramos en z por columna
+// de celdas y columnas vecinas en x con los mismos tramos fusionadas. Las caras pegadas a
+// otra celda llena no se dibujan: la superficie que sí se ve ya tapa lo mismo.
+static int rasterize_chunk_occluders(VoxelChunk* chunk, Vect3 cameraPosition, int* faces) {
+    enum { CELLS = CHUNK_SIZE / CHUNK_OCCLUDER_CELL };
+    uint8 cellMask[CELLS][CELLS];  // Bit z: celda llena
+    uint8 all = 0xFF;
+
+    for (int cx = 0; cx < CELLS; cx++) {
+        for (int cy = 0; cy < CELLS; cy++) {
+            uint16 column = 0xFFFF;
+            for (int x = cx * CHUNK_OCCLUDER_CELL; x < (cx + 1) * CHUNK_OCCLUDER_CELL; x++)
+                for (int y = cy * CHUNK_OCCLUDER_CELL; y < (cy + 1) * CHUNK_OCCLUDER_CELL; y++)
+                    column &= chunk->opaqueMask[x][y];
+
+            uint8 mask = 0;
+            for (int cz = 0; cz < CELLS; cz++) {
+                uint16 cell = (uint16)(((1u << CHUNK_OCCLUDER_CELL) - 1) << (cz * CHUNK_OCCLUDER_CELL));
+                if ((column & cell) == cell) mask |= (uint8)(1u << cz);
+            }
+            cellMask[cx][cy] = mask;
+            all &= mask;
+        }
+    }
+
+    float originX = chunk->chunkX * CHUNK_SIZE - 0.5f;
+    float originY = chunk->chunkY * CHUNK_SIZE - 0.5f;
+    float originZ = chunk->chunkZ * CHUNK_SIZE - 0.5f;
+    if (all == (1u << CELLS) - 1) {
+        // Chunk macizo: una caja, sin las caras contra un vecino macizo por ese lado
+        uint8 buried = 0;
+        for (int face = 0; face < 6; face++) {
+            const int8* offset = k_chunk_face_offsets[face];
+            VoxelChunk* neighbor = chunk->neighbors[chunk_neighbor_index(offset[0], offset[1], offset[2])];
+            if (chunk_side_solid(neighbor, face ^ 1)) buried |= (uint8)(1u << face);
+        }
+        *faces += rasterize_box_faces(vect3_create(originX, originY, originZ),
+                                      vect3_create(originX + CHUNK_SIZE, originY + CHUNK_SIZE, originZ + CHUNK_SIZE),
+                                      cameraPosition, buried);
+        return 1;
+    }
+
+    int boxes = 0;
+    for (int cy = 0; cy < CELLS; cy++) {
+        for (int cx = 0; cx < CELLS;) {
+            uint8 mask = cellMask[cx][cy];
+            int end = cx + 1;
+            while (end < CELLS && cellMask[end][cy] == mask) end++;
+
+            for (int cz = 0; cz < CELLS && mask;) {
+                if (!(mask & (1u << cz))) { cz++; continue; }
+                int top = cz;
+                while (top + 1 < CELLS && (mask & (1u << (top + 1)))) top++;
+
+                // Los tramos acaban en celdas vacías, así que solo los lados en x e y pueden quedar tapados
+                uint8 run = (uint8)(((1u << (top - cz + 1)) - 1) << cz);
+                uint8 buried = 0;
+                if (end < CELLS && (cellMask[end][cy] & run) == run) buried |= 1u << 0;
+                if (cx > 0 && (cellMask[cx - 1][cy] & run) == run) buried |= 1u << 1;
+                BOOL coveredPlusY = cy + 1 < CELLS, coveredMinusY = cy > 0;
+                for (int x = cx; x < end; x++) {
+                    coveredPlusY = coveredPlusY && (cellMask[x][cy + 1] & run) == run;
+                    coveredMinusY = coveredMinusY && (cellMask[x][cy - 1] & run) == run;
+                }
+                if (coveredPlusY) buried |= 1u << 2;
+                if (coveredMinusY) buried |= 1u << 3;
+
+                Vect3 boxMin = vect3_create(originX + cx * CHUNK_OCCLUDER_CELL, originY + cy * CHUNK_OCCLUDER_CELL,
+                                            originZ + cz * CHUNK_OCCLUDER_CELL);
+                Vect3 boxMax = vect3_create(originX + end * CHUNK_OCCLUDER_CELL, originY + (cy + 1) * CHUNK_OCCLUDER_CELL,
+                                            originZ + (top + 1) * CHUNK_OCCLUDER_CELL);
+                *faces += rasterize_box_faces(boxMin, boxMax, cameraPosition, buried);
+                boxes++;
+                cz = top + 1;
+            }
+            cx = end;
+        }
+    }
+    return boxes;
+}
+
+static float chunk_box_distance(const VoxelChunk* chunk, Vect3 p) {
+    float minX = chunk->chunkX * CHUNK_SIZE - 0.5f;
+    float minY = chunk->chunkY * CHUNK_SIZE - 0.5f;
+    float minZ = chunk->chunkZ * CHUNK_SIZE - 0.5f;
+    float dx = fmaxf(fmaxf(minX - p.x, p.x - (minX + CHUNK_SIZE)), 0.0f);
+    float dy = fmaxf(fmaxf(minY - p.y, p.y - (minY + CHUNK_SIZE)), 0.0f);
+    float dz = fmaxf(fmaxf(minZ - p.z, p.z - (minZ + CHUNK_SIZE)), 0.0f);
+    return sqrtf(dx * dx + dy * dy + dz * dz);
+}
+
+ChunkOcclusionStats update_chunk_occlusion(ChunkManager* manager, Vect3 cameraPosition, const Frustum* frustum) {
+    ChunkOcclusionStats stats = {0, 0, 0, 0};
+    if (!manager || !frustum) return stats;
+
+    begin_occlusion_buffer(frustum->viewProjection);
+    for (int i = 0; i < manager->maxChunks; i++) {
+        VoxelChunk* chunk = manager->chunks[i];
+        if (!chunk || !chunk->isGenerated || !chunk->isVisible || is_chunk_empty(chunk)) continue;
+        if (chunk_box_distance(chunk, cameraPosition) > CHUNK_OCCLUDER_DISTANCE) continue;
+        stats.occluderBoxes += rasterize_chunk_occluders(chunk, cameraPosition, &stats.occluderFaces);
+    }
+    build_occlusion_pyramid();
+
+    for (int i = 0; i < manager->maxChunks; i++) {
+        VoxelChunk* chunk = manager->chunks[i];
+        if (!chunk || !chunk->isGenerated || !chunk->isVisible) continue;
+
+        Vect3 boxMin = vect3_create(chunk->chunkX * CHUNK_SIZE - 0.5f, chunk->chunkY * CHUNK_SIZE - 0.5f,
+                                    chunk->chunkZ * CHUNK_SIZE - 0.5f);
+        Vect3 boxMax = vect3_create(boxMin.x + CHUNK_SIZE, boxMin.y + CHUNK_SIZE, boxMin.z + CHUNK_SIZE);
+        stats.tested++;
+        if (is_box_occluded(boxMin, boxMax)) {
+            chunk->isVisible = FALSE;
+            stats.occluded++;
+        }
+    }
+    return stats;
+}
+
+// ============================================================================
+// VUELO GRABADO
+// ============================================================================
+
+void record_camera_frame(Vect3 position, Vect3 target, Vect3 up) {
+    ChunkCameraFrame* frame = &g_camera_frames[g_camera_frame_next];
+    frame->position = position;
+    frame->target = target;
+    frame->up = up;
+    g_camera_frame_next = (g_camera_frame_next + 1) % CHUNK_FLYTHROUGH_MAX_FRAMES;
+    if (g_camera_frame_count < CHUNK_FLYTHROUGH_MAX_FRAMES) g_camera_frame_count++;
+}
+
+int get_recorded_camera_frames(ChunkCameraFrame* frames, int maxFrames) {
+    int count = g_camera_frame_count < maxFrames ? g_camera_frame_count : maxFrames;
+    int first = (g_camera_frame_next - count + CHUNK_FLYTHROUGH_MAX_FRAMES) % CHUNK_FLYTHROUGH_MAX_FRAMES;
+    for (int i = 0; i < count; i++) {
+        frames[i] = g_camera_frames[(first + i) % CHUNK_FLYTHROUGH_MAX_FRAMES];
+    }
+    return count;
+}
+
+void report_occlusion_flythrough(ChunkManager* manager, const ChunkCameraFrame* frames, int frameCount,
+                                 float fovYDegrees, float aspect) {
+    if (!manager || !frames || frameCount <= 0) return;
+
+    int* triangles = (int*)safe_malloc(manager->maxChunks * sizeof(int));
+    if (!triangles) return;
+
+    ChunkMesh mesh;
+    chunk_mesh_init(&mesh);
+    int chunkCount = 0;
+    for (int i = 0; i < manager->maxChunks; i++) {
+        VoxelChunk* chunk = manager->chunks[i];
+        triangles[i] = 0;
+        if (!chunk || !chunk->isGenerated) continue;
+        chunkCount++;
+        if (!is_chunk_empty(chunk) && build_chunk_mesh(chunk, &mesh)) triangles[i] = chunk_mesh_triangle_count(&mesh);
+    }
+    chunk_mesh_free(&mesh);
+
+    // Stage 0: frustum, 1: + cave culling, 2: + oclusión
+    double chunksDrawn[3] = {0, 0, 0}, trianglesDrawn[3] = {0, 0, 0};
+    double occlusionSeconds = 0.0, occluderFaces = 0.0;
+    LARGE_INTEGER freq, start, end;
+    QueryPerformanceFrequency(&freq);
+    Frustum frustum;
+
+    for (int f = 0; f < frameCount; f++) {
+        frustum_from_camera(&frustum, frames[f].position, frames[f].target, frames[f].up,
+                            fovYDegrees, aspect, 0.1f, 1000.0f);
+        update_chunk_frustum_visibility(manager, &frustum);
+        for (int stage = 0; stage < 3; stage++) {
+            if (stage == 1) {
+                update_chunk_cave_visibility(manager, frames[f].position);
+            } else if (stage == 2) {
+                QueryPerformanceCounter(&start);
+                ChunkOcclusionStats stats = update_chunk_occlusion(manager, frames[f].position, &frustum);
+                QueryPerformanceCounter(&end);
+                occlusionSeconds += (double)(end.QuadPart - start.QuadPart) / (double)freq.QuadPart;
+                occluderFaces += stats.occluderFaces;
+            }
+            for (int i = 0; i < manager->maxChunks; i++) {
+                VoxelChunk* chunk = manager->chunks[i];
+                if (!chunk || !chunk->isGenerated || !chunk->isVisible || !triangles[i]) continue;
+                chunksDrawn[stage]++;
+                trianglesDrawn[stage] += triangles[i];
+            }
+        }
+    }
+    safe_free(triangles);
+
+    printf("   - Vuelo de %d frames sobre %d chunks (por frame, solo chunks con geometría):\n", frameCount, chunkCount);
+    const char* names[3] = {"frustum", "+ cave culling", "+ oclusión"};
+    for (int stage = 0; stage < 3; stage++) {
+        double savedChunks = stage ? 100.0 * (1.0 - chunksDrawn[stage] / fmax(chunksDrawn[stage - 1], 1.0)) : 0.0;
+        double savedTriangles = stage ? 100.0 * (1.0 - trianglesDrawn[stage] / fmax(trianglesDrawn[stage - 1], 1.0)) : 0.0;
+        printf("     %-15s: %.1f chunks, %.0f triángulos (-%.1f%% chunks, -%.1f%% triángulos sobre el paso anterior)\n",
+               names[stage], chunksDrawn[stage] / frameCount, trianglesDrawn[stage] / frameCount,
+               savedChunks, savedTriangles);
+    }
+    printf("   - Oclusión: %.1f us por frame, %.0f caras oclusoras rasterizadas\n",
+           occlusionSeconds * 1e6 / frameCount, occluderFaces / frameCount);
+}
+
+// ============================================================================
+// SELF-CHECK
+// ============================================================================
+
+static BOOL segment_hits_box(Vect3 from, Vect3 to, Vect3 boxMin, Vect3 boxMax) {
+    float tMin = 0.0f, tMax = 1.0f;
+    float origin[3] = {from.x, from.y, from.z};
+    float delta[3] = {to.x - from.x, to.y - from.y, to.z - from.z};
+    float lo[3] = {boxMin.x, boxMin.y, boxMin.z}, hi[3] = {boxMax.x, boxMax.y, boxMax.z};
+    for (int axis = 0; axis < 3; axis++) {
+        if (fabsf(delta[axis]) < 1e-9f) {
+            if (origin[axis] < lo[axis] || origin[axis] > hi[axis]) return FALSE;
+            continue;
+        }
+        float t0 = (lo[axis] - origin[axis]) / delta[axis];
+        float t1 = (hi[axis] - origin[axis]) / delta[axis];
+        if (t0 > t1) { float t = t0; t0 = t1; t1 = t; }
+        if (t0 > tMin) tMin = t0;
+        if (t1 < tMax) tMax = t1;
+        if (tMin > tMax) return FALSE;
+    }
+    return tMax > 0.0f && tMin < 1.0f;
+}
+
+static float next_occlusion_float(uint32* state, float lo, float hi) {
+    *state = *state * 1664525u + 1013904223u;
+    return lo + (float)(*state >> 8) / 16777216.0f * (hi - lo);
+}
+
+// Rolling hills (stone, dirt, grass) with a sparse forest, Z arriba
+static int hill_height(int x, int y) {
+    return 20 + (int)(12.0f * sinf(x * 0.07f) * cosf(y * 0.05f) + 6.0f * sinf((x + y) * 0.13f));
+}
+
+static void set_world_block(ChunkManager* manager, int x, int y, int z, VoxelType type) {
+    int cx = x >> 4, cy = y >> 4, cz = z >> 4;  // Desplazamiento aritmético: suelo también en negativos
+    VoxelChunk* chunk = find_chunk(manager, cx, cy, cz);
+    if (chunk) set_block_type(chunk, x - cx * CHUNK_SIZE, y - cy * CHUNK_SIZE, z - cz * CHUNK_SIZE, type);
+}
+
+static void build_hill_scene(ChunkManager* manager, int radius) {
+    for (int cx = -radius; cx < radius; cx++)
+        for (int cy = -radius; cy < radius; cy++)
+            for (int cz = 0; cz < 3; cz++)
+                get_or_create_chunk(manager, cx, cy, cz);
+
+    int extent = radius * CHUNK_SIZE;
+    for (int x = -extent; x < extent; x++) {
+        for (int y = -extent; y < extent; y++) {
+            int h = hill_height(x, y);
+            for (int z = 0; z <= h; z++) {
+                set_world_block(manager, x, y, z, z == h ? VOXEL_GRASS : (z > h - 3 ? VOXEL_DIRT : VOXEL_STONE));
+            }
+
+            // Árbol: tronco de 5 y copa de 5x5x3 de hojas
+            uint32 hash = (uint32)x * 73856093u ^ (uint32)y * 19349663u;
+            if (hash % 61 != 0 || x < -extent + 2 || x >= extent - 2 || y < -extent + 2 || y >= extent - 2) continue;
+            for (int z = h + 1; z <= h + 5; z++) set_world_block(manager, x, y, z, VOXEL_WOOD);
+            for (int dx = -2; dx <= 2; dx++)
+                for (int dy = -2; dy <= 2; dy++)
+                    for (int z = h + 4; z <= h + 6; z++)
+                        if (dx || dy || z == h + 6) set_world_block(manager, x + dx, y + dy, z, VOXEL_LEAVES);
+        }
+    }
+
+    for (int i = 0; i < manager->maxChunks; i++) {
+        VoxelChunk* chunk = manager->chunks[i];
+        if (!chunk) continue;
+        chunk_storage_compact(&chunk->storage);
+        chunk->isGenerated = TRUE;
+        chunk->needsRemesh = FALSE;
+        update_chunk_connectivity(chunk);
+    }
+}
+
+BOOL verify_chunk_occlusion(void) {
+    BOOL ok = TRUE;
+    Frustum frustum;
+    Vect3 eye = vect3_create(0, 0, 0);
+    Vect3 up = vect3_create(0, 0, 1);
+
+    // Muro de 4x4 a 10 unidades mirando a +X (medio ángulo de 11 grados)
+    frustum_from_camera(&frustum, eye, vect3_create(1, 0, 0), up, 60.0f, 2.0f, 0.1f, 200.0f);
+    begin_occlusion_buffer(frustum.viewProjection);
+    rasterize_occluder_box(vect3_create(10, -2, -2), vect3_create(11, 2, 2), eye);
+    build_occlusion_pyramid();
+    struct { Vect3 min, max; BOOL occluded; const char* name; } wallCases[] = {
+        {{30, -1, -1}, {31, 1, 1}, TRUE, "detrás del muro"},
+        {{5, -1, -1}, {6, 1, 1}, FALSE, "delante del muro"},
+        {{30, 5, -1}, {31, 7, 1}, FALSE, "asomando por el borde"},
+        {{30, 8, -1}, {31, 10, 1}, FALSE, "a un lado"},
+        {{9, -1, -1}, {12, 1, 1}, FALSE, "atravesando el muro"}
+    };
+    int wallCount = (int)(sizeof(wallCases) / sizeof(wallCases[0]));
+    BOOL wallOk = TRUE;
+    for (int i = 0; i < wallCount; i++) {
+        BOOL occluded = is_box_occluded(wallCases[i].min, wallCases[i].max);
+        if (occluded != wallCases[i].occluded) {
+            printf("   - Caja %s: %s FALLO\n", wallCases[i].name, occluded ? "descartada" : "visible");
+            wallOk = FALSE;
+        }
+    }
+    printf("   - Muro delante de la cámara: %d casos %s\n", wallCount, wallOk ? "OK" : "FALLO");
+    ok &= wallOk;
+
+    // Suelo que pasa por debajo de la cámara (recortado contra el plano cercano) mirando hacia abajo
+    frustum_from_camera(&frustum, eye, vect3_create(1, 0, -0.3f), up, 60.0f, 2.0f, 0.1f, 200.0f);
+    begin_occlusion_buffer(frustum.viewProjection);
+    int groundFaces = rasterize_occluder_box(vect3_create(-50, -50, -10), vect3_create(50, 50, -1), eye);
+    build_occlusion_pyramid();
+    BOOL under = is_box_occluded(vect3_create(30, -2, -8), vect3_create(32, 2, -5));
+    BOOL above = is_box_occluded(vect3_create(30, -2, 1), vect3_create(32, 2, 3));
+    BOOL groundOk = under && !above && groundFaces > 0;
+    printf("   - Suelo recortado por el plano cercano (%d cara): enterrada %s, encima %s %s\n",
+           groundFaces, under ? "descartada" : "visible", above ? "descartada" : "visible",
+           groundOk ? "OK" : "FALLO");
+    ok &= groundOk;
+
+    // Escenas aleatorias: ninguna caja descartada puede tener un punto dentro del frustum al que
+    // llegue un rayo desde la cámara sin cruzar un oclusor
+    uint32 seed = 4242u;
+    int tested = 0, occludedCount = 0, falseCulls = 0;
+    for (int scene = 0; scene < 20; scene++) {
+        Vect3 camera = vect3_create(next_occlusion_float(&seed, -5, 5), next_occlusion_float(&seed, -5, 5),
+                                    next_occlusion_float(&seed, -2, 2));
+        Vect3 target = vect3_create(camera.x + 1, camera.y + next_occlusion_float(&seed, -0.5f, 0.5f),
+                                    camera.z + next_occlusion_float(&seed, -0.3f, 0.3f));
+        frustum_from_camera(&frustum, camera, target, up, 70.0f, 16.0f / 9.0f, 0.1f, 300.0f);
+        begin_occlusion_buffer(frustum.viewProjection);
+
+        Vect3 occluderMin[12], occluderMax[12];
+        for (int o = 0; o < 12; o++) {
+            occluderMin[o] = vect3_create(next_occlusion_float(&seed, 8, 40), next_occlusion_float(&seed, -30, 25),
+                                          next_occlusion_float(&seed, -15, 10));
+            occluderMax[o] = vect3_create(occluderMin[o].x + next_occlusion_float(&seed, 1, 6),
+                                          occluderMin[o].y + next_occlusion_float(&seed, 2, 16),
+                                          occluderMin[o].z + next_occlusion_float(&seed, 2, 12));
+            rasterize_occluder_box(occluderMin[o], occluderMax[o], camera);
+        }
+        build_occlusion_pyramid();
+
+        for (int b = 0; b < 100; b++) {
+            Vect3 boxMin = vect3_create(next_occlusion_float(&seed, 45, 90), next_occlusion_float(&seed, -40, 35),
+                                        next_occlusion_float(&seed, -20, 15));
+            Vect3 boxMax = vect3_create(boxMin.x + next_occlusion_float(&seed, 0.5f, 4),
+                                        boxMin.y + next_occlusion_float(&seed, 0.5f, 4),
+                                        boxMin.z + next_occlusion_float(&seed, 0.5f, 4));
+            tested++;
+            if (!is_box_occluded(boxMin, boxMax)) continue;
+            occludedCount++;
+
+            // 6x6x6 puntos repartidos por la caja, esquinas incluidas
+            BOOL seen = FALSE;
+            for (int s = 0; s < 216 && !seen; s++) {
+                Vect3 point = vect3_create(boxMin.x + (boxMax.x - boxMin.x) * (s % 6) / 5.0f,
+                                           boxMin.y + (boxMax.y - boxMin.y) * ((s / 6) % 6) / 5.0f,
+                                           boxMin.z + (boxMax.z - boxMin.z) * (s / 36) / 5.0f);
+                BOOL blocked = !frustum_intersects_box(&frustum, point, point);
+                for (int o = 0; o < 12 && !blocked; o++) {
+                    blocked = segment_hits_box(camera, point, occluderMin[o], occluderMax[o]);
+                }
+                seen = !blocked;
+            }
+            falseCulls += seen;
+        }
+    }
+    BOOL randomOk = falseCulls == 0 && occludedCount > 0;
+    printf("   - Escenas aleatorias: %d de %d cajas descartadas, %d visibles por algún rayo %s\n",
+           occludedCount, tested, falseCulls, randomOk ? "OK" : "FALLO");
+    ok &= randomOk;
+
+    // Vuelo a ras de suelo sobre colinas con bosque, 12x12x3 chunks
+    ChunkManager* manager = create_chunk_manager(512, 1);
+    if (manager) {
+        manager->evictionPolicy.saveDirectory[0] = '\0';
+        build_hill_scene(manager, 6);
+
+        enum { FLIGHT_FRAMES = 240 };
+        static ChunkCameraFrame flight[FLIGHT_FRAMES];
+        for (int f = 0; f < FLIGHT_FRAMES; f++) {
+            float t = (float)f / FLIGHT_FRAMES;
+            float x = -80.0f + 160.0f * t, y = -20.0f + 30.0f * sinf(t * 6.2831853f);
+            float heading = 0.6f * cosf(t * 6.2831853f);
+            flight[f].position = vect3_create(x, y, hill_height((int)floorf(x), (int)floorf(y)) + 2.5f);
+            flight[f].target = vect3_create(x + cosf(heading), y + sinf(heading), flight[f].position.z - 0.05f);
+            flight[f].up = up;
+        }
+        report_occlusion_flythrough(manager, flight, FLIGHT_FRAMES, 70.0f, 16.0f / 9.0f);
+        destroy_chunk_manager(manager);
+    } else {
+        ok = FALSE;
+    }
+
+    printf("   - Oclusión jerárquica: %s\n", ok ? "OK" : "FALLO");
+    return ok;
+}
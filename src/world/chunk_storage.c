@@ -0,0 +1,576 @@
+#include "world/chunk_storage.h"
+#include "world/chunk_system.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+// log2 of the supported bit widths (1, 2, 4, 8)
+static const uint8 k_bits_log2[CHUNK_STORAGE_MAX_BITS + 1] = {0, 0, 1, 0, 2, 0, 0, 0, 3};
+
+static size_t storage_word_count(uint8 bits) {
+    return (size_t)(CHUNK_VOLUME * bits) / 32;
+}
+
+// Read a packed palette index
+static inline uint32 read_packed(const uint32* data, uint8 bits, int index) {
+    int entriesShift = 5 - k_bits_log2[bits];              // log2(32 / bits)
+    int word = index >> entriesShift;
+    int offset = (index & ((1 << entriesShift) - 1)) * bits;
+    return (data[word] >> offset) & ((1u << bits) - 1u);
+}
+
+// Write a packed palette index
+static inline void write_packed(uint32* data, uint8 bits, int index, uint32 value) {
+    int entriesShift = 5 - k_bits_log2[bits];
+    int word = index >> entriesShift;
+    int offset = (index & ((1 << entriesShift) - 1)) * bits;
+    uint32 mask = ((1u << bits) - 1u) << offset;
+    data[word] = (data[word] & ~mask) | ((value << offset) & mask);
+}
+
+// Smallest supported bit width able to address paletteCount entries
+static uint8 bits_for_palette(int paletteCount) {
+    uint8 bits = 1;
+    while (bits < CHUNK_STORAGE_MAX_BITS && (1 << bits) < paletteCount) {
+        bits *= 2;
+    }
+    return bits;
+}
+
+// Re-encode every index with a new bit width, optionally remapping palette indices
+static BOOL repack_storage(ChunkBlockStorage* storage, uint8 newBits, const uint8* remap) {
+    uint32* newData = (uint32*)safe_calloc(storage_word_count(newBits), sizeof(uint32));
+    if (!newData) return FALSE;
+
+    for (int i = 0; i < CHUNK_VOLUME; i++) {
+        uint32 value = read_packed(storage->data, storage->bitsPerIndex, i);
+        if (remap) value = remap[value];
+        write_packed(newData, newBits, i, value);
+    }
+
+    safe_free(storage->data);
+    storage->data = newData;
+    storage->bitsPerIndex = newBits;
+    return TRUE;
+}
+
+static int find_palette_entry(const ChunkBlockStorage* storage, uint8 block) {
+    for (int i = 0; i < storage->paletteCount; i++) {
+        if (storage->palette[i] == block) return i;
+    }
+    return -1;
+}
+
+// Initialize storage as uniform fillBlock: no index data is allocated until the first edit
+BOOL chunk_storage_init(ChunkBlockStorage* storage, uint8 fillBlock) {
+    if (!storage) return FALSE;
+
+    memset(storage, 0, sizeof(ChunkBlockStorage));
+    storage->bitsPerIndex = 0;
+    storage->paletteCount = 1;
+    storage->palette[0] = fillBlock;
+    storage->data = NULL;
+    return TRUE;
+}
+
+// Uniform -> 1-bit storage, every voxel pointing at palette[0]
+static BOOL promote_uniform_storage(ChunkBlockStorage* storage) {
+    storage->data = (uint32*)safe_calloc(storage_word_count(1), sizeof(uint32));
+    if (!storage->data) return FALSE;
+    storage->bitsPerIndex = 1;
+    return TRUE;
+}
+
+void chunk_storage_free(ChunkBlockStorage* storage) {
+    if (!storage) return;
+
+    safe_free(storage->data);
+    storage->data = NULL;
+    storage->bitsPerIndex = 0;
+    storage->paletteCount = 0;
+}
+
+uint8 chunk_storage_get(const ChunkBlockStorage* storage, int index) {
+    if (!storage->data) return storage->palette[0];
+    return storage->palette[read_packed(storage->data, storage->bitsPerIndex, index)];
+}
+
+// Decode every block id in index order, a whole 32-bit word at a time
+void chunk_storage_get_all(const ChunkBlockStorage* storage, uint8* blocks) {
+    if (!storage->data) {
+        memset(blocks, storage->palette[0], CHUNK_VOLUME);
+        return;
+    }
+
+    uint8 bits = storage->bitsPerIndex;
+    uint32 mask = (1u << bits) - 1u;
+    int perWord = 32 / bits;
+    int words = (int)storage_word_count(bits);
+    for (int w = 0; w < words; w++) {
+        uint32 word = storage->data[w];
+        uint8* out = &blocks[w * perWord];
+        for (int i = 0; i < perWord; i++) {
+            out[i] = storage->palette[(word >> (i * bits)) & mask];
+        }
+    }
+}
+
+// Set a block, growing the palette (and the bit width) when a new id appears
+BOOL chunk_storage_set(ChunkBlockStorage* storage, int index, uint8 block) {
+    if (!storage || index < 0 || index >= CHUNK_VOLUME) return FALSE;
+
+    if (!storage->data) {
+        // Uniform chunk: writing the same id is a no-op, anything else promotes it
+        if (storage->palette[0] == block) return TRUE;
+        if (!promote_uniform_storage(storage)) return FALSE;
+    }
+
+    int paletteIndex = find_palette_entry(storage, block);
+    if (paletteIndex < 0) {
+        if (storage->paletteCount >= (1 << storage->bitsPerIndex)) {
+            // Paleta llena: primero intentar recuperar entradas sin uso (repack perezoso)
+            chunk_storage_compact(storage);
+            if (!storage->data) {
+                // Compactada a uniforme (quedaba un solo id): volver a 1 bit como arriba
+                if (storage->palette[0] == block) return TRUE;
+                if (!promote_uniform_storage(storage)) return FALSE;
+            }
+        }
+        if (storage->paletteCount >= (1 << storage->bitsPerIndex)) {
+            if (storage->bitsPerIndex >= CHUNK_STORAGE_MAX_BITS) {
+                printf("ERROR: Paleta de chunk llena (%d entradas)\n", storage->paletteCount);
+                return FALSE;
+            }
+            if (!repack_storage(storage, storage->bitsPerIndex * 2, NULL)) return FALSE;
+        }
+        paletteIndex = storage->paletteCount++;
+        storage->palette[paletteIndex] = block;
+    }
+
+    write_packed(storage->data, storage->bitsPerIndex, index, (uint32)paletteIndex);
+    return TRUE;
+}
+
+// Drop palette entries no voxel references anymore and shrink the bit width.
+// A chunk left with a single block id goes back to uniform storage.
+void chunk_storage_compact(ChunkBlockStorage* storage) {
+    if (!storage || !storage->data) return;
+
+    uint16 counts[CHUNK_PALETTE_MAX] = {0};
+    for (int i = 0; i < CHUNK_VOLUME; i++) {
+        counts[read_packed(storage->data, storage->bitsPerIndex, i)]++;
+    }
+
+    uint8 remap[CHUNK_PALETTE_MAX];
+    uint8 newPalette[CHUNK_PALETTE_MAX];
+    int newCount = 0;
+    for (int i = 0; i < storage->paletteCount; i++) {
+        if (counts[i] > 0) {
+            remap[i] = (uint8)newCount;
+            newPalette[newCount++] = storage->palette[i];
+        }
+    }
+
+    if (newCount == 1) {
+        storage->palette[0] = newPalette[0];
+        storage->paletteCount = 1;
+        storage->bitsPerIndex = 0;
+        safe_free(storage->data);
+        storage->data = NULL;
+        return;
+    }
+
+    uint8 newBits = bits_for_palette(newCount);
+    if (newCount == storage->paletteCount && newBits == storage->bitsPerIndex) {
+        return; // Nothing to reclaim
+    }
+
+    if (!repack_storage(storage, newBits, remap)) return;
+    memcpy(storage->palette, newPalette, newCount);
+    storage->paletteCount = (uint16)newCount;
+}
+
+size_t chunk_storage_memory_usage(const ChunkBlockStorage* storage) {
+    if (!storage) return 0;
+    size_t dataBytes = storage->data ? storage_word_count(storage->bitsPerIndex) * sizeof(uint32) : 0;
+    return sizeof(ChunkBlockStorage) + dataBytes;
+}
+
+// Encoded layout: [bits][paletteCount - 1][palette...][packed words, little endian]
+// Uniform chunks encode as bits = 0 followed by their single block id (3 bytes)
+size_t chunk_storage_encoded_size(const ChunkBlockStorage* storage) {
+    if (!storage || storage->paletteCount == 0) return 0;
+    return 2 + storage->paletteCount + storage_word_count(storage->bitsPerIndex) * 4;
+}
+
+size_t chunk_storage_encode(ChunkBlockStorage* storage, uint8* out, size_t capacity) {
+    if (!storage || storage->paletteCount == 0 || !out) return 0;
+
+    chunk_storage_compact(storage);
+
+    size_t size = chunk_storage_encoded_size(storage);
+    if (size > capacity) return 0;
+
+    size_t pos = 0;
+    out[pos++] = storage->bitsPerIndex;
+    out[pos++] = (uint8)(storage->paletteCount - 1);
+    memcpy(out + pos, storage->palette, storage->paletteCount);
+    pos += storage->paletteCount;
+
+    size_t words = storage_word_count(storage->bitsPerIndex);
+    for (size_t i = 0; i < words; i++) {
+        uint32 w = storage->data[i];
+        out[pos++] = (uint8)(w & 0xFF);
+        out[pos++] = (uint8)((w >> 8) & 0xFF);
+        out[pos++] = (uint8)((w >> 16) & 0xFF);
+        out[pos++] = (uint8)((w >> 24) & 0xFF);
+    }
+
+    return pos;
+}
+
+BOOL chunk_storage_decode(ChunkBlockStorage* storage, const uint8* in, size_t size) {
+    if (!storage || !in || size < 2) return FALSE;
+
+    uint8 bits = in[0];
+    int paletteCount = in[1] + 1;
+    if (bits == 0) {
+        if (paletteCount != 1 || size < 3) return FALSE;
+        uint8 block = in[2];
+        chunk_storage_free(storage);
+        return chunk_storage_init(storage, block);
+    }
+    if (bits > CHUNK_STORAGE_MAX_BITS || (bits & (bits - 1)) != 0 ||
+        paletteCount > (1 << bits)) {
+        printf("ERROR: Datos de chunk corruptos (bits=%d, paleta=%d)\n", bits, paletteCount);
+        return FALSE;
+    }
+
+    size_t words = storage_word_count(bits);
+    if (size < 2 + (size_t)paletteCount + words * 4) return FALSE;
+
+    uint32* data = (uint32*)safe_malloc(words * sizeof(uint32));
+    if (!data) return FALSE;
+
+    size_t pos = 2 + paletteCount;
+    for (size_t i = 0; i < words; i++) {
+        data[i] = (uint32)in[pos] | ((uint32)in[pos + 1] << 8) |
+                  ((uint32)in[pos + 2] << 16) | ((uint32)in[pos + 3] << 24);
+        pos += 4;
+    }
+
+    chunk_storage_free(storage);
+    storage->bitsPerIndex = bits;
+    storage->paletteCount = (uint16)paletteCount;
+    memcpy(storage->palette, in + 2, paletteCount);
+    storage->data = data;
+    return TRUE;
+}
+
+// ============================================================================
+// VERIFY - ida y vuelta de la paleta frente a un array plano
+// ============================================================================
+
+// Palette growth, get/get_all/encode/decode against a flat copy, and collapse back to uniform
+BOOL verify_chunk_storage(void) {
+    static uint8 expected[CHUNK_VOLUME];
+    static uint8 decoded[CHUNK_VOLUME];
+    static uint8 encoded[2 + 256 + CHUNK_VOLUME];
+    ChunkBlockStorage storage, copy;
+    if (!chunk_storage_init(&storage, VOXEL_AIR)) return FALSE;
+    if (!chunk_storage_init(&copy, VOXEL_AIR)) {
+        chunk_storage_free(&storage);
+        return FALSE;
+    }
+
+    // Palette full with an unused entry: compacting collapses it to uniform before the new id
+    ChunkBlockStorage collapse;
+    BOOL collapseOk = chunk_storage_init(&collapse, VOXEL_AIR) &&
+                      chunk_storage_set(&collapse, 5, VOXEL_STONE) &&
+                      chunk_storage_set(&collapse, 5, VOXEL_AIR) &&
+                      chunk_storage_set(&collapse, 7, VOXEL_WOOD);
+    collapseOk = collapseOk && chunk_storage_get(&collapse, 5) == VOXEL_AIR &&
+                 chunk_storage_get(&collapse, 7) == VOXEL_WOOD && chunk_storage_get(&collapse, 0) == VOXEL_AIR;
+    printf("   - Paleta llena que se compacta a uniforme: %s\n", collapseOk ? "OK" : "FALLO");
+    chunk_storage_free(&collapse);
+
+    // Random edits with a growing set of ids: la paleta pasa por 1, 2 y 4 bits
+    memset(expected, VOXEL_AIR, sizeof(expected));
+    uint32 seed = 4242u;
+    int mismatches = 0, typeLimits[3] = {2, 4, 16};
+    uint8 widths[3] = {0, 0, 0};
+    for (int stage = 0; stage < 3; stage++) {
+        for (int i = 0; i < 4 * CHUNK_VOLUME; i++) {
+            seed = seed * 1664525u + 1013904223u;
+            int index = (seed >> 8) & (CHUNK_VOLUME - 1);
+            uint8 block = (uint8)((seed >> 24) % typeLimits[stage]);
+            if (!chunk_storage_set(&storage, index, block)) mismatches++;
+            expected[index] = block;
+        }
+        widths[stage] = storage.bitsPerIndex;
+        for (int i = 0; i < CHUNK_VOLUME; i++) mismatches += chunk_storage_get(&storage, i) != expected[i];
+    }
+    chunk_storage_get_all(&storage, decoded);
+    mismatches += memcmp(decoded, expected, CHUNK_VOLUME) != 0;
+    printf("   - Ediciones aleatorias (paleta de %d/%d/%d bits): %d diferencias %s\n",
+           widths[0], widths[1], widths[2], mismatches, mismatches == 0 ? "OK" : "FALLO");
+
+    // Encode/decode round trip
+    size_t size = chunk_storage_encode(&storage, encoded, sizeof(encoded));
+    BOOL roundTripOk = size > 0 && chunk_storage_decode(&copy, encoded, size);
+    if (roundTripOk) {
+        chunk_storage_get_all(&copy, decoded);
+        roundTripOk = memcmp(decoded, expected, CHUNK_VOLUME) == 0;
+    }
+    printf("   - Codificar y decodificar: %zu bytes %s\n", size, roundTripOk ? "OK" : "FALLO");
+
+    // Back to one block type: compacting leaves a uniform chunk that encodes in 3 bytes
+    for (int i = 0; i < CHUNK_VOLUME; i++) chunk_storage_set(&storage, i, VOXEL_STONE);
+    chunk_storage_compact(&storage);
+    BOOL uniformOk = storage.bitsPerIndex == 0 && storage.paletteCount == 1 &&
+                     chunk_storage_encoded_size(&storage) == 3 && chunk_storage_get(&storage, 123) == VOXEL_STONE;
+    printf("   - Chunk reescrito con un solo tipo vuelve a uniforme: %s\n", uniformOk ? "OK" : "FALLO");
+
+    chunk_storage_free(&copy);
+    chunk_storage_free(&storage);
+    return collapseOk && mismatches == 0 && roundTripOk && uniformOk;
+}
+
+// ============================================================================
+// BENCHMARK - paleta empaquetada vs arrays blocks[x][y][z]
+// ============================================================================
+
+static double benchmark_seconds(LARGE_INTEGER start, LARGE_INTEGER end, LARGE_INTEGER freq) {
+    return (double)(end.QuadPart - start.QuadPart) / (double)freq.QuadPart;
+}
+
+void benchmark_chunk_storage(int iterations) {
+    static VoxelBlock legacyBlocks[16][16][16];  // Layout original (~40 bytes por voxel)
+    static uint8 flatBlocks[16][16][16];         // 1 byte por voxel
+    ChunkBlockStorage storage;
+    LARGE_INTEGER freq, start, end;
+    volatile uint32 sink = 0;
+
+    if (iterations <= 0) iterations = 1000000;
+    if (!chunk_storage_init(&storage, VOXEL_AIR)) return;
+    QueryPerformanceFrequency(&freq);
+
+    // Uniform all-air chunk: the state every chunk starts in
+    printf("   - Chunk uniforme: %zu bytes (codificado: %zu)\n",
+           chunk_storage_memory_usage(&storage), chunk_storage_encoded_size(&storage));
+
+    // Typical terrain content: air, grass, wood and leaves
+    const uint8 types[4] = {VOXEL_AIR, VOXEL_GRASS, VOXEL_WOOD, VOXEL_LEAVES};
+
+    // SET
+    uint32 seed = 12345;
+    QueryPerformanceCounter(&start);
+    for (int i = 0; i < iterations; i++) {
+        seed = seed * 1664525u + 1013904223u;
+        int index = (seed >> 8) & (CHUNK_VOLUME - 1);
+        legacyBlocks[index >> 8][(index >> 4) & 15][index & 15].type = (VoxelType)types[seed >> 30];
+    }
+    QueryPerformanceCounter(&end);
+    double legacySet = benchmark_seconds(start, end, freq);
+
+    seed = 12345;
+    QueryPerformanceCounter(&start);
+    for (int i = 0; i < iterations; i++) {
+        seed = seed * 1664525u + 1013904223u;
+        int index = (seed >> 8) & (CHUNK_VOLUME - 1);
+        flatBlocks[index >> 8][(index >> 4) & 15][index & 15] = types[seed >> 30];
+    }
+    QueryPerformanceCounter(&end);
+    double flatSet = benchmark_seconds(start, end, freq);
+
+    seed = 12345;
+    QueryPerformanceCounter(&start);
+    for (int i = 0; i < iterations; i++) {
+        seed = seed * 1664525u + 1013904223u;
+        int index = (seed >> 8) & (CHUNK_VOLUME - 1);
+        chunk_storage_set(&storage, index, types[seed >> 30]);
+    }
+    QueryPerformanceCounter(&end);
+    double paletteSet = benchmark_seconds(start, end, freq);
+
+    // GET (sequential sweep, like the per-block loops)
+    int sweeps = iterations / CHUNK_VOLUME + 1;
+    QueryPerformanceCounter(&start);
+    for (int s = 0; s < sweeps; s++) {
+        for (int x = 0; x < 16; x++)
+            for (int y = 0; y < 16; y++)
+                for (int z = 0; z < 16; z++)
+                    sink += legacyBlocks[x][y][z].type;
+    }
+    QueryPerformanceCounter(&end);
+    double legacyGet = benchmark_seconds(start, end, freq);
+
+    QueryPerformanceCounter(&start);
+    for (int s = 0; s < sweeps; s++) {
+        for (int x = 0; x < 16; x++)
+            for (int y = 0; y < 16; y++)
+                for (int z = 0; z < 16; z++)
+                    sink += flatBlocks[x][y][z];
+    }
+    QueryPerformanceCounter(&end);
+    double flatGet = benchmark_seconds(start, end, freq);
+
+    QueryPerformanceCounter(&start);
+    for (int s = 0; s < sweeps; s++) {
+        for (int x = 0; x < 16; x++)
+            for (int y = 0; y < 16; y++)
+                for (int z = 0; z < 16; z++)
+                    sink += chunk_storage_get(&storage, chunk_block_index(x, y, z));
+    }
+    QueryPerformanceCounter(&end);
+    double paletteGet = benchmark_seconds(start, end, freq);
+
+    double gets = (double)sweeps * CHUNK_VOLUME;
+    printf("   - SET VoxelBlock[16][16][16]: %.1f Mops/s\n", iterations / legacySet / 1e6);
+    printf("   - SET uint8[16][16][16]:      %.1f Mops/s\n", iterations / flatSet / 1e6);
+    printf("   - SET paleta %d bits:          %.1f Mops/s\n", storage.bitsPerIndex, iterations / paletteSet / 1e6);
+    printf("   - GET VoxelBlock[16][16][16]: %.1f Mops/s\n", gets / legacyGet / 1e6);
+    printf("   - GET uint8[16][16][16]:      %.1f Mops/s\n", gets / flatGet / 1e6);
+    printf("   - GET paleta %d bits:          %.1f Mops/s\n", storage.bitsPerIndex, gets / paletteGet / 1e6);
+    printf("   - Memoria: VoxelBlock=%zu bytes, uint8=%zu bytes, paleta=%zu bytes (codificado: %zu)\n",
+           sizeof(legacyBlocks), sizeof(flatBlocks), chunk_storage_memory_usage(&storage),
+           chunk_storage_encoded_size(&storage));
+    printf("   - Checksum de lecturas: %u\n", (unsigned)sink);
+
+    chunk_storage_free(&storage);
+}
+
+// ============================================================================
+// BENCHMARK - layout lineal vs Morton (orden Z)
+// ============================================================================
+
+typedef struct {
+    const char* name;
+    int (*indexOf)(int x, int y, int z);
+    int mask[3];  // Bits de x, y, z dentro del índice
+} ChunkLayoutDesc;
+
+// Distinct 64-byte lines touched by the neighbourhood of (x, y, z) in a
+// 1-byte-per-voxel array (faces only: 7 voxels, full: 27 voxels)
+static int count_stencil_lines(const ChunkLayoutDesc* layout, int x, int y, int z, BOOL full) {
+    int lines[27];
+    int count = 0;
+    for (int dx = -1; dx <= 1; dx++) {
+        for (int dy = -1; dy <= 1; dy++) {
+            for (int dz = -1; dz <= 1; dz++) {
+                if (!full && abs(dx) + abs(dy) + abs(dz) > 1) continue;
+                int nx = x + dx, ny = y + dy, nz = z + dz;
+                if (nx < 0 || nx >= CHUNK_SIZE || ny < 0 || ny >= CHUNK_SIZE || nz < 0 || nz >= CHUNK_SIZE) continue;
+                int line = layout->indexOf(nx, ny, nz) >> 6;
+                int seen = 0;
+                for (int i = 0; i < count && !seen; i++) seen = lines[i] == line;
+                if (!seen) lines[count++] = line;
+            }
+        }
+    }
+    return count;
+}
+
+// Exposed faces of every solid voxel, walking the array in memory order
+static uint32 sweep_faces(const ChunkLayoutDesc* layout, const uint8* blocks) {
+    uint32 faces = 0;
+    for (int i = 0; i < CHUNK_VOLUME; i++) {
+        if (!blocks[i]) continue;
+        for (int face = 0; face < CHUNK_FACE_COUNT; face++) {
+            int mask = layout->mask[face >> 1];
+            BOOL negative = face & 1;
+            BOOL border = (i & mask) == (negative ? 0 : mask);
+            faces += border || !blocks[chunk_index_step(i, mask, negative)];
+        }
+    }
+    return faces;
+}
+
+// Solid voxels in the 3x3x3 neighbourhood of every voxel (AO / luz / ediciones)
+static uint32 sweep_neighborhood(const ChunkLayoutDesc* layout, const uint8* blocks) {
+    uint32 total = 0;
+    for (int i = 0; i < CHUNK_VOLUME; i++) {
+        for (int dx = -1; dx <= 1; dx++) {
+            int ix = i;
+            if (dx) {
+                if ((i & layout->mask[0]) == (dx < 0 ? 0 : layout->mask[0])) continue;
+                ix = chunk_index_step(i, layout->mask[0], dx < 0);
+            }
+            for (int dy = -1; dy <= 1; dy++) {
+                int iy = ix;
+                if (dy) {
+                    if ((ix & layout->mask[1]) == (dy < 0 ? 0 : layout->mask[1])) continue;
+                    iy = chunk_index_step(ix, layout->mask[1], dy < 0);
+                }
+                for (int dz = -1; dz <= 1; dz++) {
+                    int iz = iy;
+                    if (dz) {
+                        if ((iy & layout->mask[2]) == (dz < 0 ? 0 : layout->mask[2])) continue;
+                        iz = chunk_index_step(iy, layout->mask[2], dz < 0);
+                    }
+                    total += blocks[iz] != 0;
+                }
+            }
+        }
+    }
+    return total;
+}
+
+void benchmark_chunk_layout(int sweeps) {
+    static uint8 blocks[2][CHUNK_VOLUME];
+    const ChunkLayoutDesc layouts[2] = {
+        {"lineal", chunk_linear_index, {0xF00, 0x0F0, 0x00F}},
+        {"Morton", chunk_morton_index, {0x924, 0x492, 0x249}}
+    };
+    LARGE_INTEGER freq, start, end;
+    uint32 faces[2] = {0, 0}, neighbors[2] = {0, 0};
+
+    if (sweeps <= 0) sweeps = 200;
+    QueryPerformanceFrequency(&freq);
+
+    // Same terrain-like content in both layouts: ground columns of random height plus noise
+    uint32 seed = 12345;
+    for (int x = 0; x < CHUNK_SIZE; x++) {
+        for (int y = 0; y < CHUNK_SIZE; y++) {
+            seed = seed * 1664525u + 1013904223u;
+            int height = 4 + (int)((seed >> 16) % 8);
+            for (int z = 0; z < CHUNK_SIZE; z++) {
+                seed = seed * 1664525u + 1013904223u;
+                uint8 solid = z < height ? ((seed >> 24) < 240) : ((seed >> 24) < 8);
+                blocks[0][chunk_linear_index(x, y, z)] = solid;
+                blocks[1][chunk_morton_index(x, y, z)] = solid;
+            }
+        }
+    }
+
+    printf("   - Layout compilado: %s\n", CHUNK_LAYOUT == CHUNK_LAYOUT_MORTON_ORDER ? "Morton" : "lineal");
+    for (int l = 0; l < 2; l++) {
+        // Cache footprint per sample (proxy de fallos de caché, sin contadores de hardware)
+        int faceLines = 0, fullLines = 0;
+        for (int x = 0; x < CHUNK_SIZE; x++)
+            for (int y = 0; y < CHUNK_SIZE; y++)
+                for (int z = 0; z < CHUNK_SIZE; z++) {
+                    faceLines += count_stencil_lines(&layouts[l], x, y, z, FALSE);
+                    fullLines += count_stencil_lines(&layouts[l], x, y, z, TRUE);
+                }
+
+        QueryPerformanceCounter(&start);
+        for (int s = 0; s < sweeps; s++) faces[l] += sweep_faces(&layouts[l], blocks[l]);
+        QueryPerformanceCounter(&end);
+        double faceTime = benchmark_seconds(start, end, freq);
+
+        QueryPerformanceCounter(&start);
+        for (int s = 0; s < sweeps; s++) neighbors[l] += sweep_neighborhood(&layouts[l], blocks[l]);
+        QueryPerformanceCounter(&end);
+        double neighborTime = benchmark_seconds(start, end, freq);
+
+        double voxels = (double)sweeps * CHUNK_VOLUME;
+        printf("   - %s: líneas de caché por muestra %.2f (caras) / %.2f (3x3x3), caras %.1f Mvox/s, 3x3x3 %.1f Mvox/s\n",
+               layouts[l].name, faceLines / (double)CHUNK_VOLUME, fullLines / (double)CHUNK_VOLUME,
+               voxels / faceTime / 1e6, voxels / neighborTime / 1e6);
+    }
+
+    printf("   - Verificación: %s (caras %u/%u, vecinos %u/%u)\n",
+           faces[0] == faces[1] && neighbors[0] == neighbors[1] ? "OK" : "FALLO",
+           (unsigned)faces[0], (unsigned)faces[1], (unsigned)neighbors[0], (unsigned)neighbors[1]);
+}
@@ -1,4 +1,5 @@
 #include "world/chunk_system.h"
+#include "world/chunk_culling.h"
 #include "core/math3d.h"
 #include <stdio.h>
 #include <stdlib.h>
@@ -8,6 +9,12 @@
 // Global block blueprints
 static BlockBlueprint* g_block_blueprints = NULL;
 
+// Occupancy flags per block id, derived from the blueprints (see set_block_type)
+#define BLOCK_FLAG_SOLID  0x01
+#define BLOCK_FLAG_OPAQUE 0x02
+static uint8 g_block_flags[CHUNK_PALETTE_MAX];
+static BOOL g_block_flags_ready = FALSE;
+
 // Block blueprint system
 BlockBlueprint* create_block_blueprints() {
     if (g_block_blueprints) {
@@ -219,6 +226,7 @@ void destroy_block_blueprints(BlockBlueprint* blueprints) {
     if (blueprints) {
         safe_free(blueprints);
         g_block_blueprints = NULL;
+        g_block_flags_ready = FALSE;
         printf("Block blueprints destruidos\n");
     }
 }
@@ -245,6 +253,192 @@ void initialize_block_from_blueprint(VoxelBlock* block, BlockBlueprint* blueprin
     block->hasBackFace = block->isVisible;
 }
 
+// Build the solid/opaque flag table from the 16 blueprints
+static void init_block_flags(void) {
+    BlockBlueprint* blueprints = create_block_blueprints();
+    if (!blueprints) return;
+    
+    memset(g_block_flags, 0, sizeof(g_block_flags));
+    for (int type = VOXEL_GRASS; type <= VOXEL_CONCRETE; type++) {
+        if (blueprints[type].isSolid) g_block_flags[type] |= BLOCK_FLAG_SOLID;
+        if (!blueprints[type].isTransparent) g_block_flags[type] |= BLOCK_FLAG_OPAQUE;
+    }
+    g_block_flags_ready = TRUE;
+}
+
+static inline uint8 get_block_flags(uint8 type) {
+    if (!g_block_flags_ready) init_block_flags();
+    return g_block_flags[type];
+}
+
+BOOL is_voxel_solid(VoxelType type) {
+    return (get_block_flags((uint8)type) & BLOCK_FLAG_SOLID) != 0;
+}
+
+BOOL is_voxel_opaque(VoxelType type) {
+    return (get_block_flags((uint8)type) & BLOCK_FLAG_OPAQUE) != 0;
+}
+
+// ============================================================================
+// CHUNK HASH TABLE - (chunkX, chunkY, chunkZ) -> slot en chunks[]
+// ============================================================================
+
+// Pack chunk coordinates into one key (21 bits per axis, two's complement)
+static inline uint64 pack_chunk_key(int chunkX, int chunkY, int chunkZ) {
+    return ((uint64)(chunkX & 0x1FFFFF) << 42) |
+           ((uint64)(chunkY & 0x1FFFFF) << 21) |
+           (uint64)(chunkZ & 0x1FFFFF);
+}
+
+static inline int hash_chunk_key(uint64 key, int mask) {
+    key *= 0x9E3779B97F4A7C15ULL; // Fibonacci hashing
+    return (int)(key >> 32) & mask;
+}
+
+// Entry index holding key, or -1
+static int chunk_table_find(ChunkManager* manager, uint64 key) {
+    int index = hash_chunk_key(key, manager->chunkTableMask);
+    while (manager->chunkTable[index].slot >= 0) {
+        if (manager->chunkTable[index].key == key) return index;
+        index = (index + 1) & manager->chunkTableMask;
+    }
+    return -1;
+}
+
+static void chunk_table_insert(ChunkManager* manager, uint64 key, int slot) {
+    int index = hash_chunk_key(key, manager->chunkTableMask);
+    while (manager->chunkTable[index].slot >= 0) {
+        index = (index + 1) & manager->chunkTableMask;
+    }
+    manager->chunkTable[index].key = key;
+    manager->chunkTable[index].slot = slot;
+}
+
+// Remove by backward shift so probe chains never need tombstones
+static void chunk_table_remove(ChunkManager* manager, uint64 key) {
+    int hole = chunk_table_find(manager, key);
+    if (hole < 0) return;
+    
+    int mask = manager->chunkTableMask;
+    int index = (hole + 1) & mask;
+    while (manager->chunkTable[index].slot >= 0) {
+        int home = hash_chunk_key(manager->chunkTable[index].key, mask);
+        // Move the entry back if the hole lies between its home bucket and its position
+        if (((index - home) & mask) >= ((index - hole) & mask)) {
+            manager->chunkTable[hole] = manager->chunkTable[index];
+            hole = index;
+        }
+        index = (index + 1) & mask;
+    }
+    manager->chunkTable[hole].slot = -1;
+}
+
+// O(1) lookup of a loaded chunk, NULL if it is not loaded (counts as an access for LRU)
+VoxelChunk* find_chunk(ChunkManager* manager, int chunkX, int chunkY, int chunkZ) {
+    if (!manager) return NULL;
+    
+    int index = chunk_table_find(manager, pack_chunk_key(chunkX, chunkY, chunkZ));
+    if (index < 0) return NULL;
+    
+    VoxelChunk* chunk = manager->chunks[manager->chunkTable[index].slot];
+    chunk->lastAccessFrame = manager->currentFrame;
+    return chunk;
+}
+
+// Link a freshly inserted chunk with its loaded neighbours (both directions)
+static void link_chunk_neighbors(ChunkManager* manager, VoxelChunk* chunk) {
+    for (int dx = -1; dx <= 1; dx++) {
+        for (int dy = -1; dy <= 1; dy++) {
+            for (int dz = -1; dz <= 1; dz++) {
+                int index = chunk_neighbor_index(dx, dy, dz);
+                if (index == CHUNK_NEIGHBOR_SELF) {
+                    chunk->neighbors[index] = chunk;
+                    continue;
+                }
+                
+                // Direct table probe: linking is not an access for the LRU
+                int entry = chunk_table_find(manager, pack_chunk_key(chunk->chunkX + dx, chunk->chunkY + dy, chunk->chunkZ + dz));
+                VoxelChunk* neighbor = entry >= 0 ? manager->chunks[manager->chunkTable[entry].slot] : NULL;
+                chunk->neighbors[index] = neighbor;
+                if (neighbor) {
+                    neighbor->neighbors[chunk_neighbor_index(-dx, -dy, -dz)] = chunk;
+                    neighbor->needsRemesh = TRUE; // Its border faces may now be hidden
+                }
+            }
+        }
+    }
+}
+
+// New block content: the chunk and all linked neighbours need new meshes
+static void mark_neighborhood_remesh(VoxelChunk* chunk) {
+    chunk->needsRemesh = TRUE;
+    for (int i = 0; i < CHUNK_NEIGHBOR_COUNT; i++) {
+        if (chunk->neighbors[i]) {
+            chunk->neighbors[i]->needsRemesh = TRUE;
+        }
+    }
+}
+
+static void unlink_chunk_neighbors(VoxelChunk* chunk) {
+    for (int dx = -1; dx <= 1; dx++) {
+        for (int dy = -1; dy <= 1; dy++) {
+            for (int dz = -1; dz <= 1; dz++) {
+                int index = chunk_neighbor_index(dx, dy, dz);
+                VoxelChunk* neighbor = chunk->neighbors[index];
+                if (neighbor && index != CHUNK_NEIGHBOR_SELF) {
+                    neighbor->neighbors[chunk_neighbor_index(-dx, -dy, -dz)] = NULL;
+                    neighbor->needsRemesh = TRUE; // Its border faces are exposed again
+                }
+                chunk->neighbors[index] = NULL;
+            }
+        }
+    }
+}
+
+// Drop a chunk that is being unloaded (sus vecinos ya se marcan al desenlazarlo)
+static void remove_from_remesh_queue(ChunkManager* manager, VoxelChunk* chunk) {
+    if (!chunk->hasDirtyRegion || !manager->remeshQueue) return;
+    
+    for (int i = 0; i < manager->remeshQueueCount; i++) {
+        if (manager->remeshQueue[i] == chunk) {
+            manager->remeshQueue[i] = manager->remeshQueue[--manager->remeshQueueCount];
+            break;
+        }
+    }
+    chunk->hasDirtyRegion = FALSE;
+}
+
+// Release a chunk slot: frees the block storage and clears the slot
+static void release_chunk_slot(ChunkManager* manager, int slot) {
+    VoxelChunk* chunk = manager->chunks[slot];
+    if (!chunk) return;
+    
+    remove_from_remesh_queue(manager, chunk);
+    unlink_chunk_neighbors(chunk);
+    chunk_table_remove(manager, pack_chunk_key(chunk->chunkX, chunk->chunkY, chunk->chunkZ));
+    if (manager->releaseChunkMesh) {
+        manager->releaseChunkMesh(chunk);
+    }
+    chunk_storage_free(&chunk->storage);
+    pool_free(manager->chunkPool, chunk);
+    manager->chunks[slot] = NULL;
+    if (manager->loadedChunks > 0) {
+        manager->loadedChunks--;
+    }
+}
+
+// Unload a chunk slot, writing the chunk out first if the player modified it
+static void unload_chunk_slot(ChunkManager* manager, int slot) {
+    VoxelChunk* chunk = manager->chunks[slot];
+    if (!chunk) return;
+    
+    if (chunk->isDirty && chunk->isGenerated &&
+        save_chunk_to_disk(chunk, manager->evictionPolicy.saveDirectory)) {
+        manager->savedChunks++;
+    }
+    release_chunk_slot(manager, slot);
+}
+
 // Create chunk manager with memory pool
 ChunkManager* create_chunk_manager(int maxChunks, int renderDistance) {
     ChunkManager* manager = (ChunkManager*)safe_malloc(sizeof(ChunkManager));
@@ -256,10 +450,35 @@ ChunkManager* create_chunk_manager(int maxChunks, int renderDistance) {
         return NULL;
     }
     
-    // Create memory pool for chunks - OPTIMIZADO PARA 3x3 CENTRADO
-    size_t pool_size = maxChunks * sizeof(VoxelChunk) * 3; // Triple tamaño para seguridad
+    // Hash table at most half full so probe chains stay short
+    int tableSize = 16;
+    while (tableSize < maxChunks * 2) tableSize *= 2;
+    manager->chunkTable = (ChunkHashEntry*)safe_malloc(tableSize * sizeof(ChunkHashEntry));
+    if (!manager->chunkTable) {
+        safe_free(manager->chunks);
+        safe_free(manager);
+        return NULL;
+    }
+    for (int i = 0; i < tableSize; i++) {
+        manager->chunkTable[i].slot = -1;
+    }
+    manager->chunkTableMask = tableSize - 1;
+    
+    // Remesh queue: cada chunk entra como mucho una vez, basta con maxChunks entradas
+    manager->remeshQueue = (VoxelChunk**)safe_malloc(maxChunks * sizeof(VoxelChunk*));
+    if (!manager->remeshQueue) {
+        safe_free(manager->chunkTable);
+        safe_free(manager->chunks);
+        safe_free(manager);
+        return NULL;
+    }
+    
+    // Create memory pool for chunks - un bloque por slot, los chunks descargados vuelven a la free list
+    size_t pool_size = maxChunks * sizeof(VoxelChunk);
     manager->chunkPool = create_memory_pool(pool_size, sizeof(VoxelChunk));
     if (!manager->chunkPool) {
+        safe_free(manager->remeshQueue);
+        safe_free(manager->chunkTable);
         safe_free(manager->chunks);
         safe_free(manager);
         return NULL;
@@ -268,8 +487,20 @@ ChunkManager* create_chunk_manager(int maxChunks, int renderDistance) {
     manager->maxChunks = maxChunks;
     manager->loadedChunks = 0;
     manager->renderDistance = renderDistance;
+    manager->minChunkZ = CHUNK_DEFAULT_MIN_Z;
+    manager->maxChunkZ = CHUNK_DEFAULT_MAX_Z;
+    manager->verticalDistance = CHUNK_DEFAULT_VERTICAL_DISTANCE;
     manager->chunkSize = 16;
     manager->blockSize = 1.0f;
+    manager->evictionPolicy = default_chunk_eviction_policy();
+    manager->currentFrame = 0;
+    manager->focusPosition = (Vect3){0.0f, 0.0f, 0.0f};
+    manager->evictedChunks = 0;
+    manager->savedChunks = 0;
+    manager->releaseChunkMesh = NULL;
+    manager->defaultMeshMode = CHUNK_MESH_BINARY;
+    manager->remeshQueueCount = 0;
+    manager->queuedEdits = 0;
     
     printf("ChunkManager creado: %d chunks máximos, distancia de render: %d\n", maxChunks, renderDistance);
     
@@ -282,11 +513,10 @@ void destroy_chunk_manager(ChunkManager* manager) {
     
     printf("Destruyendo ChunkManager...\n");
     
-    // Free all chunks
+    // Free all chunks (modified ones are written to disk first)
     for (int i = 0; i < manager->maxChunks; i++) {
         if (manager->chunks[i]) {
-            // Chunks are allocated from pool, so no individual free needed
-            manager->chunks[i] = NULL;
+            unload_chunk_slot(manager, i);
         }
     }
     
@@ -295,6 +525,8 @@ void destroy_chunk_manager(ChunkManager* manager) {
         destroy_memory_pool(manager->chunkPool);
     }
     
+    safe_free(manager->remeshQueue);
+    safe_free(manager->chunkTable);
     safe_free(manager->chunks);
     safe_free(manager);
     
@@ -306,39 +538,16 @@ VoxelChunk* get_or_create_chunk(ChunkManager* manager, int chunkX, int chunkY, i
     if (!manager) return NULL;
     
     // Find existing chunk
-    for (int i = 0; i < manager->maxChunks; i++) {
-        if (manager->chunks[i] && 
-            manager->chunks[i]->chunkX == chunkX &&
-            manager->chunks[i]->chunkY == chunkY &&
-            manager->chunks[i]->chunkZ == chunkZ) {
-            return manager->chunks[i];
-        }
+    VoxelChunk* existing = find_chunk(manager, chunkX, chunkY, chunkZ);
+    if (existing) {
+        return existing;
     }
     
-    // Check if we can create a new chunk - OPTIMIZADO
+    // Check if we can create a new chunk - la política elige a quién expulsar
     if (manager->loadedChunks >= manager->maxChunks) {
-        // Try to unload distant chunks first
-        printf("Límite de chunks alcanzado (%d/%d). Liberando chunks distantes...\n", 
+        printf("Límite de chunks alcanzado (%d/%d). Aplicando política de expulsión...\n",
                manager->loadedChunks, manager->maxChunks);
-        
-        // Force unload oldest chunks to make space (FIFO)
-        int chunksToUnload = manager->loadedChunks - (manager->maxChunks / 2); // Liberar la mitad
-        for (int i = 0; i < manager->maxChunks && chunksToUnload > 0; i++) {
-            if (manager->chunks[i]) {
-                printf("Liberando chunk (%d, %d, %d) para espacio\n", 
-                       manager->chunks[i]->chunkX, manager->chunks[i]->chunkY, manager->chunks[i]->chunkZ);
-                manager->chunks[i] = NULL;
-                manager->loadedChunks--;
-                chunksToUnload--;
-            }
-        }
-        
-        // Reset pool if still no space
-        if (manager->loadedChunks >= manager->maxChunks) {
-            printf("Reset completo del pool de memoria...\n");
-            pool_reset(manager->chunkPool);
-            manager->loadedChunks = 0;
-        }
+        evict_chunk(manager, TRUE);
     }
     
     // Allocate chunk from memory pool
@@ -355,31 +564,46 @@ VoxelChunk* get_or_create_chunk(ChunkManager* manager, int chunkX, int chunkY, i
     chunk->chunkZ = chunkZ;
     chunk->isGenerated = FALSE;
     chunk->isVisible = TRUE;
+    chunk->faceConnectivity = CHUNK_CONNECTIVITY_ALL;  // Hasta el primer mesh
+    chunk->lastAccessFrame = manager->currentFrame;
     chunk->distanceToCamera = 0.0f;
+    chunk->meshMode = (uint8)manager->defaultMeshMode;
     
-    // Initialize all blocks as air using blueprints
-    BlockBlueprint* blueprints = create_block_blueprints();
-    if (blueprints) {
-        BlockBlueprint* airBlueprint = get_block_blueprint(blueprints, VOXEL_AIR);
-        for (int x = 0; x < 16; x++) {
-            for (int y = 0; y < 16; y++) {
-                for (int z = 0; z < 16; z++) {
-                    initialize_block_from_blueprint(&chunk->blocks[x][y][z], airBlueprint);
-                }
-            }
-        }
+    // Initialize all blocks as air (almacenamiento uniforme, sin datos)
+    if (!chunk_storage_init(&chunk->storage, VOXEL_AIR)) {
+        printf("ERROR: No se pudo asignar almacenamiento de bloques para el chunk\n");
+        pool_free(manager->chunkPool, chunk);
+        return NULL;
     }
     
     // Add to manager
+    int slot = -1;
     for (int i = 0; i < manager->maxChunks; i++) {
         if (!manager->chunks[i]) {
-            manager->chunks[i] = chunk;
-            manager->loadedChunks++;
-            printf("Chunk creado: (%d, %d, %d) - Total: %d/%d\n", 
-                   chunkX, chunkY, chunkZ, manager->loadedChunks, manager->maxChunks);
+            slot = i;
             break;
         }
     }
+    if (slot < 0) {
+        // Sin slot libre (no quedaba nada expulsable): un chunk fuera de la tabla no se encontraría
+        printf("ERROR: Sin slot libre para el chunk (%d, %d, %d)\n", chunkX, chunkY, chunkZ);
+        chunk_storage_free(&chunk->storage);
+        pool_free(manager->chunkPool, chunk);
+        return NULL;
+    }
+    manager->chunks[slot] = chunk;
+    chunk_table_insert(manager, pack_chunk_key(chunkX, chunkY, chunkZ), slot);
+    link_chunk_neighbors(manager, chunk);
+    manager->loadedChunks++;
+    printf("Chunk creado: (%d, %d, %d) - Total: %d/%d\n", 
+           chunkX, chunkY, chunkZ, manager->loadedChunks, manager->maxChunks);
+    
+    // Chunks modified before being evicted come back from disk instead of being regenerated
+    if (load_chunk_from_disk(chunk, manager->evictionPolicy.saveDirectory)) {
+        chunk->isGenerated = TRUE;
+        mark_neighborhood_remesh(chunk);
+        printf("Chunk (%d, %d, %d) restaurado desde disco\n", chunkX, chunkY, chunkZ);
+    }
     
     return chunk;
 }
@@ -506,8 +730,8 @@ VoxelType get_terrain_block_type(int x, int y, int z, int height) {
     (void)y; // Suppress unused parameter warning
     (void)height; // Suppress unused parameter warning
     
-    // Solo la capa del suelo (z=0) es pasto, todo lo demás es aire
-    if (z == 0) {
+    // Solo la capa del suelo es pasto, todo lo demás es aire
+    if (z == TERRAIN_GROUND_LEVEL) {
         return VOXEL_GRASS;
     }
     return VOXEL_AIR; // Todo lo demás es aire
@@ -530,39 +754,32 @@ void generate_chunk_terrain(VoxelChunk* chunk, TerrainGenerator* generator) {
     printf("Generando terreno para chunk (%d, %d, %d) usando matriz procedural\n", 
            chunk->chunkX, chunk->chunkY, chunk->chunkZ);
     
-    // Get block blueprints
-    BlockBlueprint* blueprints = create_block_blueprints();
-    if (!blueprints) return;
+    // Color variation is computed on demand from this seed (see get_block_color)
+    chunk->colorSeed = generator->seed;
+    
+    // Sections that do not cross the ground level stay uniform air (no per-voxel
+    // writes, no packed storage at all). Bajo el suelo también: el mundo es solo la
+    // capa de césped, y rellenarlo de tierra duplicaba los chunks a mallar. Los vecinos
+    // no se remallan: para ellos un chunk de aire es igual que uno sin cargar
+    int sectionBottom = chunk->chunkZ * 16;
+    if (sectionBottom > TERRAIN_GROUND_LEVEL || sectionBottom + 15 < TERRAIN_GROUND_LEVEL) {
+        chunk->isGenerated = TRUE;
+        return;
+    }
     
-    // Generate only the ground layer (z = 0) for grass floor - DONDE PISA EL JUGADOR
+    // Generate only the ground layer for grass floor - DONDE PISA EL JUGADOR
+    // Las demás capas ya son aire desde get_or_create_chunk
+    int groundZ = TERRAIN_GROUND_LEVEL - sectionBottom;
     for (int x = 0; x < 16; x++) {
         for (int y = 0; y < 16; y++) {
             int worldX = worldChunkX + x;
             int worldY = worldChunkY + y;
             
-            // Generate only the ground layer (z = 0) - DONDE PISA EL JUGADOR
-            int z = 0;
-            int worldZ = chunk->chunkZ * 16 + z;
+            // Generate only the ground layer - DONDE PISA EL JUGADOR
+            int z = groundZ;
+            int worldZ = sectionBottom + z;
             VoxelType blockType = get_terrain_block_type(worldX, worldY, worldZ, 0);
-            
-            // Initialize block from blueprint
-            BlockBlueprint* blueprint = get_block_blueprint(blueprints, blockType);
-            if (blueprint) {
-                initialize_block_from_blueprint(&chunk->blocks[x][y][z], blueprint);
-                
-                // Add color variation for non-air blocks
-                if (blockType != VOXEL_AIR) {
-                    chunk->blocks[x][y][z].color = get_terrain_color(blockType, worldX, worldY, worldZ, generator->seed);
-                }
-            }
-            
-            // All other layers remain as air
-            BlockBlueprint* airBlueprint = get_block_blueprint(blueprints, VOXEL_AIR);
-            for (int z_other = 1; z_other < 16; z_other++) {
-                if (airBlueprint) {
-                    initialize_block_from_blueprint(&chunk->blocks[x][y][z_other], airBlueprint);
-                }
-            }
+            set_block_type(chunk, x, y, z, blockType);
         }
     }
     
@@ -574,13 +791,13 @@ void generate_chunk_terrain(VoxelChunk* chunk, TerrainGenerator* generator) {
         for (int y = 0; y < 16; y++) {
             int worldX = worldChunkX + x;
             int worldY = worldChunkY + y;
-            int worldZ = chunk->chunkZ * 16 + 0; // Ground level (z=0)
+            int worldZ = sectionBottom + groundZ; // Ground level
             
             // Check if we should generate a tree here
             if (should_generate_tree_at(worldX, worldY, worldZ, &treeGen)) {
-                // Make sure there's solid grass at this position (z=0)
-                if (chunk->blocks[x][y][0].type == VOXEL_GRASS) {
-                    Tree tree = generate_tree_at_position(x, y, 0, &treeGen);
+                // Make sure there's solid grass at this position
+                if (get_block_type(chunk, x, y, groundZ) == VOXEL_GRASS) {
+                    Tree tree = generate_tree_at_position(x, y, groundZ, &treeGen);
                     
                     // Verificar que el árbol cabe completamente en el chunk
                     if (can_tree_fit_in_chunk(&tree, chunk)) {
@@ -610,47 +827,338 @@ void generate_chunk_terrain(VoxelChunk* chunk, TerrainGenerator* generator) {
         }
     }
     
-    // Calculate face visibility for all layers (including trees)
-    for (int x = 0; x < 16; x++) {
-        for (int y = 0; y < 16; y++) {
-            for (int z = 0; z < 16; z++) {
-                if (chunk->blocks[x][y][z].type != VOXEL_AIR) {
-                    calculate_block_faces(chunk, x, y, z);
+    // Face visibility is computed on demand (get_block_faces)
+    chunk_storage_compact(&chunk->storage);
+    chunk->isGenerated = TRUE;
+    mark_neighborhood_remesh(chunk);
+    printf("Terreno generado para chunk (%d, %d, %d) con %d árboles\n", 
+           chunk->chunkX, chunk->chunkY, chunk->chunkZ, treesGenerated);
+}
+
+// Calculate which faces of a block are visible (Z es el eje vertical)
+// Una cara es visible si el vecino no es opaco; en el borde se consulta el chunk vecino
+// (si no está cargado se asume vacío).
+uint8 calculate_block_faces(VoxelChunk* chunk, int x, int y, int z) {
+    if (!is_chunk_block_occupied(chunk, x, y, z)) return 0;
+    
+    // Un bit por cara tapada; los vecinos verticales están en la misma fila de la columna
+    uint16 column = chunk->opaqueMask[x][y];
+    uint32 hidden =
+        (x < 15 ? (chunk->opaqueMask[x + 1][y] >> z) & 1 : is_block_opaque_across(chunk, 16, y, z)) << 0 |  // BLOCK_FACE_RIGHT
+        (x > 0 ? (chunk->opaqueMask[x - 1][y] >> z) & 1 : is_block_opaque_across(chunk, -1, y, z)) << 1 |   // BLOCK_FACE_LEFT
+        (y < 15 ? (chunk->opaqueMask[x][y + 1] >> z) & 1 : is_block_opaque_across(chunk, x, 16, z)) << 2 |  // BLOCK_FACE_FRONT
+        (y > 0 ? (chunk->opaqueMask[x][y - 1] >> z) & 1 : is_block_opaque_across(chunk, x, -1, z)) << 3 |   // BLOCK_FACE_BACK
+        (z < 15 ? (column >> (z + 1)) & 1 : is_block_opaque_across(chunk, x, y, 16)) << 4 |                 // BLOCK_FACE_TOP
+        (z > 0 ? (column >> (z - 1)) & 1 : is_block_opaque_across(chunk, x, y, -1)) << 5;                   // BLOCK_FACE_BOTTOM
+    return (uint8)(~hidden & BLOCK_FACE_ALL);
+}
+
+// Opaque column (x,y) in -1..16, del chunk vecino en el borde (0 si no está cargado)
+static inline uint16 opaque_column_across(VoxelChunk* chunk, int x, int y) {
+    int dx = (x < 0) ? -1 : (x >= 16 ? 1 : 0);
+    int dy = (y < 0) ? -1 : (y >= 16 ? 1 : 0);
+    VoxelChunk* owner = (dx | dy) ? chunk->neighbors[chunk_neighbor_index(dx, dy, 0)] : chunk;
+    return owner ? owner->opaqueMask[x - dx * 16][y - dy * 16] : 0;
+}
+
+// Visible faces of a whole column at once: faces[i] tiene el bit z si la cara BLOCK_FACE
+// (1 << i) del bloque z se ve. Mismo resultado que calculate_block_faces en los 16 bloques,
+// con una operación de 16 bits por cara en lugar de una consulta por voxel.
+void calculate_column_faces(VoxelChunk* chunk, int x, int y, uint16 faces[6]) {
+    uint16 occupied = chunk->occupiedMask[x][y];
+    if (!occupied) {
+        memset(faces, 0, 6 * sizeof(uint16));
+        return;
+    }
+
+    uint16 column = chunk->opaqueMask[x][y];
+    VoxelChunk* above = chunk->neighbors[chunk_neighbor_index(0, 0, 1)];
+    VoxelChunk* below = chunk->neighbors[chunk_neighbor_index(0, 0, -1)];
+    uint16 aboveBit = above ? (uint16)((above->opaqueMask[x][y] & 1u) << 15) : 0;
+    uint16 belowBit = below ? (uint16)(below->opaqueMask[x][y] >> 15) : 0;
+
+    faces[0] = occupied & (uint16)~(x < 15 ? chunk->opaqueMask[x + 1][y] : opaque_column_across(chunk, 16, y));  // BLOCK_FACE_RIGHT
+    faces[1] = occupied & (uint16)~(x > 0 ? chunk->opaqueMask[x - 1][y] : opaque_column_across(chunk, -1, y));   // BLOCK_FACE_LEFT
+    faces[2] = occupied & (uint16)~(y < 15 ? chunk->opaqueMask[x][y + 1] : opaque_column_across(chunk, x, 16));  // BLOCK_FACE_FRONT
+    faces[3] = occupied & (uint16)~(y > 0 ? chunk->opaqueMask[x][y - 1] : opaque_column_across(chunk, x, -1));   // BLOCK_FACE_BACK
+    faces[4] = occupied & (uint16)~((column >> 1) | aboveBit);                                                 // BLOCK_FACE_TOP
+    faces[5] = occupied & (uint16)~((column << 1) | belowBit);                                                 // BLOCK_FACE_BOTTOM
+}
+
+// Check if there's an opaque block adjacent to the given position (hides the shared face)
+BOOL is_block_adjacent(VoxelChunk* chunk, int x, int y, int z, int dx, int dy, int dz) {
+    return is_block_opaque_across(chunk, x + dx, y + dy, z + dz);
+}
+
+// Neighbour link for a chunk offset in -1..1 (self for 0,0,0)
+VoxelChunk* get_chunk_neighbor(VoxelChunk* chunk, int dx, int dy, int dz) {
+    if (!chunk || dx < -1 || dx > 1 || dy < -1 || dy > 1 || dz < -1 || dz > 1) return NULL;
+    return chunk->neighbors[chunk_neighbor_index(dx, dy, dz)];
+}
+
+// Step local coordinates in -16..31 into the owning neighbour (NULL if not loaded)
+static inline VoxelChunk* resolve_across(VoxelChunk* chunk, int* x, int* y, int* z) {
+    int dx = (*x < 0) ? -1 : (*x >= 16 ? 1 : 0);
+    int dy = (*y < 0) ? -1 : (*y >= 16 ? 1 : 0);
+    int dz = (*z < 0) ? -1 : (*z >= 16 ? 1 : 0);
+    *x -= dx * 16;
+    *y -= dy * 16;
+    *z -= dz * 16;
+    if ((unsigned)*x >= 16 || (unsigned)*y >= 16 || (unsigned)*z >= 16) return NULL;
+    return (dx | dy | dz) ? chunk->neighbors[chunk_neighbor_index(dx, dy, dz)] : chunk;
+}
+
+VoxelType get_block_type_across(VoxelChunk* chunk, int x, int y, int z) {
+    VoxelChunk* owner = resolve_across(chunk, &x, &y, &z);
+    return owner ? (VoxelType)chunk_storage_get(&owner->storage, chunk_block_index(x, y, z)) : VOXEL_AIR;
+}
+
+BOOL is_block_opaque_across(VoxelChunk* chunk, int x, int y, int z) {
+    VoxelChunk* owner = resolve_across(chunk, &x, &y, &z);
+    return owner ? is_chunk_block_opaque(owner, x, y, z) : FALSE;
+}
+
+// Mark the chunk and every neighbour whose border touches the local box for remeshing
+static void mark_region_remesh(VoxelChunk* chunk, const uint8 min[3], const uint8 max[3]) {
+    chunk->needsRemesh = TRUE;
+    update_chunk_connectivity(chunk);  // Solo el chunk editado: el de los vecinos no cambia
+    int minX = (min[0] == 0) ? -1 : 0, maxX = (max[0] == 15) ? 1 : 0;
+    int minY = (min[1] == 0) ? -1 : 0, maxY = (max[1] == 15) ? 1 : 0;
+    int minZ = (min[2] == 0) ? -1 : 0, maxZ = (max[2] == 15) ? 1 : 0;
+    for (int dx = minX; dx <= maxX; dx++) {
+        for (int dy = minY; dy <= maxY; dy++) {
+            for (int dz = minZ; dz <= maxZ; dz++) {
+                VoxelChunk* neighbor = chunk->neighbors[chunk_neighbor_index(dx, dy, dz)];
+                if (neighbor) {
+                    neighbor->needsRemesh = TRUE;
                 }
             }
         }
     }
+}
+
+// Mark the chunk and every neighbour whose border touches block (x,y,z) for remeshing
+void mark_block_remesh(VoxelChunk* chunk, int x, int y, int z) {
+    if (!chunk || x < 0 || x >= 16 || y < 0 || y >= 16 || z < 0 || z >= 16) return;
     
-    chunk->isGenerated = TRUE;
-    printf("Terreno generado para chunk (%d, %d, %d) con %d árboles\n", 
-           chunk->chunkX, chunk->chunkY, chunk->chunkZ, treesGenerated);
+    uint8 block[3] = {(uint8)x, (uint8)y, (uint8)z};
+    mark_region_remesh(chunk, block, block);
 }
 
-// Calculate which faces of a block are visible
-void calculate_block_faces(VoxelChunk* chunk, int x, int y, int z) {
-    VoxelBlock* block = &chunk->blocks[x][y][z];
+// ============================================================================
+// REMESH QUEUE - ediciones acumuladas por chunk, aplicadas una vez por frame
+// ============================================================================
+
+static inline int clamp_block_coord(int v) {
+    return v < 0 ? 0 : (v > 15 ? 15 : v);
+}
+
+// Grow the chunk's dirty box; el chunk entra en la cola con su primera edición
+void queue_region_remesh(ChunkManager* manager, VoxelChunk* chunk, int minX, int minY, int minZ, int maxX, int maxY, int maxZ) {
+    if (!chunk) return;
     
-    // Check adjacent blocks
-    block->hasTopFace = !is_block_adjacent(chunk, x, y, z, 0, 1, 0);
-    block->hasBottomFace = !is_block_adjacent(chunk, x, y, z, 0, -1, 0);
-    block->hasLeftFace = !is_block_adjacent(chunk, x, y, z, -1, 0, 0);
-    block->hasRightFace = !is_block_adjacent(chunk, x, y, z, 1, 0, 0);
-    block->hasFrontFace = !is_block_adjacent(chunk, x, y, z, 0, 0, 1);
-    block->hasBackFace = !is_block_adjacent(chunk, x, y, z, 0, 0, -1);
+    uint8 min[3] = {(uint8)clamp_block_coord(minX), (uint8)clamp_block_coord(minY), (uint8)clamp_block_coord(minZ)};
+    uint8 max[3] = {(uint8)clamp_block_coord(maxX), (uint8)clamp_block_coord(maxY), (uint8)clamp_block_coord(maxZ)};
+    
+    // Sin cola (o llena): marcar en el momento, como antes
+    if (!manager || !manager->remeshQueue ||
+        (!chunk->hasDirtyRegion && manager->remeshQueueCount >= manager->maxChunks)) {
+        mark_region_remesh(chunk, min, max);
+        return;
+    }
+    
+    manager->queuedEdits++;
+    if (!chunk->hasDirtyRegion) {
+        chunk->hasDirtyRegion = TRUE;
+        memcpy(chunk->dirtyMin, min, sizeof(min));
+        memcpy(chunk->dirtyMax, max, sizeof(max));
+        manager->remeshQueue[manager->remeshQueueCount++] = chunk;
+        return;
+    }
+    
+    for (int axis = 0; axis < 3; axis++) {
+        if (min[axis] < chunk->dirtyMin[axis]) chunk->dirtyMin[axis] = min[axis];
+        if (max[axis] > chunk->dirtyMax[axis]) chunk->dirtyMax[axis] = max[axis];
+    }
 }
 
-// Check if there's a block adjacent to the given position
-BOOL is_block_adjacent(VoxelChunk* chunk, int x, int y, int z, int dx, int dy, int dz) {
-    int newX = x + dx;
-    int newY = y + dy;
-    int newZ = z + dz;
+void queue_block_remesh(ChunkManager* manager, VoxelChunk* chunk, int x, int y, int z) {
+    if (x < 0 || x >= 16 || y < 0 || y >= 16 || z < 0 || z >= 16) return;
+    queue_region_remesh(manager, chunk, x, y, z, x, y, z);
+}
+
+// Apply the frame's edits: un remesh por chunk editado, más los vecinos cuyo borde toca la caja
+int flush_remesh_queue(ChunkManager* manager) {
+    if (!manager || !manager->remeshQueue) return 0;
+    
+    int flushed = manager->remeshQueueCount;
+    for (int i = 0; i < manager->remeshQueueCount; i++) {
+        VoxelChunk* chunk = manager->remeshQueue[i];
+        mark_region_remesh(chunk, chunk->dirtyMin, chunk->dirtyMax);
+        chunk->hasDirtyRegion = FALSE;
+    }
+    manager->remeshQueueCount = 0;
+    manager->queuedEdits = 0;
+    return flushed;
+}
+
+static inline int floor_div16(int v) {
+    return v < 0 ? -((15 - v) / 16) : v / 16;
+}
+
+// Bulk edit in world coordinates (explosiones, rellenos): una caja sucia por chunk
+// tocado en vez de un remesh por bloque. Devuelve los bloques cambiados.
+int fill_block_region(ChunkManager* manager, int minX, int minY, int minZ, int maxX, int maxY, int maxZ, VoxelType type) {
+    if (!manager || minX > maxX || minY > maxY || minZ > maxZ) return 0;
+    
+    int changed = 0;
+    for (int cx = floor_div16(minX); cx <= floor_div16(maxX); cx++) {
+        for (int cy = floor_div16(minY); cy <= floor_div16(maxY); cy++) {
+            for (int cz = floor_div16(minZ); cz <= floor_div16(maxZ); cz++) {
+                VoxelChunk* chunk = find_chunk(manager, cx, cy, cz);
+                if (!chunk || !chunk->isGenerated) continue;
+                
+                // Caja local recortada al chunk
+                int x0 = clamp_block_coord(minX - cx * 16), x1 = clamp_block_coord(maxX - cx * 16);
+                int y0 = clamp_block_coord(minY - cy * 16), y1 = clamp_block_coord(maxY - cy * 16);
+                int z0 = clamp_block_coord(minZ - cz * 16), z1 = clamp_block_coord(maxZ - cz * 16);
+                int chunkChanged = 0;
+                for (int x = x0; x <= x1; x++) {
+                    for (int y = y0; y <= y1; y++) {
+                        for (int z = z0; z <= z1; z++) {
+                            if (get_block_type(chunk, x, y, z) == type) continue;
+                            set_block_type(chunk, x, y, z, type);
+                            chunkChanged++;
+                        }
+                    }
+                }
+                if (!chunkChanged) continue;
+                
+                chunk_storage_compact(&chunk->storage);
+                queue_region_remesh(manager, chunk, x0, y0, z0, x1, y1, z1);
+                changed += chunkChanged;
+            }
+        }
+    }
+    return changed;
+}
+
+// Count the chunks flagged for remeshing and clear the flags
+static int take_remesh_flags(ChunkManager* manager) {
+    int flagged = 0;
+    for (int i = 0; i < manager->maxChunks; i++) {
+        VoxelChunk* chunk = manager->chunks[i];
+        if (chunk && chunk->needsRemesh) {
+            chunk->needsRemesh = FALSE;
+            flagged++;
+        }
+    }
+    return flagged;
+}
+
+// Headless check: ediciones interiores, de borde y en bloque sobre un suelo de 3x3 chunks
+BOOL verify_remesh_queue(void) {
+    ChunkManager* manager = create_chunk_manager(32, 1);
+    BOOL ok = TRUE;
+    
+    if (!manager) return FALSE;
+    manager->evictionPolicy.saveDirectory[0] = '\0'; // La prueba no toca el disco
+    
+    for (int cx = -1; cx <= 1; cx++) {
+        for (int cy = -1; cy <= 1; cy++) {
+            VoxelChunk* chunk = get_or_create_chunk(manager, cx, cy, 0);
+            if (!chunk) {
+                ok = FALSE;
+                continue;
+            }
+            for (int x = 0; x < 16; x++)
+                for (int y = 0; y < 16; y++)
+                    set_block_type(chunk, x, y, 0, VOXEL_GRASS);
+            chunk->isGenerated = TRUE;
+        }
+    }
+    take_remesh_flags(manager);
     
-    // Check bounds
-    if (newX < 0 || newX >= 16 || newY < 0 || newY >= 16 || newZ < 0 || newZ >= 16) {
-        return FALSE; // Assume no block outside chunk bounds
+    VoxelChunk* center = find_chunk(manager, 0, 0, 0);
+    if (!ok || !center) {
+        destroy_chunk_manager(manager);
+        return FALSE;
+    }
+    
+    // Interior edits in one frame: una entrada en la cola, un remesh
+    for (int i = 0; i < 20; i++) {
+        set_block_type(center, 4 + i % 8, 4 + i / 8, 1, VOXEL_STONE);
+        queue_block_remesh(manager, center, 4 + i % 8, 4 + i / 8, 1);
+    }
+    int edits = manager->queuedEdits;
+    int queued = flush_remesh_queue(manager);
+    int remeshed = take_remesh_flags(manager);
+    BOOL interiorOk = edits == 20 && queued == 1 && remeshed == 1;
+    printf("   - %d ediciones interiores: %d chunk en cola, %d remesh %s\n",
+           edits, queued, remeshed, interiorOk ? "OK" : "FALLO");
+    ok &= interiorOk;
+    
+    // Border edit: también el vecino del lado tocado, ningún otro
+    set_block_type(center, 15, 7, 1, VOXEL_STONE);
+    queue_block_remesh(manager, center, 15, 7, 1);
+    flush_remesh_queue(manager);
+    remeshed = take_remesh_flags(manager);
+    VoxelChunk* east = find_chunk(manager, 1, 0, 0);
+    printf("   - Edición en el borde +X: %d remesh (chunk + vecino este) %s\n",
+           remeshed, remeshed == 2 && east ? "OK" : "FALLO");
+    ok &= remeshed == 2 && east;
+    
+    // Bulk edit across four chunks: una caja por chunk, no un remesh por bloque
+    int changed = fill_block_region(manager, 8, 8, 0, 23, 23, 0, VOXEL_AIR);
+    queued = flush_remesh_queue(manager);
+    remeshed = take_remesh_flags(manager);
+    BOOL bulkOk = changed == 256 && queued == 4 && remeshed == 4;
+    printf("   - Relleno de %d bloques sobre 4 chunks: %d en cola, %d remesh %s\n",
+           changed, queued, remeshed, bulkOk ? "OK" : "FALLO");
+    ok &= bulkOk;
+    
+    destroy_chunk_manager(manager);
+    printf("   - Cola de remesh: %s\n", ok ? "OK" : "FALLO");
+    return ok;
+}
+
+// Recompute both occupancy masks from the block storage (after bulk loads)
+void rebuild_chunk_occupancy(VoxelChunk* chunk) {
+    if (!chunk) return;
+    
+    if (chunk_storage_is_uniform(&chunk->storage)) {
+        uint8 block = chunk->storage.palette[0];
+        uint8 flags = get_block_flags(block);
+        uint16 occupiedRow = (block != VOXEL_AIR) ? 0xFFFF : 0;
+        uint16 solidRow = (flags & BLOCK_FLAG_SOLID) ? 0xFFFF : 0;
+        uint16 opaqueRow = (flags & BLOCK_FLAG_OPAQUE) ? 0xFFFF : 0;
+        for (int x = 0; x < 16; x++) {
+            for (int y = 0; y < 16; y++) {
+                chunk->occupiedMask[x][y] = occupiedRow;
+                chunk->solidMask[x][y] = solidRow;
+                chunk->opaqueMask[x][y] = opaqueRow;
+            }
+        }
+        return;
     }
     
-    return chunk->blocks[newX][newY][newZ].type != VOXEL_AIR;
+    for (int x = 0; x < 16; x++) {
+        for (int y = 0; y < 16; y++) {
+            uint16 occupiedRow = 0;
+            uint16 solidRow = 0;
+            uint16 opaqueRow = 0;
+            for (int z = 0; z < 16; z++) {
+                uint8 block = chunk_storage_get(&chunk->storage, chunk_block_index(x, y, z));
+                uint8 flags = get_block_flags(block);
+                if (block != VOXEL_AIR) occupiedRow |= (uint16)(1u << z);
+                if (flags & BLOCK_FLAG_SOLID) solidRow |= (uint16)(1u << z);
+                if (flags & BLOCK_FLAG_OPAQUE) opaqueRow |= (uint16)(1u << z);
+            }
+            chunk->occupiedMask[x][y] = occupiedRow;
+            chunk->solidMask[x][y] = solidRow;
+            chunk->opaqueMask[x][y] = opaqueRow;
+        }
+    }
 }
 
 // Get block type at position
@@ -658,7 +1166,251 @@ VoxelType get_block_type(VoxelChunk* chunk, int x, int y, int z) {
     if (x < 0 || x >= 16 || y < 0 || y >= 16 || z < 0 || z >= 16) {
         return VOXEL_AIR;
     }
-    return chunk->blocks[x][y][z].type;
+    return (VoxelType)chunk_storage_get(&chunk->storage, chunk_block_index(x, y, z));
+}
+
+// Set block type at position (the palette grows automatically)
+void set_block_type(VoxelChunk* chunk, int x, int y, int z, VoxelType type) {
+    if (!chunk || x < 0 || x >= 16 || y < 0 || y >= 16 || z < 0 || z >= 16) return;
+    
+    int index = chunk_block_index(x, y, z);
+    if (!chunk_storage_set(&chunk->storage, index, (uint8)type)) return;
+    
+    // Edits after generation must survive eviction
+    if (chunk->isGenerated) {
+        chunk->isDirty = TRUE;
+    }
+    
+    // Keep the occupancy bits in sync (every place/break goes through here)
+    uint16 bit = (uint16)(1u << z);
+    uint8 flags = get_block_flags((uint8)type);
+    if (type != VOXEL_AIR) chunk->occupiedMask[x][y] |= bit;
+    else chunk->occupiedMask[x][y] &= (uint16)~bit;
+    if (flags & BLOCK_FLAG_SOLID) chunk->solidMask[x][y] |= bit;
+    else chunk->solidMask[x][y] &= (uint16)~bit;
+    if (flags & BLOCK_FLAG_OPAQUE) chunk->opaqueMask[x][y] |= bit;
+    else chunk->opaqueMask[x][y] &= (uint16)~bit;
+    
+    // A new block starts with full durability: drop any damage entry
+    for (int i = 0; i < chunk->damagedCount; i++) {
+        if (chunk->damaged[i].index == index) {
+            chunk->damaged[i] = chunk->damaged[--chunk->damagedCount];
+            break;
+        }
+    }
+}
+
+// Get visible face mask (BLOCK_FACE_*) at position - calculado bajo demanda
+uint8 get_block_faces(VoxelChunk* chunk, int x, int y, int z) {
+    if (x < 0 || x >= 16 || y < 0 || y >= 16 || z < 0 || z >= 16) {
+        return 0;
+    }
+    return calculate_block_faces(chunk, x, y, z);
+}
+
+// Get block color - variación calculada bajo demanda desde la posición y el seed
+Color get_block_color(VoxelChunk* chunk, int x, int y, int z) {
+    VoxelType type = get_block_type(chunk, x, y, z);
+    if (type == VOXEL_AIR) {
+        return (Color){0, 0, 0};
+    }
+    
+    int worldX = chunk->chunkX * 16 + x;
+    int worldY = chunk->chunkY * 16 + y;
+    int worldZ = chunk->chunkZ * 16 + z;
+    return get_terrain_color(type, worldX, worldY, worldZ, chunk->colorSeed);
+}
+
+// Get current durability (blueprint durability unless the block was damaged)
+int get_block_durability(VoxelChunk* chunk, int x, int y, int z) {
+    VoxelType type = get_block_type(chunk, x, y, z);
+    int index = chunk_block_index(x, y, z);
+    
+    for (int i = 0; i < chunk->damagedCount; i++) {
+        if (chunk->damaged[i].index == index) {
+            return chunk->damaged[i].durability;
+        }
+    }
+    
+    BlockBlueprint* blueprint = get_block_blueprint(create_block_blueprints(), type);
+    return blueprint ? blueprint->durability : 0;
+}
+
+// Store reduced durability in the side table
+void set_block_durability(VoxelChunk* chunk, int x, int y, int z, int durability) {
+    if (!chunk || x < 0 || x >= 16 || y < 0 || y >= 16 || z < 0 || z >= 16) return;
+    
+    int index = chunk_block_index(x, y, z);
+    for (int i = 0; i < chunk->damagedCount; i++) {
+        if (chunk->damaged[i].index == index) {
+            chunk->damaged[i].durability = (uint16)durability;
+            return;
+        }
+    }
+    
+    if (chunk->damagedCount >= CHUNK_MAX_DAMAGED_BLOCKS) {
+        // Tabla llena: se olvida el daño más antiguo
+        memmove(&chunk->damaged[0], &chunk->damaged[1], (CHUNK_MAX_DAMAGED_BLOCKS - 1) * sizeof(BlockDamage));
+        chunk->damagedCount--;
+    }
+    chunk->damaged[chunk->damagedCount].index = (uint16)index;
+    chunk->damaged[chunk->damagedCount].durability = (uint16)durability;
+    chunk->damagedCount++;
+}
+
+// Unpack a block into the legacy VoxelBlock view
+VoxelBlock get_block_info(VoxelChunk* chunk, int x, int y, int z) {
+    VoxelBlock block = {0};
+    uint8 faces = get_block_faces(chunk, x, y, z);
+    
+    block.type = get_block_type(chunk, x, y, z);
+    block.color = get_block_color(chunk, x, y, z);
+    block.isVisible = (block.type != VOXEL_AIR);
+    block.hasTopFace = (faces & BLOCK_FACE_TOP) != 0;
+    block.hasBottomFace = (faces & BLOCK_FACE_BOTTOM) != 0;
+    block.hasLeftFace = (faces & BLOCK_FACE_LEFT) != 0;
+    block.hasRightFace = (faces & BLOCK_FACE_RIGHT) != 0;
+    block.hasFrontFace = (faces & BLOCK_FACE_FRONT) != 0;
+    block.hasBackFace = (faces & BLOCK_FACE_BACK) != 0;
+    block.currentDurability = get_block_durability(chunk, x, y, z);
+    return block;
+}
+
+// ============================================================================
+// BENCHMARK - máscaras de ocupación vs consultas por voxel con blueprints
+// ============================================================================
+
+// Legacy solidity test: block id + blueprint lookup per voxel
+static BOOL legacy_is_solid(VoxelChunk* chunk, BlockBlueprint* blueprints, int x, int y, int z) {
+    if (x < 0 || x >= 16 || y < 0 || y >= 16 || z < 0 || z >= 16) return FALSE;
+    BlockBlueprint* blueprint = get_block_blueprint(blueprints, get_block_type(chunk, x, y, z));
+    return blueprint ? blueprint->isSolid : FALSE;
+}
+
+// Legacy face mask: one blueprint lookup per neighbour
+static uint8 legacy_block_faces(VoxelChunk* chunk, BlockBlueprint* blueprints, int x, int y, int z) {
+    static const int offsets[6][3] = {{1,0,0}, {-1,0,0}, {0,1,0}, {0,-1,0}, {0,0,1}, {0,0,-1}};
+    static const uint8 faces[6] = {BLOCK_FACE_RIGHT, BLOCK_FACE_LEFT, BLOCK_FACE_FRONT,
+                                   BLOCK_FACE_BACK, BLOCK_FACE_TOP, BLOCK_FACE_BOTTOM};
+    if (get_block_type(chunk, x, y, z) == VOXEL_AIR) return 0;
+    
+    uint8 mask = 0;
+    for (int i = 0; i < 6; i++) {
+        int nx = x + offsets[i][0], ny = y + offsets[i][1], nz = z + offsets[i][2];
+        VoxelType neighbour = get_block_type(chunk, nx, ny, nz);
+        BlockBlueprint* blueprint = get_block_blueprint(blueprints, neighbour);
+        if (neighbour == VOXEL_AIR || !blueprint || blueprint->isTransparent) mask |= faces[i];
+    }
+    return mask;
+}
+
+static double occupancy_seconds(LARGE_INTEGER start, LARGE_INTEGER end, LARGE_INTEGER freq) {
+    return (double)(end.QuadPart - start.QuadPart) / (double)freq.QuadPart;
+}
+
+void benchmark_occupancy_masks(int iterations) {
+    static VoxelChunk chunk;
+    BlockBlueprint* blueprints = create_block_blueprints();
+    LARGE_INTEGER freq, start, end;
+    
+    if (!blueprints) return;
+    if (iterations <= 0) iterations = 1000000;
+    QueryPerformanceFrequency(&freq);
+    
+    // Terreno de prueba: suelo de 4 capas y bloques sueltos de madera/hojas encima
+    memset(&chunk, 0, sizeof(VoxelChunk));
+    if (!chunk_storage_init(&chunk.storage, VOXEL_AIR)) return;
+    uint32 seed = 777;
+    for (int x = 0; x < 16; x++) {
+        for (int y = 0; y < 16; y++) {
+            for (int z = 0; z < 16; z++) {
+                seed = seed * 1664525u + 1013904223u;
+                if (z < 4) set_block_type(&chunk, x, y, z, VOXEL_GRASS);
+                else if ((seed >> 28) == 0) set_block_type(&chunk, x, y, z, VOXEL_WOOD);
+                else if ((seed >> 28) == 1) set_block_type(&chunk, x, y, z, VOXEL_LEAVES);
+            }
+        }
+    }
+    
+    // Collision: player-sized box (2x2x3 voxels) at random positions
+    int legacyHits = 0, maskHits = 0;
+    seed = 12345;
+    QueryPerformanceCounter(&start);
+    for (int i = 0; i < iterations; i++) {
+        seed = seed * 1664525u + 1013904223u;
+        int bx = (seed >> 8) % 15, by = (seed >> 12) % 15, bz = (seed >> 16) % 14;
+        BOOL hit = FALSE;
+        for (int x = bx; x <= bx + 1 && !hit; x++)
+            for (int y = by; y <= by + 1 && !hit; y++)
+                for (int z = bz; z <= bz + 2 && !hit; z++)
+                    hit = legacy_is_solid(&chunk, blueprints, x, y, z);
+        legacyHits += hit;
+    }
+    QueryPerformanceCounter(&end);
+    double legacyCollision = occupancy_seconds(start, end, freq);
+    
+    seed = 12345;
+    QueryPerformanceCounter(&start);
+    for (int i = 0; i < iterations; i++) {
+        seed = seed * 1664525u + 1013904223u;
+        int bx = (seed >> 8) % 15, by = (seed >> 12) % 15, bz = (seed >> 16) % 14;
+        uint16 zBits = (uint16)(0x7u << bz);
+        uint16 rows = chunk.solidMask[bx][by] | chunk.solidMask[bx][by + 1] |
+                      chunk.solidMask[bx + 1][by] | chunk.solidMask[bx + 1][by + 1];
+        maskHits += (rows & zBits) != 0;
+    }
+    QueryPerformanceCounter(&end);
+    double maskCollision = occupancy_seconds(start, end, freq);
+    
+    // Face culling: full-chunk sweeps. Las máscaras resuelven una columna entera por llamada;
+    // la suma ponderada por cara (bit i = 1 << i) coincide con sumar la máscara de cada bloque
+    int sweeps = iterations / CHUNK_VOLUME + 1;
+    uint32 legacyFaces = 0, maskFaces = 0;
+    QueryPerformanceCounter(&start);
+    for (int s = 0; s < sweeps; s++)
+        for (int x = 0; x < 16; x++)
+            for (int y = 0; y < 16; y++)
+                for (int z = 0; z < 16; z++)
+                    legacyFaces += legacy_block_faces(&chunk, blueprints, x, y, z);
+    QueryPerformanceCounter(&end);
+    double legacyCull = occupancy_seconds(start, end, freq);
+    
+    QueryPerformanceCounter(&start);
+    for (int s = 0; s < sweeps; s++)
+        for (int x = 0; x < 16; x++)
+            for (int y = 0; y < 16; y++) {
+                uint16 faces[6];
+                calculate_column_faces(&chunk, x, y, faces);
+                for (int i = 0; i < 6; i++) maskFaces += (uint32)__builtin_popcount(faces[i]) << i;
+            }
+    QueryPerformanceCounter(&end);
+    double maskCull = occupancy_seconds(start, end, freq);
+    
+    // Exactitud bloque a bloque, fuera del tiempo medido: blueprints, por voxel y por columna
+    BOOL facesMatch = TRUE;
+    for (int x = 0; x < 16; x++)
+        for (int y = 0; y < 16; y++) {
+            uint16 faces[6];
+            calculate_column_faces(&chunk, x, y, faces);
+            for (int z = 0; z < 16; z++) {
+                uint8 columnMask = 0;
+                for (int i = 0; i < 6; i++) columnMask |= (uint8)(((faces[i] >> z) & 1) << i);
+                uint8 legacyMask = legacy_block_faces(&chunk, blueprints, x, y, z);
+                if (columnMask != legacyMask || calculate_block_faces(&chunk, x, y, z) != legacyMask) facesMatch = FALSE;
+            }
+        }
+    
+    double faceQueries = (double)sweeps * CHUNK_VOLUME;
+    printf("   - Colisión blueprints: %.1f Mops/s, máscaras: %.1f Mops/s (x%.1f)\n",
+           iterations / legacyCollision / 1e6, iterations / maskCollision / 1e6,
+           legacyCollision / maskCollision);
+    printf("   - Caras blueprints:    %.1f Mbloques/s, columnas: %.1f Mbloques/s (x%.1f)\n",
+           faceQueries / legacyCull / 1e6, faceQueries / maskCull / 1e6, legacyCull / maskCull);
+    printf("   - Verificación: %s (colisiones %d/%d, caras %u/%u)\n",
+           (legacyHits == maskHits && legacyFaces == maskFaces && facesMatch) ? "OK" : "FALLO",
+           legacyHits, maskHits, (unsigned)legacyFaces, (unsigned)maskFaces);
+    
+    chunk_storage_free(&chunk.storage);
 }
 
 // Convert chunk coordinates to world position
@@ -686,10 +1438,22 @@ void world_to_chunk_pos(float worldX, float worldY, float worldZ, int* chunkX, i
 float get_voxel_opacity(VoxelType type) {
     switch (type) {
         case VOXEL_LEAVES: return 0.8f; // Hojas semi-transparentes
+        case VOXEL_WATER: return 0.6f;
+        case VOXEL_GLASS: return 0.35f;
+        case VOXEL_LAVA: return 0.9f;
         default: return 1.0f; // Sólido
     }
 }
 
+// Render pass: los bloques transparentes del blueprint se mezclan, salvo las hojas (recortadas)
+ChunkRenderLayer get_voxel_render_layer(VoxelType type) {
+    if (type == VOXEL_AIR || is_voxel_opaque(type)) return CHUNK_LAYER_OPAQUE;
+    switch (type) {
+        case VOXEL_LEAVES: return CHUNK_LAYER_CUTOUT;
+        default: return CHUNK_LAYER_TRANSLUCENT;
+    }
+}
+
 // Update chunk visibility based on camera position
 void update_chunk_visibility(VoxelChunk* chunk, Vect3 cameraPosition) {
     if (!chunk) return;
@@ -710,7 +1474,7 @@ void update_chunk_visibility(VoxelChunk* chunk, Vect3 cameraPosition) {
 
 // Render a single chunk - OPTIMIZED: Only render top layer
 void render_chunk(VoxelChunk* chunk, Vect3 cameraPosition, Vect3 cameraForward) {
-    if (!chunk || !chunk->isVisible || !chunk->isGenerated) return;
+    if (!chunk || !chunk->isVisible || !chunk->isGenerated || is_chunk_empty(chunk)) return;
     
     // Suppress unused parameter warnings
     (void)cameraForward;
@@ -732,19 +1496,10 @@ void render_chunk(VoxelChunk* chunk, Vect3 cameraPosition, Vect3 cameraForward)
     for (int x = 0; x < 16; x++) {
         for (int y = 0; y < 16; y++) {
             int z = 15; // Only top layer
-            VoxelBlock* block = &chunk->blocks[x][y][z];
-            
-            if (block->type == VOXEL_AIR || !block->isVisible) continue;
-            
-            // Suppress unused variable warnings
-            (void)chunk;
-            (void)x;
-            (void)y;
-            (void)z;
-            (void)block;
+            if (get_block_type(chunk, x, y, z) == VOXEL_AIR) continue;
             
             // Simple rendering - just draw a quad for the top face
-            if (block->hasTopFace) {
+            if (calculate_block_faces(chunk, x, y, z) & BLOCK_FACE_TOP) {
                 // This would be replaced with actual OpenGL rendering
                 // For now, just mark as rendered
             }
@@ -755,18 +1510,17 @@ void render_chunk(VoxelChunk* chunk, Vect3 cameraPosition, Vect3 cameraForward)
 // Render chunk manager
 void render_chunk_manager(ChunkManager* manager, Vect3 cameraPosition, Vect3 cameraForward) {
     if (!manager) return;
+    (void)cameraForward;
     
-    // Update visibility for all chunks
+    // Update visibility for all chunks (a chunk in range counts as accessed, aunque quede
+    // fuera del frustum: girar la cámara no debe desalojarlo). El frustum y el dibujo
+    // son de render_chunk_meshes, que vuelve a calcular isVisible en el mismo frame
     for (int i = 0; i < manager->maxChunks; i++) {
         if (manager->chunks[i]) {
             update_chunk_visibility(manager->chunks[i], cameraPosition);
-        }
-    }
-    
-    // Render visible chunks
-    for (int i = 0; i < manager->maxChunks; i++) {
-        if (manager->chunks[i] && manager->chunks[i]->isVisible) {
-            render_chunk(manager->chunks[i], cameraPosition, cameraForward);
+            if (manager->chunks[i]->isVisible) {
+                manager->chunks[i]->lastAccessFrame = manager->currentFrame;
+            }
         }
     }
 }
@@ -775,14 +1529,31 @@ void render_chunk_manager(ChunkManager* manager, Vect3 cameraPosition, Vect3 cam
 void update_chunk_loading(ChunkManager* manager, Vect3 playerPosition, ChunkLoadingConfig config) {
     if (!manager || !config.enableChunkLoading) return;
     
+    manager->currentFrame++;
+    manager->focusPosition = playerPosition;
+    
     // Load chunks around player
     load_chunks_around_player(manager, playerPosition, config.loadDistance);
     
     // Unload distant chunks
     unload_distant_chunks(manager, playerPosition, config.unloadDistance);
+    
+    // Stay under the memory budget (never touches the chunks around the player)
+    enforce_chunk_memory_budget(manager);
+}
+
+// Configure the vertical stack of chunks streamed around the player
+void set_chunk_vertical_range(ChunkManager* manager, int minChunkZ, int maxChunkZ, int verticalDistance) {
+    if (!manager || minChunkZ > maxChunkZ || verticalDistance < 0) return;
+    
+    manager->minChunkZ = minChunkZ;
+    manager->maxChunkZ = maxChunkZ;
+    manager->verticalDistance = verticalDistance;
+    printf("Rango vertical de chunks: z = [%d, %d], distancia vertical: %d\n",
+           minChunkZ, maxChunkZ, verticalDistance);
 }
 
-// Load chunks around player position - PATRÓN 3x3 CENTRADO
+// Load chunks around player position - PATRÓN 3x3 CENTRADO, columnas verticales según la Z del jugador
 void load_chunks_around_player(ChunkManager* manager, Vect3 playerPosition, int distance) {
     if (!manager) return;
     
@@ -801,18 +1572,35 @@ void load_chunks_around_player(ChunkManager* manager, Vect3 playerPosition, int
     // Cargar solo chunks esenciales (3x3 máximo)
     int maxDistance = (distance > 1) ? 1 : distance; // Limitar a 3x3 máximo
     
+    // Columna vertical alrededor de la Z del jugador, recortada al rango del mundo
+    int minZ = playerChunkZ - manager->verticalDistance;
+    int maxZ = playerChunkZ + manager->verticalDistance;
+    if (minZ < manager->minChunkZ) minZ = manager->minChunkZ;
+    if (maxZ > manager->maxChunkZ) maxZ = manager->maxChunkZ;
+    
+    TerrainGenerator generator = {0};
+    BOOL hasGenerator = FALSE;
+    
     for (int x = centerX - maxDistance; x <= centerX + maxDistance; x++) {
         for (int y = centerY - maxDistance; y <= centerY + maxDistance; y++) {
-            // Solo cargar chunks en el nivel del suelo (z = 0)
-            VoxelChunk* chunk = get_or_create_chunk(manager, x, y, 0);
-            if (chunk && !chunk->isGenerated) {
-                // Usar el mismo generador de terreno para consistencia
-                TerrainGenerator generator = create_terrain_generator(12345);
-                generate_chunk_terrain(chunk, &generator);
-                printf("Chunk cargado (3x3): (%d, %d, 0)\n", x, y);
+            for (int z = minZ; z <= maxZ; z++) {
+                VoxelChunk* chunk = get_or_create_chunk(manager, x, y, z);
+                if (chunk && !chunk->isGenerated) {
+                    // Usar el mismo generador de terreno para consistencia (uno por llamada)
+                    if (!hasGenerator) {
+                        generator = create_terrain_generator(12345);
+                        hasGenerator = TRUE;
+                    }
+                    generate_chunk_terrain(chunk, &generator);
+                    printf("Chunk cargado (3x3): (%d, %d, %d)\n", x, y, z);
+                }
             }
         }
     }
+    
+    if (hasGenerator) {
+        destroy_terrain_generator(&generator); // La matriz de ruido (4 MB) no debe acumularse
+    }
 }
 
 // Unload chunks that are too far from player
@@ -831,23 +1619,23 @@ void unload_distant_chunks(ChunkManager* manager, Vect3 playerPosition, int maxD
         if (manager->chunks[i]) {
             VoxelChunk* chunk = manager->chunks[i];
             
-            // Calculate distance from player chunk (solo X,Y para 2D)
+            // Calculate distance from player chunk
             int dx = chunk->chunkX - playerChunkX;
             int dy = chunk->chunkY - playerChunkY;
+            int dz = chunk->chunkZ - playerChunkZ;
             
-            // Usar distancia Manhattan para mejor rendimiento
+            // Usar distancia Manhattan horizontal para mejor rendimiento
             int distance = abs(dx) + abs(dy);
             
-            // Unload if too far (solo chunks del suelo z=0)
-            if (distance > maxDistance && chunk->chunkZ == 0) {
-                printf("Chunk descargado: (%d, %d, %d) - distancia: %d\n", 
-                       chunk->chunkX, chunk->chunkY, chunk->chunkZ, distance);
-                manager->chunks[i] = NULL;
-                
-                // Only decrement if loadedChunks > 0
-                if (manager->loadedChunks > 0) {
-                    manager->loadedChunks--;
-                }
+            // Vertical: un chunk de margen sobre la distancia de carga para no
+            // cargar/descargar en bucle al moverse cerca de un borde de sección
+            BOOL tooFarVertically = abs(dz) > manager->verticalDistance + 1 ||
+                                    chunk->chunkZ < manager->minChunkZ || chunk->chunkZ > manager->maxChunkZ;
+            
+            if (distance > maxDistance || tooFarVertically) {
+                printf("Chunk descargado: (%d, %d, %d) - distancia: %d, dz: %d\n", 
+                       chunk->chunkX, chunk->chunkY, chunk->chunkZ, distance, dz);
+                unload_chunk_slot(manager, i);
             }
         }
     }
@@ -861,18 +1649,248 @@ void emergency_cleanup_chunks(ChunkManager* manager) {
     
     for (int i = 0; i < manager->maxChunks; i++) {
         if (manager->chunks[i]) {
-            manager->chunks[i] = NULL;
+            unload_chunk_slot(manager, i);
         }
     }
     
+    // Every chunk went back to the pool free list, no pool_reset needed
     manager->loadedChunks = 0;
     
-    // Reset memory pool
-    if (manager->chunkPool) {
-        pool_reset(manager->chunkPool);
+    printf("EMERGENCIA: Limpieza completada. Chunks liberados: %d\n", manager->maxChunks);
+}
+
+// ============================================================================
+// CHUNK EVICTION POLICY - LRU ponderado por distancia y estado sucio
+// ============================================================================
+
+ChunkEvictionPolicy default_chunk_eviction_policy() {
+    ChunkEvictionPolicy policy;
+    memset(&policy, 0, sizeof(ChunkEvictionPolicy));
+    policy.score = chunk_eviction_score_default;
+    policy.ageWeight = 1.0f;          // 1 punto por frame sin acceso
+    policy.distanceWeight = 120.0f;   // Un chunk de distancia pesa como ~2 s sin acceso a 60 FPS
+    policy.dirtyPenalty = 300.0f;     // Escribir a disco cuesta: preferir chunks limpios
+    policy.protectRadius = 1;         // El 3x3 (y capas vecinas) alrededor del jugador
+    policy.memoryBudget = 0;
+    strcpy(policy.saveDirectory, "chunks");
+    return policy;
+}
+
+// Default score: frames since last access + distance to the player - dirty penalty
+float chunk_eviction_score_default(const VoxelChunk* chunk, const struct ChunkManager* manager) {
+    const ChunkEvictionPolicy* policy = &manager->evictionPolicy;
+    
+    float age = (float)(manager->currentFrame - chunk->lastAccessFrame);
+    float dx = (chunk->chunkX * 16 + 8 - manager->focusPosition.x) / 16.0f;
+    float dy = (chunk->chunkY * 16 + 8 - manager->focusPosition.y) / 16.0f;
+    float dz = (chunk->chunkZ * 16 + 8 - manager->focusPosition.z) / 16.0f;
+    float distance = sqrtf(dx * dx + dy * dy + dz * dz);
+    
+    float score = age * policy->ageWeight + distance * policy->distanceWeight;
+    if (chunk->isDirty) {
+        score -= policy->dirtyPenalty;
     }
+    return score;
+}
+
+// Bytes used by loaded chunks: pool blocks plus their block storage
+size_t get_chunk_manager_memory(ChunkManager* manager) {
+    if (!manager) return 0;
     
-    printf("EMERGENCIA: Limpieza completada. Chunks liberados: %d\n", manager->maxChunks);
+    size_t total = 0;
+    for (int i = 0; i < manager->maxChunks; i++) {
+        if (manager->chunks[i]) {
+            total += sizeof(VoxelChunk) + chunk_storage_memory_usage(&manager->chunks[i]->storage);
+        }
+    }
+    return total;
+}
+
+// Is the chunk inside the protected area around the player?
+static BOOL is_chunk_protected(ChunkManager* manager, const VoxelChunk* chunk) {
+    int focusX = (int)floorf(manager->focusPosition.x / 16.0f);
+    int focusY = (int)floorf(manager->focusPosition.y / 16.0f);
+    int focusZ = (int)floorf(manager->focusPosition.z / 16.0f);
+    int radius = manager->evictionPolicy.protectRadius;
+    
+    return abs(chunk->chunkX - focusX) <= radius &&
+           abs(chunk->chunkY - focusY) <= radius &&
+           abs(chunk->chunkZ - focusZ) <= radius;
+}
+
+// Evict the highest-scoring chunk; protected chunks only if allowProtected and nothing else is left
+BOOL evict_chunk(ChunkManager* manager, BOOL allowProtected) {
+    if (!manager || manager->loadedChunks == 0) return FALSE;
+    
+    ChunkEvictionScoreFn score = manager->evictionPolicy.score ?
+                                 manager->evictionPolicy.score : chunk_eviction_score_default;
+    int best = -1;
+    int bestProtected = -1;
+    float bestScore = 0.0f;
+    float bestProtectedScore = 0.0f;
+    
+    for (int i = 0; i < manager->maxChunks; i++) {
+        VoxelChunk* chunk = manager->chunks[i];
+        if (!chunk) continue;
+        
+        float chunkScore = score(chunk, manager);
+        if (is_chunk_protected(manager, chunk)) {
+            if (bestProtected < 0 || chunkScore > bestProtectedScore) {
+                bestProtected = i;
+                bestProtectedScore = chunkScore;
+            }
+        } else if (best < 0 || chunkScore > bestScore) {
+            best = i;
+            bestScore = chunkScore;
+        }
+    }
+    
+    if (best < 0 && allowProtected) {
+        best = bestProtected;
+    }
+    if (best < 0) return FALSE;
+    
+    VoxelChunk* chunk = manager->chunks[best];
+    printf("Expulsando chunk (%d, %d, %d) - puntuación: %.1f%s\n",
+           chunk->chunkX, chunk->chunkY, chunk->chunkZ,
+           best == bestProtected ? bestProtectedScore : bestScore,
+           chunk->isDirty ? " (sucio, guardando)" : "");
+    unload_chunk_slot(manager, best);
+    manager->evictedChunks++;
+    return TRUE;
+}
+
+void enforce_chunk_memory_budget(ChunkManager* manager) {
+    if (!manager || manager->evictionPolicy.memoryBudget == 0) return;
+    
+    while (get_chunk_manager_memory(manager) > manager->evictionPolicy.memoryBudget) {
+        if (!evict_chunk(manager, FALSE)) break; // Only protected chunks left
+    }
+}
+
+// ============================================================================
+// CHUNK PERSISTENCE - chunks modificados en <saveDirectory>/chunk_X_Y_Z.bin
+// ============================================================================
+
+#define CHUNK_FILE_MAGIC 0x4B484356u         // "VCHK", voxels en orden lineal
+#define CHUNK_FILE_MAGIC_MORTON 0x4D484356u  // "VCHM", voxels en orden Morton
+
+#ifdef CHUNK_LAYOUT_MORTON
+#define CHUNK_FILE_MAGIC_NATIVE CHUNK_FILE_MAGIC_MORTON
+#else
+#define CHUNK_FILE_MAGIC_NATIVE CHUNK_FILE_MAGIC
+#endif
+#define CHUNK_FILE_MAX_DATA (2 + CHUNK_PALETTE_MAX + CHUNK_VOLUME)
+
+static void get_chunk_file_path(char* path, size_t size, const char* directory, int chunkX, int chunkY, int chunkZ) {
+    snprintf(path, size, "%s/chunk_%d_%d_%d.bin", directory, chunkX, chunkY, chunkZ);
+}
+
+// Reorder voxels saved by a build with the other layout (lineal <-> Morton)
+static BOOL convert_storage_layout(ChunkBlockStorage* storage, BOOL fromMorton) {
+    if (chunk_storage_is_uniform(storage)) return TRUE;
+    
+    ChunkBlockStorage converted;
+    if (!chunk_storage_init(&converted, storage->palette[0])) return FALSE;
+    for (int x = 0; x < 16; x++) {
+        for (int y = 0; y < 16; y++) {
+            for (int z = 0; z < 16; z++) {
+                int source = fromMorton ? chunk_morton_index(x, y, z) : chunk_linear_index(x, y, z);
+                if (!chunk_storage_set(&converted, chunk_block_index(x, y, z), chunk_storage_get(storage, source))) {
+                    chunk_storage_free(&converted);
+                    return FALSE;
+                }
+            }
+        }
+    }
+    
+    chunk_storage_free(storage);
+    *storage = converted;
+    return TRUE;
+}
+
+// Layout: [magic][colorSeed][dataSize][chunk_storage_encode data], magic indica el orden de los voxels
+BOOL save_chunk_to_disk(VoxelChunk* chunk, const char* directory) {
+    if (!chunk || !directory || !directory[0]) return FALSE; // Sin directorio: persistencia desactivada
+    
+    uint8 data[CHUNK_FILE_MAX_DATA];
+    uint32 dataSize = (uint32)chunk_storage_encode(&chunk->storage, data, sizeof(data));
+    if (dataSize == 0) return FALSE;
+    
+    CreateDirectoryA(directory, NULL); // Falla sin efecto si ya existe
+    
+    char path[256];
+    get_chunk_file_path(path, sizeof(path), directory, chunk->chunkX, chunk->chunkY, chunk->chunkZ);
+    FILE* file = fopen(path, "wb");
+    if (!file) {
+        printf("ERROR: No se pudo guardar el chunk en: %s\n", path);
+        return FALSE;
+    }
+    
+    uint32 magic = CHUNK_FILE_MAGIC_NATIVE;
+    int32 colorSeed = chunk->colorSeed;
+    fwrite(&magic, sizeof(uint32), 1, file);
+    fwrite(&colorSeed, sizeof(int32), 1, file);
+    fwrite(&dataSize, sizeof(uint32), 1, file);
+    fwrite(data, 1, dataSize, file);
+    fclose(file);
+    
+    chunk->isDirty = FALSE;
+    return TRUE;
+}
+
+BOOL load_chunk_from_disk(VoxelChunk* chunk, const char* directory) {
+    if (!chunk || !directory || !directory[0]) return FALSE; // Sin directorio: persistencia desactivada
+    
+    char path[256];
+    get_chunk_file_path(path, sizeof(path), directory, chunk->chunkX, chunk->chunkY, chunk->chunkZ);
+    FILE* file = fopen(path, "rb");
+    if (!file) return FALSE; // Never modified: generate normally
+    
+    uint32 magic = 0, dataSize = 0;
+    int32 colorSeed = 0;
+    uint8 data[CHUNK_FILE_MAX_DATA];
+    BOOL ok = fread(&magic, sizeof(uint32), 1, file) == 1 &&
+              (magic == CHUNK_FILE_MAGIC || magic == CHUNK_FILE_MAGIC_MORTON) &&
+              fread(&colorSeed, sizeof(int32), 1, file) == 1 &&
+              fread(&dataSize, sizeof(uint32), 1, file) == 1 && dataSize <= sizeof(data) &&
+              fread(data, 1, dataSize, file) == dataSize &&
+              chunk_storage_decode(&chunk->storage, data, dataSize) &&
+              (magic == CHUNK_FILE_MAGIC_NATIVE ||
+               convert_storage_layout(&chunk->storage, magic == CHUNK_FILE_MAGIC_MORTON));
+    fclose(file);
+    
+    if (!ok) {
+        printf("ERROR: Archivo de chunk inválido: %s\n", path);
+        return FALSE;
+    }
+    
+    chunk->colorSeed = colorSeed;
+    chunk->isDirty = FALSE;
+    rebuild_chunk_occupancy(chunk);
+    return TRUE;
+}
+
+// Remove every saved chunk (new world)
+void delete_saved_chunks(const char* directory) {
+    if (!directory) return;
+    
+    char pattern[256];
+    snprintf(pattern, sizeof(pattern), "%s/chunk_*.bin", directory);
+    
+    WIN32_FIND_DATAA findData;
+    HANDLE find = FindFirstFileA(pattern, &findData);
+    if (find == INVALID_HANDLE_VALUE) return;
+    
+    int deleted = 0;
+    do {
+        char path[512];
+        snprintf(path, sizeof(path), "%s/%s", directory, findData.cFileName);
+        if (DeleteFileA(path)) deleted++;
+    } while (FindNextFileA(find, &findData));
+    FindClose(find);
+    
+    printf("Chunks guardados eliminados: %d\n", deleted);
 }
 
 // World persistence system
@@ -1289,15 +2307,6 @@ BOOL can_tree_fit_in_chunk(Tree* tree, VoxelChunk* chunk) {
 void place_tree_in_chunk(VoxelChunk* chunk, Tree* tree) {
     if (!chunk || !tree) return;
     
-    // Get block blueprints
-    BlockBlueprint* blueprints = create_block_blueprints();
-    if (!blueprints) return;
-    
-    BlockBlueprint* woodBlueprint = get_block_blueprint(blueprints, VOXEL_WOOD);
-    BlockBlueprint* leavesBlueprint = get_block_blueprint(blueprints, VOXEL_LEAVES);
-    
-    if (!woodBlueprint || !leavesBlueprint) return;
-    
     // Calcular posición del árbol en el mundo
     int worldTreeX = chunk->chunkX * 16 + tree->x;
     int worldTreeY = chunk->chunkY * 16 + tree->y;
@@ -1320,9 +2329,9 @@ void place_tree_in_chunk(VoxelChunk* chunk, Tree* tree) {
                     
                     // Check bounds del chunk
                     if (blockX >= 0 && blockX < 16 && blockY >= 0 && blockY < 16) {
-                        VoxelBlock* block = &chunk->blocks[blockX][blockY][trunkZ];
-                        if (block->type == VOXEL_AIR || block->type == VOXEL_GRASS) {
-                            initialize_block_from_blueprint(block, woodBlueprint);
+                        VoxelType current = get_block_type(chunk, blockX, blockY, trunkZ);
+                        if (current == VOXEL_AIR || current == VOXEL_GRASS) {
+                            set_block_type(chunk, blockX, blockY, trunkZ, tree->trunkType);
                         }
                     }
                 }
@@ -1369,9 +2378,8 @@ void place_tree_in_chunk(VoxelChunk* chunk, Tree* tree) {
                             
                             // 90% de chance de colocar hoja (más compacto)
                             if (randomChance < 90) {
-                                VoxelBlock* block = &chunk->blocks[blockX][blockY][currentZ];
-                                if (block->type == VOXEL_AIR) {
-                                    initialize_block_from_blueprint(block, leavesBlueprint);
+                                if (get_block_type(chunk, blockX, blockY, currentZ) == VOXEL_AIR) {
+                                    set_block_type(chunk, blockX, blockY, currentZ, tree->leafType);
                                 }
                             }
                         }